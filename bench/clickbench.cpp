@@ -7,12 +7,17 @@
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <fmt/format.h>
 #include <iostream>
+#include <mutex>
+#include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
 
 static void Usage(const char *prog) {
@@ -23,7 +28,14 @@ static void Usage(const char *prog) {
 	          << "  -d <path>    Database path (default: clickbench.db)\n"
 	          << "  -q <path>    Path to queries.sql (default: queries.sql)\n"
 	          << "  -r <int>     Number of times to repeat each query (default: 1)\n"
-	          << "  --purge <true|false>  Clear OS page cache between queries (Linux/macOS; may need sudo) (default: true)\n";
+	          << "  --purge <true|false>  Evict the table from the buffer pool and OS page cache before each query (default: true)\n"
+	          << "  --targeted            Prewarm only what each query reads with prewarm_query() instead of the whole table\n"
+	          << "  --format <fmt>        text | csv | json; csv and json write one record per run (default: text)\n"
+	          << "  -o <path>             Output file (default: stdout)\n"
+	          << "  --interference        Run the selected queries continuously on several connections and prewarm partway\n"
+	          << "                        through; report latency before, during and after the prewarm\n"
+	          << "  --clients <int>       Client connections for --interference (default: 4)\n"
+	          << "  --phase <seconds>     Length of the before and after phases for --interference (default: 10)\n";
 }
 
 enum class Mode { Baseline, Buffer, Read, Prefetch };
@@ -98,12 +110,178 @@ static std::vector<size_t> parse_query_indices(const std::string &spec, size_t m
 	return out;
 }
 
-static void DoPurge() {
-#ifdef __linux__
-	(void)std::system("sync 2>/dev/null; echo 3 | sudo tee /proc/sys/vm/drop_caches >/dev/null 2>&1");
-#elif defined(__APPLE__)
-	(void)std::system("purge 2>/dev/null");
-#endif
+// Cool down the benchmarked table instead of dropping the whole machine's page cache: unload its blocks from the
+// buffer pool and advise the OS to drop its extents of the database file. Needs no root and leaves other files alone.
+static std::string DoEvict(duckdb::Connection &con) {
+	auto result = con.Query("SELECT prewarm_evict('hits', 'all')");
+	if (result->HasError()) {
+		return duckdb_fmt::format("Evict failed: {}", result->GetError());
+	}
+	return "";
+}
+
+enum class OutputFormat { Text, Csv, Json };
+
+static OutputFormat ParseFormat(const std::string &s) {
+	if (s == "text") {
+		return OutputFormat::Text;
+	}
+	if (s == "csv") {
+		return OutputFormat::Csv;
+	}
+	if (s == "json") {
+		return OutputFormat::Json;
+	}
+	throw std::invalid_argument("format must be text, csv, or json");
+}
+
+// Timings of a single prewarm + query run
+struct RunRecord {
+	size_t queryNum = 0;
+	int repetition = 0;
+	double prewarmMs = 0;
+	int64_t prewarmBytes = 0;
+	double queryMs = 0;
+};
+
+static std::string EscapeSqlString(const std::string &s) {
+	std::string escaped;
+	for (char c : s) {
+		escaped += c;
+		if (c == '\'') {
+			escaped += '\'';
+		}
+	}
+	return escaped;
+}
+
+// Raw per-run output: one CSV row or one JSON object per line; text output only prints the per-query summary
+static void WriteRecord(std::ostream &out, OutputFormat format, const RunRecord &record, Mode mode, bool targeted) {
+	if (format == OutputFormat::Csv) {
+		out << duckdb_fmt::format("{},{},{},{},{:.3f},{},{:.3f}\n", record.queryNum, ModeStr(mode), targeted,
+		                          record.repetition, record.prewarmMs, record.prewarmBytes, record.queryMs);
+	} else if (format == OutputFormat::Json) {
+		out << duckdb_fmt::format("{{\"query\":{},\"mode\":\"{}\",\"targeted\":{},\"repetition\":{},"
+		                          "\"prewarm_ms\":{:.3f},\"prewarm_bytes\":{},\"query_ms\":{:.3f}}}\n",
+		                          record.queryNum, ModeStr(mode), targeted, record.repetition, record.prewarmMs,
+		                          record.prewarmBytes, record.queryMs);
+	}
+	out.flush();
+}
+
+// One query execution observed by an interference client
+struct QuerySample {
+	double start_seconds;
+	double latency_ms;
+};
+
+static double Percentile(std::vector<double> values, double percentile) {
+	if (values.empty()) {
+		return 0;
+	}
+	std::sort(values.begin(), values.end());
+	auto rank = static_cast<size_t>(percentile * static_cast<double>(values.size() - 1) + 0.5);
+	return values[std::min(rank, values.size() - 1)];
+}
+
+// Clients issue the selected queries round-robin on their own connections for the whole run. After `phaseSeconds`
+// the main connection prewarms (unless mode is baseline), and the clients keep going for `phaseSeconds` after the
+// prewarm finished. Queries are attributed to the phase they started in.
+static int RunInterference(const std::string &dbPath, const std::vector<std::string> &queries, Mode mode,
+                           int clients, double phaseSeconds, bool purge) {
+	duckdb::DuckDB db(dbPath);
+	duckdb::Connection con(db);
+	duckdb::ExtensionLoader loader(duckdb::DatabaseInstance::GetDatabase(*con.context), "cache_prewarm");
+	duckdb::CachePrewarmExtension cache_prewarm;
+	cache_prewarm.Load(loader);
+	if (purge) {
+		auto error = DoEvict(con);
+		if (!error.empty()) {
+			std::cerr << error << "\n";
+			return 1;
+		}
+	}
+
+	std::atomic<bool> stop {false};
+	std::mutex samplesLock;
+	std::vector<QuerySample> samples;
+	std::string clientError;
+	auto runStart = std::chrono::steady_clock::now();
+	auto secondsSinceStart = [&](std::chrono::steady_clock::time_point t) {
+		return std::chrono::duration<double>(t - runStart).count();
+	};
+
+	std::vector<std::thread> threads;
+	for (int c = 0; c < clients; c++) {
+		threads.emplace_back([&, c]() {
+			duckdb::Connection clientCon(db);
+			// Stagger the starting query so clients do not run in lockstep
+			for (size_t q = static_cast<size_t>(c); !stop; q++) {
+				auto start = std::chrono::steady_clock::now();
+				auto result = clientCon.Query(queries[q % queries.size()]);
+				auto end = std::chrono::steady_clock::now();
+				std::lock_guard<std::mutex> guard(samplesLock);
+				if (result->HasError()) {
+					clientError = result->GetError();
+					stop = true;
+					return;
+				}
+				double latencyMs = std::chrono::duration<double, std::milli>(end - start).count();
+				samples.push_back({secondsSinceStart(start), latencyMs});
+			}
+		});
+	}
+
+	std::this_thread::sleep_for(std::chrono::duration<double>(phaseSeconds));
+	double prewarmStart = secondsSinceStart(std::chrono::steady_clock::now());
+	std::string prewarmError;
+	if (mode != Mode::Baseline && !stop) {
+		auto result = con.Query(duckdb_fmt::format("SELECT prewarm('hits', '{}')", ModeStr(mode)));
+		if (result->HasError()) {
+			prewarmError = result->GetError();
+		}
+	}
+	double prewarmEnd = secondsSinceStart(std::chrono::steady_clock::now());
+	if (prewarmError.empty() && !stop) {
+		std::this_thread::sleep_for(std::chrono::duration<double>(phaseSeconds));
+	}
+	stop = true;
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	double runEnd = secondsSinceStart(std::chrono::steady_clock::now());
+	if (!clientError.empty()) {
+		std::cerr << "Query error: " << clientError << "\n";
+		return 1;
+	}
+	if (!prewarmError.empty()) {
+		std::cerr << "Prewarm failed: " << prewarmError << "\n";
+		return 1;
+	}
+
+	struct Phase {
+		const char *name;
+		double begin;
+		double end;
+	};
+	const Phase phases[] = {
+	    {"before", 0, prewarmStart}, {"during", prewarmStart, prewarmEnd}, {"after", prewarmEnd, runEnd}};
+	std::cout << "Interference with mode: " << ModeStr(mode) << ", clients: " << clients
+	          << ", prewarm time: " << (prewarmEnd - prewarmStart) * 1000 << " ms\n";
+	for (const auto &phase : phases) {
+		std::vector<double> latencies;
+		for (const auto &sample : samples) {
+			if (sample.start_seconds >= phase.begin && sample.start_seconds < phase.end) {
+				latencies.push_back(sample.latency_ms);
+			}
+		}
+		double duration = phase.end - phase.begin;
+		double throughput = duration > 0 ? static_cast<double>(latencies.size()) / duration : 0;
+		std::cout << phase.name << ": " << latencies.size() << " queries - " << throughput << " queries/s - p50: "
+		          << Percentile(latencies, 0.50) << " ms - p95: " << Percentile(latencies, 0.95)
+		          << " ms - p99: " << Percentile(latencies, 0.99) << " ms\n";
+	}
+	return 0;
 }
 
 int main(int argc, char **argv) {
@@ -113,6 +291,12 @@ int main(int argc, char **argv) {
 	Mode mode = Mode::Baseline;
 	std::string queryIndicesSpec = "all";
     int repeat = 1;
+	bool interference = false;
+	int clients = 4;
+	double phaseSeconds = 10;
+	bool targeted = false;
+	OutputFormat format = OutputFormat::Text;
+	std::string outputPath;
 
 	int i = 1;
 	while (i < argc) {
@@ -156,6 +340,42 @@ int main(int argc, char **argv) {
 			i++;
 			continue;
 		}
+		if (a == "--targeted") {
+			targeted = true;
+			i++;
+			continue;
+		}
+		if (a == "--format" && i + 1 < argc) {
+			try {
+				format = ParseFormat(argv[++i]);
+			} catch (const std::exception &e) {
+				std::cerr << "Error: " << e.what() << "\n";
+				Usage(argv[0]);
+				return 1;
+			}
+			i++;
+			continue;
+		}
+		if (a == "-o" && i + 1 < argc) {
+			outputPath = argv[++i];
+			i++;
+			continue;
+		}
+		if (a == "--interference") {
+			interference = true;
+			i++;
+			continue;
+		}
+		if (a == "--clients" && i + 1 < argc) {
+			clients = std::max(1, std::atoi(argv[++i]));
+			i++;
+			continue;
+		}
+		if (a == "--phase" && i + 1 < argc) {
+			phaseSeconds = std::max(0.0, std::atof(argv[++i]));
+			i++;
+			continue;
+		}
 		if (a == "-h" || a == "--help") {
 			Usage(argv[0]);
 			return 0;
@@ -197,7 +417,35 @@ int main(int argc, char **argv) {
 		return 1;
 	}
 
-	std::cout << "Running " << indices.size() << " queries with mode: " << ModeStr(mode) << "\n\n";
+	if (interference) {
+		std::vector<std::string> selected;
+		for (auto idx : indices) {
+			selected.push_back(allQueries[idx]);
+		}
+		try {
+			return RunInterference(dbPath, selected, mode, clients, phaseSeconds, purgeBetween);
+		} catch (const std::exception &e) {
+			std::cerr << "Error: " << e.what() << "\n";
+			return 1;
+		}
+	}
+
+	std::ofstream outputFile;
+	if (!outputPath.empty()) {
+		outputFile.open(outputPath);
+		if (!outputFile) {
+			std::cerr << "Error: cannot open output file: " << outputPath << "\n";
+			return 1;
+		}
+	}
+	std::ostream &out = outputPath.empty() ? std::cout : outputFile;
+
+	if (format == OutputFormat::Text) {
+		out << "Running " << indices.size() << " queries with mode: " << ModeStr(mode)
+		    << (targeted ? " (targeted)" : "") << "\n\n";
+	} else if (format == OutputFormat::Csv) {
+		out << "query,mode,targeted,repetition,prewarm_ms,prewarm_bytes,query_ms\n";
+	}
 
 	try {
 		for (size_t k = 0; k < indices.size(); k++) {
@@ -210,10 +458,7 @@ int main(int argc, char **argv) {
                 const std::string &query = allQueries[idx];
                 size_t queryNum = idx + 1;
 
-                if (purgeBetween) {
-                    DoPurge();
-                }
-
+                // Every run reopens the database in-process, so the buffer pool starts empty
                 duckdb::DuckDB db(dbPath);
                 duckdb::Connection con(db);
 
@@ -222,8 +467,22 @@ int main(int argc, char **argv) {
                 duckdb::CachePrewarmExtension cache_prewarm;
                 cache_prewarm.Load(loader);
 
+                if (purgeBetween) {
+                    error = DoEvict(con);
+                    if (!error.empty()) {
+                        break;
+                    }
+                }
+
+                RunRecord record;
+                record.queryNum = queryNum;
+                record.repetition = i;
                 if (mode != Mode::Baseline) {
-                    std::string prewarmSql = duckdb_fmt::format("SELECT prewarm('hits', '{}')", ModeStr(mode));
+                    // Targeted: only the blocks of the columns and row groups this query reads
+                    std::string prewarmSql =
+                        targeted ? duckdb_fmt::format("SELECT prewarm_query('{}', '{}')", EscapeSqlString(query),
+                                                      ModeStr(mode))
+                                 : duckdb_fmt::format("SELECT prewarm('hits', '{}')", ModeStr(mode));
                     auto start = std::chrono::steady_clock::now();
                     auto prewarmResult = con.Query(prewarmSql);
                     auto end = std::chrono::steady_clock::now();
@@ -231,7 +490,9 @@ int main(int argc, char **argv) {
                         error = duckdb_fmt::format("Prewarm failed: {}", prewarmResult->GetError());
                         break;
                     }
-                    prewarmTimes.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                    record.prewarmMs = std::chrono::duration<double, std::milli>(end - start).count();
+                    record.prewarmBytes = prewarmResult->GetValue(0, 0).GetValue<int64_t>();
+                    prewarmTimes.push_back(record.prewarmMs);
                 }
 
                 auto start = std::chrono::steady_clock::now();
@@ -241,22 +502,27 @@ int main(int argc, char **argv) {
                     error = duckdb_fmt::format("Query {} error: {}", queryNum, result->GetError());
                     break;
                 }
-                queryTimes.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                record.queryMs = std::chrono::duration<double, std::milli>(end - start).count();
+                queryTimes.push_back(record.queryMs);
+                WriteRecord(out, format, record, mode, targeted);
             }
             if (!error.empty()) {
                 std::cerr << error << "\n";
                 return 1;
             }
+            if (format != OutputFormat::Text) {
+                continue;
+            }
             if (mode != Mode::Baseline) {
                 double prewarmTimeMin = *std::min_element(prewarmTimes.begin(), prewarmTimes.end());
                 double prewarmTimeMax = *std::max_element(prewarmTimes.begin(), prewarmTimes.end());
                 double prewarmTimeAverage = std::accumulate(prewarmTimes.begin(), prewarmTimes.end(), 0.0) / static_cast<double>(prewarmTimes.size());
-                std::cout << "Prewarm time: " << "min: " << prewarmTimeMin << " ms - max: " << prewarmTimeMax << " ms - average: " << prewarmTimeAverage << " ms\n";
+                out << "Prewarm time: " << "min: " << prewarmTimeMin << " ms - max: " << prewarmTimeMax << " ms - average: " << prewarmTimeAverage << " ms\n";
             }
             double queryTimeMin = *std::min_element(queryTimes.begin(), queryTimes.end());
             double queryTimeMax = *std::max_element(queryTimes.begin(), queryTimes.end());
             double queryTimeAverage = std::accumulate(queryTimes.begin(), queryTimes.end(), 0.0) / static_cast<double>(queryTimes.size());
-            std::cout << "Query time: " << "min: " << queryTimeMin << " ms - max: " << queryTimeMax << " ms - average: " << queryTimeAverage << " ms\n";
+            out << "Query time: " << "min: " << queryTimeMin << " ms - max: " << queryTimeMax << " ms - average: " << queryTimeAverage << " ms\n";
 		}
 	} catch (const std::exception &e) {
 		std::cerr << "Error: " << e.what() << "\n";
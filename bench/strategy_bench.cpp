@@ -0,0 +1,318 @@
+// Prewarm strategy micro-benchmark: sweeps modes, block counts, thread counts and batch sizes on a generated
+// database and reports throughput, per-task latency percentiles, read/write syscalls, OS prefetch hints and peak RSS
+// as CSV or JSON lines.
+// The cache_prewarm extension is linked statically, strategies are driven directly through the C++ API.
+
+#include "cache_prewarm_extension.hpp"
+#include "core/block_collector.hpp"
+#include "core/block_evictor.hpp"
+#include "core/prewarm_strategy_factory.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+constexpr const char *BENCH_TABLE = "bench_data";
+
+void Usage(const char *prog) {
+	std::cerr << "Usage: " << prog << " [options]\n"
+	          << "Options:\n"
+	          << "  -d <path>         Database path, generated if missing (default: strategy_bench.db)\n"
+	          << "  --rows <int>      Rows to generate (default: 50000000)\n"
+	          << "  -m <list>         Modes: buffer,read,prefetch (default: all three)\n"
+	          << "  --blocks <list>   Block counts, 'all' for every block of the table (default: 1000,10000,all)\n"
+	          << "  --threads <list>  Thread counts (default: 1,4,<hardware threads>)\n"
+	          << "  --batch <list>    Bytes per task, 0 for each mode's default (default: 0,1048576,16777216)\n"
+	          << "  -r <int>          Repetitions per configuration (default: 3)\n"
+	          << "  --format <fmt>    csv | json (default: csv)\n"
+	          << "  -o <path>         Output file (default: stdout)\n";
+}
+
+std::vector<std::string> SplitList(const std::string &list) {
+	std::vector<std::string> out;
+	std::stringstream stream(list);
+	std::string item;
+	while (std::getline(stream, item, ',')) {
+		if (!item.empty()) {
+			out.push_back(item);
+		}
+	}
+	return out;
+}
+
+//! Read and write syscalls issued by this process so far, -1 where /proc/self/io is unavailable
+int64_t ReadSyscallCount() {
+	std::ifstream io("/proc/self/io");
+	std::string key;
+	int64_t value;
+	int64_t total = -1;
+	while (io >> key >> value) {
+		if (key == "syscr:" || key == "syscw:") {
+			total = (total < 0 ? 0 : total) + value;
+		}
+	}
+	return total;
+}
+
+//! Reset the peak RSS high-water mark so it covers a single run (Linux 4.0+)
+void ResetPeakRss() {
+	std::ofstream clear_refs("/proc/self/clear_refs");
+	if (clear_refs) {
+		clear_refs << "5";
+	}
+}
+
+//! Peak resident set size in KiB since the last ResetPeakRss(), -1 where unavailable
+int64_t ReadPeakRssKb() {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0) {
+			return std::atoll(line.c_str() + 6);
+		}
+	}
+#ifdef __linux__
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+		return usage.ru_maxrss;
+	}
+#endif
+	return -1;
+}
+
+double Percentile(std::vector<uint64_t> values, double percentile) {
+	if (values.empty()) {
+		return 0;
+	}
+	std::sort(values.begin(), values.end());
+	auto rank = static_cast<size_t>(percentile * static_cast<double>(values.size() - 1) + 0.5);
+	return static_cast<double>(values[std::min(rank, values.size() - 1)]);
+}
+
+struct RunResult {
+	std::string mode;
+	size_t blocks;
+	int threads;
+	uint64_t batch_bytes;
+	int repetition;
+	uint64_t bytes;
+	double seconds;
+	size_t tasks;
+	double task_p50_us;
+	double task_p99_us;
+	int64_t rw_syscalls;
+	size_t prefetch_hints;
+	int64_t peak_rss_kb;
+};
+
+class ResultWriter {
+public:
+	ResultWriter(std::ostream &out_p, bool json_p) : out(out_p), json(json_p) {
+		if (!json) {
+			out << "mode,blocks,threads,batch_bytes,repetition,bytes,seconds,gb_per_sec,tasks,task_p50_us,task_p99_us,"
+			       "rw_syscalls,prefetch_hints,peak_rss_kb\n";
+		}
+	}
+
+	void Write(const RunResult &result) {
+		double gb_per_sec = result.seconds > 0 ? static_cast<double>(result.bytes) / 1e9 / result.seconds : 0;
+		if (json) {
+			out << duckdb_fmt::format(
+			    "{{\"mode\":\"{}\",\"blocks\":{},\"threads\":{},\"batch_bytes\":{},\"repetition\":{},\"bytes\":{},"
+			    "\"seconds\":{:.6f},\"gb_per_sec\":{:.3f},\"tasks\":{},\"task_p50_us\":{:.0f},\"task_p99_us\":{:.0f},"
+			    "\"rw_syscalls\":{},\"prefetch_hints\":{},\"peak_rss_kb\":{}}}\n",
+			    result.mode, result.blocks, result.threads, result.batch_bytes, result.repetition, result.bytes,
+			    result.seconds, gb_per_sec, result.tasks, result.task_p50_us, result.task_p99_us, result.rw_syscalls,
+			    result.prefetch_hints, result.peak_rss_kb);
+		} else {
+			out << duckdb_fmt::format("{},{},{},{},{},{},{:.6f},{:.3f},{},{:.0f},{:.0f},{},{},{}\n", result.mode,
+			                          result.blocks, result.threads, result.batch_bytes, result.repetition,
+			                          result.bytes, result.seconds, gb_per_sec, result.tasks, result.task_p50_us,
+			                          result.task_p99_us, result.rw_syscalls, result.prefetch_hints,
+			                          result.peak_rss_kb);
+		}
+		out.flush();
+	}
+
+private:
+	std::ostream &out;
+	bool json;
+};
+
+void CheckResult(duckdb::unique_ptr<duckdb::MaterializedQueryResult> result) {
+	if (result->HasError()) {
+		throw std::runtime_error(result->GetError());
+	}
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	std::string db_path = "strategy_bench.db";
+	uint64_t rows = 50000000;
+	std::vector<std::string> modes {"buffer", "read", "prefetch"};
+	std::vector<std::string> block_counts {"1000", "10000", "all"};
+	std::vector<std::string> thread_counts;
+	std::vector<std::string> batch_sizes {"0", "1048576", "16777216"};
+	int repeat = 3;
+	bool json = false;
+	std::string output_path;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool has_value = i + 1 < argc;
+		if (arg == "-h" || arg == "--help") {
+			Usage(argv[0]);
+			return 0;
+		} else if (arg == "-d" && has_value) {
+			db_path = argv[++i];
+		} else if (arg == "--rows" && has_value) {
+			rows = std::strtoull(argv[++i], nullptr, 10);
+		} else if (arg == "-m" && has_value) {
+			modes = SplitList(argv[++i]);
+		} else if (arg == "--blocks" && has_value) {
+			block_counts = SplitList(argv[++i]);
+		} else if (arg == "--threads" && has_value) {
+			thread_counts = SplitList(argv[++i]);
+		} else if (arg == "--batch" && has_value) {
+			batch_sizes = SplitList(argv[++i]);
+		} else if (arg == "-r" && has_value) {
+			repeat = std::max(1, std::atoi(argv[++i]));
+		} else if (arg == "--format" && has_value) {
+			std::string format = argv[++i];
+			if (format != "csv" && format != "json") {
+				std::cerr << "Unknown format: " << format << "\n";
+				return 1;
+			}
+			json = format == "json";
+		} else if (arg == "-o" && has_value) {
+			output_path = argv[++i];
+		} else {
+			std::cerr << "Unknown option: " << arg << "\n";
+			Usage(argv[0]);
+			return 1;
+		}
+	}
+
+	std::ofstream output_file;
+	if (!output_path.empty()) {
+		output_file.open(output_path);
+		if (!output_file) {
+			std::cerr << "Error: cannot open output file: " << output_path << "\n";
+			return 1;
+		}
+	}
+	ResultWriter writer(output_path.empty() ? std::cout : output_file, json);
+
+	try {
+		duckdb::DuckDB db(db_path);
+		duckdb::Connection con(db);
+		duckdb::ExtensionLoader loader(duckdb::DatabaseInstance::GetDatabase(*con.context), "cache_prewarm");
+		duckdb::CachePrewarmExtension cache_prewarm;
+		cache_prewarm.Load(loader);
+
+		auto exists = con.Query(duckdb_fmt::format(
+		    "SELECT count(*) FROM duckdb_tables() WHERE database_name = current_database() AND table_name = '{}'",
+		    BENCH_TABLE));
+		if (exists->HasError()) {
+			throw std::runtime_error(exists->GetError());
+		}
+		if (exists->GetValue(0, 0).GetValue<int64_t>() == 0) {
+			std::cerr << "Generating " << rows << " rows into " << db_path << "\n";
+			CheckResult(con.Query(duckdb_fmt::format(
+			    "CREATE TABLE {} AS SELECT i AS id, hash(i) AS h, (i % 1000)::INTEGER AS bucket, random() AS value, "
+			    "'payload_' || (i % 100000)::VARCHAR AS payload FROM range({}) t(i)",
+			    BENCH_TABLE, rows)));
+			CheckResult(con.Query("CHECKPOINT"));
+		}
+		if (thread_counts.empty()) {
+			auto hardware_threads = con.Query("SELECT current_setting('threads')");
+			thread_counts = {"1", "4", hardware_threads->GetValue(0, 0).ToString()};
+		}
+
+		// Resolve the table and its blocks once, strategies only need the database and the block IDs
+		con.BeginTransaction();
+		auto resolved = duckdb::BlockCollector::ResolveTable(*con.context, BENCH_TABLE);
+		auto table_blocks = duckdb::BlockCollector::CollectTableBlocks(*con.context, resolved.table.get());
+		con.Commit();
+		auto database = resolved.database;
+		auto &block_manager = database->GetStorageManager().GetBlockManager();
+		std::cerr << "Table " << BENCH_TABLE << ": " << table_blocks.size() << " blocks of "
+		          << block_manager.GetBlockAllocSize() << " bytes\n";
+
+		for (const auto &mode_name : modes) {
+			auto mode = duckdb::ParsePrewarmMode(duckdb::Value(mode_name));
+			for (const auto &block_count_spec : block_counts) {
+				size_t block_count = block_count_spec == "all" ? table_blocks.size()
+				                                               : std::min<size_t>(std::stoull(block_count_spec),
+				                                                                  table_blocks.size());
+				// The lowest block IDs, the same subset every run
+				auto block_ids = table_blocks.Prefix(block_count);
+				for (const auto &thread_spec : thread_counts) {
+					CheckResult(con.Query("SET threads=" + thread_spec));
+					for (const auto &batch_spec : batch_sizes) {
+						CheckResult(con.Query("SET prewarm_batch_bytes=" + batch_spec));
+						for (int repetition = 0; repetition < repeat; repetition++) {
+							// Start every run cold in both the buffer pool and the OS page cache
+							duckdb::BlockEvictor::EvictFromBufferPool(*database, table_blocks);
+							duckdb::BlockEvictor::EvictFromPageCache(*database, table_blocks);
+							ResetPeakRss();
+							auto syscalls_before = ReadSyscallCount();
+
+							auto strategy = duckdb::CreateLocalPrewarmStrategy(
+							    *con.context, mode, block_manager,
+							    duckdb::BufferManager::GetBufferManager(*con.context));
+							auto start = std::chrono::steady_clock::now();
+							auto bytes = strategy->Execute(*database, block_ids,
+							                               duckdb::NumericLimits<duckdb::idx_t>::Maximum());
+							auto end = std::chrono::steady_clock::now();
+
+							auto syscalls_after = ReadSyscallCount();
+							auto durations = strategy->GetTaskTimings().GetDurationsUs();
+							RunResult result;
+							result.mode = mode_name;
+							result.blocks = block_count;
+							result.threads = std::stoi(thread_spec);
+							result.batch_bytes = std::stoull(batch_spec);
+							result.repetition = repetition;
+							result.bytes = bytes;
+							result.seconds = std::chrono::duration<double>(end - start).count();
+							result.tasks = durations.size();
+							result.task_p50_us = Percentile(durations, 0.50);
+							result.task_p99_us = Percentile(durations, 0.99);
+							result.rw_syscalls =
+							    syscalls_before < 0 || syscalls_after < 0 ? -1 : syscalls_after - syscalls_before;
+							// posix_fadvise is not counted in /proc/self/io; prefetch issues one hint per loaded block
+							result.prefetch_hints = mode == duckdb::PrewarmMode::PREFETCH
+							                            ? strategy->GetExecutionStats().blocks_loaded
+							                            : 0;
+							result.peak_rss_kb = ReadPeakRssKb();
+							writer.Write(result);
+						}
+					}
+				}
+			}
+		}
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
@@ -2,9 +2,20 @@
 
 #include "cache_httpfs_extension.hpp"
 #include "cache_prewarm_extension.hpp"
+#include "functions/prewarm_dry_run_function.hpp"
+#include "functions/prewarm_evict_function.hpp"
+#include "functions/prewarm_file_function.hpp"
 #include "functions/prewarm_function.hpp"
+#include "functions/prewarm_keep_function.hpp"
+#include "functions/prewarm_manifest_function.hpp"
+#include "functions/prewarm_parquet_metadata_function.hpp"
+#include "functions/prewarm_query_function.hpp"
+#include "functions/prewarm_record_function.hpp"
+#include "functions/prewarm_release_function.hpp"
 #include "functions/prewarm_remote_function.hpp"
+#include "functions/prewarm_stats_function.hpp"
 #include "duckdb.hpp"
+#include "duckdb/main/config.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 
 namespace duckdb {
@@ -13,10 +24,53 @@ namespace {
 
 constexpr const char *CACHE_HTTPFS_EXTENSION = "cache_httpfs";
 
+void RegisterPrewarmSettings(ExtensionLoader &loader) {
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(PREWARM_REMOTE_MAX_OPEN_FILES_SETTING,
+	                          "Maximum number of remote files prewarm_remote keeps open at the same time",
+	                          LogicalType {LogicalTypeId::UBIGINT},
+	                          Value::UBIGINT(DEFAULT_PREWARM_REMOTE_MAX_OPEN_FILES));
+	config.AddExtensionOption(PREWARM_BATCH_BYTES_SETTING,
+	                          "Bytes each local prewarm task loads, 0 to use each mode's default batch size",
+	                          LogicalType {LogicalTypeId::UBIGINT}, Value::UBIGINT(0));
+	config.AddExtensionOption(PREWARM_RECORD_INTERVAL_SETTING,
+	                          "Interval in milliseconds at which prewarm_record_start() samples loaded blocks",
+	                          LogicalType {LogicalTypeId::UBIGINT}, Value::UBIGINT(DEFAULT_PREWARM_RECORD_INTERVAL_MS));
+	config.AddExtensionOption(PREWARM_KEEP_MAX_BYTES_PER_SEC_SETTING,
+	                          "Maximum bytes per second prewarm_keep() policies reload in total, 0 for no limit",
+	                          LogicalType {LogicalTypeId::UBIGINT},
+	                          Value::UBIGINT(DEFAULT_PREWARM_KEEP_MAX_BYTES_PER_SEC));
+	config.AddExtensionOption(PREWARM_PIN_MAX_MEMORY_FRACTION_SETTING,
+	                          "Maximum fraction of memory_limit that tables pinned with prewarm(table, 'pin') may use "
+	                          "across all connections",
+	                          LogicalType {LogicalTypeId::DOUBLE},
+	                          Value::DOUBLE(DEFAULT_PREWARM_PIN_MAX_MEMORY_FRACTION));
+	config.AddExtensionOption(PREWARM_STATS_TEXTFILE_SETTING,
+	                          "File prewarm statistics are periodically written to in the Prometheus text format, for "
+	                          "the node_exporter textfile collector ('' to disable)",
+	                          LogicalType {LogicalTypeId::VARCHAR}, Value(""), SetPrewarmStatsTextfile);
+	config.AddExtensionOption(PREWARM_STATS_TEXTFILE_INTERVAL_SETTING,
+	                          "Interval in milliseconds at which the prewarm_stats_textfile is rewritten",
+	                          LogicalType {LogicalTypeId::UBIGINT},
+	                          Value::UBIGINT(DEFAULT_PREWARM_STATS_TEXTFILE_INTERVAL_MS),
+	                          SetPrewarmStatsTextfileInterval);
+}
+
 void LoadInternal(ExtensionLoader &loader) {
 	LoadCacheHttpfsExtensionIfNeeded(loader);
+	RegisterPrewarmSettings(loader);
 	RegisterPrewarmFunction(loader);
 	RegisterPrewarmRemoteFunction(loader);
+	RegisterPrewarmFileFunction(loader);
+	RegisterPrewarmParquetMetadataFunction(loader);
+	RegisterPrewarmQueryFunction(loader);
+	RegisterPrewarmRecordFunctions(loader);
+	RegisterPrewarmManifestFunctions(loader);
+	RegisterPrewarmKeepFunctions(loader);
+	RegisterPrewarmEvictFunction(loader);
+	RegisterPrewarmReleaseFunction(loader);
+	RegisterPrewarmStatsFunctions(loader);
+	RegisterPrewarmDryRunFunctions(loader);
 }
 
 } // namespace
@@ -0,0 +1,173 @@
+#include "core/block_access_recorder.hpp"
+
+#include "scope_guard.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/storage/block_manager.hpp"
+#include "duckdb/storage/buffer/block_handle.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+
+namespace duckdb {
+
+BlockAccessRecorder::~BlockAccessRecorder() {
+	StopPoller();
+}
+
+void BlockAccessRecorder::Start(ClientContext &context, idx_t interval_ms_p) {
+	{
+		lock_guard<mutex> lock(mu);
+		if (recording) {
+			throw InvalidInputException("prewarm_record_start: this connection is already recording, call "
+			                            "prewarm_record_stop() first");
+		}
+		recording = true;
+		stop_requested = false;
+	}
+	// A failure before the poller runs must not leave the connection stuck "already recording"
+	bool started = false;
+	SCOPE_EXIT {
+		if (!started) {
+			databases.clear();
+			lock_guard<mutex> lock(mu);
+			recording = false;
+		}
+	};
+
+	databases.clear();
+	next_database = 0;
+	next_block = 0;
+	trace = BlockAccessTrace();
+	interval_ms = MaxValue<idx_t>(interval_ms_p, 1);
+	for (auto &database : DatabaseManager::Get(context).GetDatabases(context)) {
+		if (database->IsSystem() || database->IsTemporary() || database->GetStorageManager().InMemory()) {
+			continue;
+		}
+		RecordedDatabase recorded;
+		auto &block_manager = database->GetStorageManager().GetBlockManager();
+		recorded.trace_index =
+		    trace.AddDatabase(database->GetName(), static_cast<uint64_t>(block_manager.GetMetaBlock()));
+		recorded.database = std::move(database);
+		databases.emplace_back(std::move(recorded));
+	}
+
+	start_time = std::chrono::steady_clock::now();
+	// The baseline and final samples check every block once
+	SampleAll(/*baseline=*/true);
+	poller = std::thread([this]() { PollLoop(); });
+	started = true;
+}
+
+BlockAccessTrace BlockAccessRecorder::Stop() {
+	{
+		lock_guard<mutex> lock(mu);
+		if (!recording) {
+			throw InvalidInputException("prewarm_record_stop: this connection is not recording, call "
+			                            "prewarm_record_start() first");
+		}
+	}
+	StopPoller();
+	// Catch loads since the last sample
+	SampleAll(/*baseline=*/false);
+	databases.clear();
+	lock_guard<mutex> lock(mu);
+	recording = false;
+	return std::move(trace);
+}
+
+bool BlockAccessRecorder::IsRecording() const {
+	lock_guard<mutex> lock(mu);
+	return recording;
+}
+
+void BlockAccessRecorder::StopPoller() {
+	{
+		lock_guard<mutex> lock(mu);
+		stop_requested = true;
+		stop_cv.notify_all();
+	}
+	if (poller.joinable()) {
+		poller.join();
+	}
+}
+
+void BlockAccessRecorder::PollLoop() {
+	while (true) {
+		{
+			unique_lock<mutex> lock(mu);
+			if (stop_cv.wait_for(lock, std::chrono::milliseconds(interval_ms), [this]() { return stop_requested; })) {
+				return;
+			}
+		}
+		SampleNext();
+	}
+}
+
+uint64_t BlockAccessRecorder::GetElapsedUs() const {
+	return static_cast<uint64_t>(
+	    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count());
+}
+
+void BlockAccessRecorder::SampleAll(bool baseline) {
+	const auto elapsed_us = GetElapsedUs();
+	for (auto &recorded : databases) {
+		auto &block_manager = recorded.database->GetStorageManager().GetBlockManager();
+		const auto total_blocks = static_cast<block_id_t>(block_manager.TotalBlocks());
+		for (block_id_t block_id = 0; block_id < total_blocks; block_id++) {
+			SampleBlock(recorded, block_manager, block_id, baseline, elapsed_us);
+		}
+	}
+}
+
+void BlockAccessRecorder::SampleNext() {
+	if (databases.empty()) {
+		return;
+	}
+	const auto elapsed_us = GetElapsedUs();
+	idx_t remaining = RECORDER_BLOCKS_PER_SAMPLE;
+	// Visiting one database more than there are lets a sweep that started mid-file wrap around to its beginning
+	for (idx_t visited = 0; visited <= databases.size() && remaining > 0; visited++) {
+		auto &recorded = databases[next_database];
+		auto &block_manager = recorded.database->GetStorageManager().GetBlockManager();
+		const auto total_blocks = static_cast<block_id_t>(block_manager.TotalBlocks());
+		if (next_block >= total_blocks) {
+			next_block = 0;
+		}
+		const auto end = static_cast<block_id_t>(
+		    MinValue<idx_t>(static_cast<idx_t>(total_blocks), static_cast<idx_t>(next_block) + remaining));
+		for (block_id_t block_id = next_block; block_id < end; block_id++) {
+			SampleBlock(recorded, block_manager, block_id, /*baseline=*/false, elapsed_us);
+		}
+		remaining -= static_cast<idx_t>(end - next_block);
+		if (end < total_blocks) {
+			next_block = end;
+			break;
+		}
+		next_block = 0;
+		next_database = (next_database + 1) % databases.size();
+	}
+}
+
+void BlockAccessRecorder::SampleBlock(RecordedDatabase &recorded, BlockManager &block_manager, block_id_t block_id,
+                                      bool baseline, uint64_t elapsed_us) {
+	// Only look at blocks someone holds a handle to, registering the others would be wasted work
+	if (!block_manager.BlockIsRegistered(block_id)) {
+		recorded.loaded_blocks.erase(block_id);
+		return;
+	}
+	auto handle = block_manager.RegisterBlock(block_id);
+	if (handle->GetMemory().IsUnloaded()) {
+		recorded.loaded_blocks.erase(block_id);
+		return;
+	}
+	if (!recorded.loaded_blocks.insert(block_id).second || baseline) {
+		return;
+	}
+	if (recorded.recorded_blocks.insert(block_id).second) {
+		trace.AddEvent(recorded.trace_index, block_id, elapsed_us);
+	}
+}
+
+} // namespace duckdb
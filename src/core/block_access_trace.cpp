@@ -0,0 +1,153 @@
+#include "core/block_access_trace.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/limits.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+namespace {
+
+constexpr char TRACE_MAGIC[] = {'D', 'P', 'W', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t TRACE_VERSION = 2;
+constexpr idx_t TRACE_EVENT_SIZE = sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint64_t);
+
+class TraceWriter {
+public:
+	template <class T>
+	void Write(T value) {
+		auto offset = buffer.size();
+		buffer.resize(offset + sizeof(T));
+		Store<T>(value, buffer.data() + offset);
+	}
+
+	void WriteBytes(const void *data, idx_t size) {
+		auto offset = buffer.size();
+		buffer.resize(offset + size);
+		memcpy(buffer.data() + offset, data, size);
+	}
+
+	vector<data_t> buffer;
+};
+
+class TraceReader {
+public:
+	TraceReader(const string &path_p, const vector<data_t> &buffer_p) : path(path_p), buffer(buffer_p), offset(0) {
+	}
+
+	template <class T>
+	T Read() {
+		Require(sizeof(T));
+		auto value = Load<T>(buffer.data() + offset);
+		offset += sizeof(T);
+		return value;
+	}
+
+	string ReadString(idx_t size) {
+		Require(size);
+		string value(const_char_ptr_cast(buffer.data() + offset), size);
+		offset += size;
+		return value;
+	}
+
+	idx_t Remaining() const {
+		return buffer.size() - offset;
+	}
+
+	void Require(idx_t size) const {
+		if (Remaining() < size) {
+			throw InvalidInputException("Prewarm trace '%s' is truncated", path);
+		}
+	}
+
+private:
+	const string &path;
+	const vector<data_t> &buffer;
+	idx_t offset;
+};
+
+} // namespace
+
+uint32_t BlockAccessTrace::AddDatabase(string database_name, uint64_t checkpoint_stamp) {
+	databases.emplace_back(std::move(database_name));
+	checkpoint_stamps.push_back(checkpoint_stamp);
+	return static_cast<uint32_t>(databases.size() - 1);
+}
+
+void BlockAccessTrace::AddEvent(uint32_t database_index, block_id_t block_id, uint64_t first_access_us) {
+	D_ASSERT(database_index < databases.size());
+	D_ASSERT(events.empty() || events.back().first_access_us <= first_access_us);
+	events.push_back(BlockAccessEvent {database_index, block_id, first_access_us});
+}
+
+void BlockAccessTrace::Write(FileSystem &fs, const string &path) const {
+	TraceWriter writer;
+	writer.WriteBytes(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+	writer.Write<uint32_t>(TRACE_VERSION);
+	writer.Write<uint32_t>(static_cast<uint32_t>(databases.size()));
+	for (idx_t idx = 0; idx < databases.size(); idx++) {
+		writer.Write<uint32_t>(static_cast<uint32_t>(databases[idx].size()));
+		writer.WriteBytes(databases[idx].data(), databases[idx].size());
+		writer.Write<uint64_t>(checkpoint_stamps[idx]);
+	}
+	writer.Write<uint64_t>(events.size());
+	for (const auto &event : events) {
+		writer.Write<uint32_t>(event.database_index);
+		writer.Write<int64_t>(event.block_id);
+		writer.Write<uint64_t>(event.first_access_us);
+	}
+
+	auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_WRITE | FileOpenFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	handle->Write(writer.buffer.data(), writer.buffer.size());
+	handle->Sync();
+}
+
+BlockAccessTrace BlockAccessTrace::Read(FileSystem &fs, const string &path) {
+	auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_READ);
+	auto file_size = NumericCast<idx_t>(fs.GetFileSize(*handle));
+	vector<data_t> buffer(file_size);
+	if (file_size > 0) {
+		handle->Read(buffer.data(), file_size, 0);
+	}
+
+	TraceReader reader(path, buffer);
+	reader.Require(sizeof(TRACE_MAGIC));
+	if (memcmp(buffer.data(), TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
+		throw InvalidInputException("File '%s' is not a prewarm trace", path);
+	}
+	reader.ReadString(sizeof(TRACE_MAGIC));
+	auto version = reader.Read<uint32_t>();
+	if (version != TRACE_VERSION) {
+		throw InvalidInputException("Prewarm trace '%s' has unsupported version %u (expected %u)", path, version,
+		                            TRACE_VERSION);
+	}
+
+	BlockAccessTrace trace;
+	auto database_count = reader.Read<uint32_t>();
+	for (uint32_t idx = 0; idx < database_count; idx++) {
+		auto name_size = reader.Read<uint32_t>();
+		auto database_name = reader.ReadString(name_size);
+		trace.AddDatabase(std::move(database_name), reader.Read<uint64_t>());
+	}
+	auto event_count = reader.Read<uint64_t>();
+	if (event_count > reader.Remaining() / TRACE_EVENT_SIZE) {
+		throw InvalidInputException("Prewarm trace '%s' is truncated", path);
+	}
+	trace.events.reserve(event_count);
+	for (uint64_t idx = 0; idx < event_count; idx++) {
+		BlockAccessEvent event;
+		event.database_index = reader.Read<uint32_t>();
+		event.block_id = reader.Read<int64_t>();
+		event.first_access_us = reader.Read<uint64_t>();
+		if (event.database_index >= database_count) {
+			throw InvalidInputException("Prewarm trace '%s' references unknown database %u", path,
+			                            event.database_index);
+		}
+		trace.events.push_back(event);
+	}
+	return trace;
+}
+
+} // namespace duckdb
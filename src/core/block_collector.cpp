@@ -1,33 +1,173 @@
 #include "core/block_collector.hpp"
+#include "core/work_queue.hpp"
+#include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+#include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/storage_info.hpp"
+#include "duckdb/storage/table/row_group.hpp"
+#include "duckdb/storage/table/scan_state.hpp"
+#include "duckdb/storage/table_storage_info.hpp"
+
+#include <chrono>
 
 namespace duckdb {
 
-unordered_set<block_id_t> BlockCollector::CollectTableBlocks(ClientContext &context, DuckTableEntry &table_entry) {
+namespace {
+
+struct TableNameParts {
+	string database;
+	string schema;
+	string table;
+};
+
+TableNameParts SplitTableName(ClientContext &context, const string &table_name) {
+	auto qualified_name = QualifiedName::Parse(table_name);
+	TableNameParts parts;
+	// Use the catalog from the qualified name if specified, otherwise the default database
+	parts.database = qualified_name.catalog == INVALID_CATALOG
+	                     ? DatabaseManager::Get(DatabaseInstance::GetDatabase(context)).GetDefaultDatabase(context)
+	                     : qualified_name.catalog;
+	parts.schema = qualified_name.schema.empty() ? "main" : qualified_name.schema;
+	parts.table = std::move(qualified_name.name);
+	return parts;
+}
+
+//! Row groups collected by one task. Wide tables have a segment per column in every row group, so even a few row
+//! groups are enough work for a task; tables with fewer row groups are collected on the calling thread.
+constexpr idx_t ROW_GROUPS_PER_COLLECT_TASK = 8;
+
+//! Append the persistent blocks of a segment: its main block and the additional blocks of compressed segments
+void AppendSegmentBlocks(const ColumnSegmentInfo &segment_info, vector<block_id_t> &block_ids) {
+	if (!segment_info.persistent) {
+		return;
+	}
+	if (segment_info.block_id != INVALID_BLOCK) {
+		block_ids.push_back(segment_info.block_id);
+	}
+	for (block_id_t additional_block : segment_info.additional_blocks) {
+		if (additional_block != INVALID_BLOCK) {
+			block_ids.push_back(additional_block);
+		}
+	}
+}
+
+} // namespace
+
+ResolvedTable BlockCollector::ResolveTable(ClientContext &context, const string &table_name) {
+	auto parts = SplitTableName(context, table_name);
+	auto &db_manager = DatabaseManager::Get(DatabaseInstance::GetDatabase(context));
+	shared_ptr<AttachedDatabase> db = db_manager.GetDatabase(parts.database);
+	if (!db) {
+		throw InvalidInputException("Database '%s' not found", parts.database);
+	}
+	auto &table_entry = db->GetCatalog().GetEntry<TableCatalogEntry>(context, parts.schema, parts.table);
+	auto &duck_table = table_entry.Cast<DuckTableEntry>();
+	return ResolvedTable {std::move(db), duck_table, parts.database + "." + parts.schema + "." + parts.table};
+}
+
+string BlockCollector::QualifyTableName(ClientContext &context, const string &table_name) {
+	auto parts = SplitTableName(context, table_name);
+	return parts.database + "." + parts.schema + "." + parts.table;
+}
+
+vector<reference<RowGroup>> BlockCollector::GetRowGroups(ClientContext &context, DataTable &storage) {
+	// A parallel scan is the public way to reach the row groups in order. It is initialized row group by row group and
+	// reads nothing; scanning only the row id does not even load the columns of a row group.
+	ParallelTableScanState parallel_state;
+	storage.InitializeParallelScan(context, parallel_state);
+	TableScanState scan_state;
+	scan_state.Initialize({StorageIndex(COLUMN_IDENTIFIER_ROW_ID)}, context);
+
+	vector<reference<RowGroup>> row_groups;
+	optional_ptr<RowGroup> previous_row_group;
+	while (storage.NextParallelScan(context, parallel_state, scan_state)) {
+		// A row group can come in several scan ranges, e.g. with verify_parallelism, and the last one repeats while
+		// the transaction's own appends are scanned
+		optional_ptr<RowGroup> row_group = scan_state.table_state.row_group;
+		if (!row_group || row_group.get() == previous_row_group.get()) {
+			continue;
+		}
+		previous_row_group = row_group;
+		row_groups.emplace_back(*row_group);
+	}
+	return row_groups;
+}
+
+BlockIdSet BlockCollector::CollectRowGroupBlocks(ClientContext &context, const vector<reference<RowGroup>> &row_groups,
+                                                 idx_t start, idx_t end) {
 	// TODO: GetColumnSegmentInfo() will load some blocks for this table into memory as a side effect
 	// This is because string columns and other compression types need to read
 	// block headers to get dictionary/metadata information.
 	// Need to figure out a way to avoid this side effect.
 	QueryContext query_context(context);
-	auto segment_infos = table_entry.GetColumnSegmentInfo(query_context);
-	unordered_set<block_id_t> block_ids;
-	block_ids.reserve(segment_infos.size() * 2);
+	vector<ColumnSegmentInfo> segment_infos;
+	for (idx_t row_group_idx = start; row_group_idx < end; row_group_idx++) {
+		row_groups[row_group_idx].get().GetColumnSegmentInfo(query_context, row_group_idx, segment_infos);
+	}
+	vector<block_id_t> segment_blocks;
+	segment_blocks.reserve(segment_infos.size() * 2);
 	for (const auto &segment_info : segment_infos) {
-		if (segment_info.persistent) {
-			// Add main block
-			if (segment_info.block_id != INVALID_BLOCK) {
-				block_ids.insert(segment_info.block_id);
-			}
-			// Add additional blocks (for compressed segments)
-			for (block_id_t additional_block : segment_info.additional_blocks) {
-				if (additional_block != INVALID_BLOCK) {
-					block_ids.insert(additional_block);
-				}
-			}
+		AppendSegmentBlocks(segment_info, segment_blocks);
+	}
+	return BlockIdSet::FromUnsorted(std::move(segment_blocks));
+}
+
+BlockIdSet BlockCollector::CollectTableBlocks(ClientContext &context, DuckTableEntry &table_entry) {
+	auto row_groups = GetRowGroups(context, table_entry.GetStorage());
+	if (row_groups.size() <= ROW_GROUPS_PER_COLLECT_TASK) {
+		return CollectRowGroupBlocks(context, row_groups, 0, row_groups.size());
+	}
+
+	// Every task collects a range of row groups into a set of its own; the sets are merged afterwards
+	const idx_t range_count = (row_groups.size() + ROW_GROUPS_PER_COLLECT_TASK - 1) / ROW_GROUPS_PER_COLLECT_TASK;
+	vector<BlockIdSet> range_blocks(range_count);
+	WorkQueue queue(range_count);
+	auto thread_count = MaxValue<idx_t>(1, static_cast<idx_t>(TaskScheduler::GetScheduler(context).NumberOfThreads()));
+	queue.Run(context, thread_count, [&](idx_t range_idx) {
+		const idx_t start = range_idx * ROW_GROUPS_PER_COLLECT_TASK;
+		const idx_t end = MinValue(start + ROW_GROUPS_PER_COLLECT_TASK, row_groups.size());
+		range_blocks[range_idx] = CollectRowGroupBlocks(context, row_groups, start, end);
+	});
+
+	// Merge pairwise so every extent takes part in a logarithmic number of unions; row groups may share blocks
+	while (range_blocks.size() > 1) {
+		vector<BlockIdSet> merged;
+		merged.reserve((range_blocks.size() + 1) / 2);
+		for (idx_t idx = 0; idx + 1 < range_blocks.size(); idx += 2) {
+			merged.push_back(range_blocks[idx].Union(range_blocks[idx + 1]));
 		}
+		if (range_blocks.size() % 2 == 1) {
+			merged.push_back(std::move(range_blocks.back()));
+		}
+		range_blocks = std::move(merged);
+	}
+	return std::move(range_blocks[0]);
+}
+
+TableBlockStream::TableBlockStream(ClientContext &context_p, DuckTableEntry &table_entry)
+    : context(context_p), row_groups(BlockCollector::GetRowGroups(context_p, table_entry.GetStorage())) {
+}
+
+bool TableBlockStream::Next(BlockIdSet &batch) {
+	auto collection_start = std::chrono::steady_clock::now();
+	batch = BlockIdSet();
+	while (next_row_group < row_groups.size() && batch.size() < min_batch_blocks) {
+		auto row_group_blocks =
+		    BlockCollector::CollectRowGroupBlocks(context, row_groups, next_row_group, next_row_group + 1);
+		next_row_group++;
+		batch = batch.Union(row_group_blocks.Difference(collected));
 	}
-	return block_ids;
+	collected = collected.Union(batch);
+	collection_us += static_cast<uint64_t>(
+	    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - collection_start)
+	        .count());
+	return !batch.empty();
 }
 
 } // namespace duckdb
@@ -0,0 +1,72 @@
+#include "core/block_evictor.hpp"
+
+#include "core/os_prefetch.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/storage/block_manager.hpp"
+#include "duckdb/storage/buffer/block_handle.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+
+namespace duckdb {
+
+EvictMode ParseEvictMode(const Value &mode_val) {
+	if (mode_val.IsNull()) {
+		return EvictMode::ALL;
+	}
+	auto lower_mode = StringUtil::Lower(mode_val.ToString());
+	if (lower_mode == "buffer") {
+		return EvictMode::BUFFER;
+	}
+	if (lower_mode == "os") {
+		return EvictMode::OS;
+	}
+	if (lower_mode == "all") {
+		return EvictMode::ALL;
+	}
+	throw InvalidInputException("Invalid evict mode '%s'. Valid modes are: 'buffer', 'os', 'all'",
+	                            mode_val.ToString());
+}
+
+idx_t BlockEvictor::Evict(AttachedDatabase &database, const BlockIdSet &block_ids, EvictMode mode) {
+	vector<block_id_t> blocks_evicted;
+	if (mode == EvictMode::BUFFER || mode == EvictMode::ALL) {
+		blocks_evicted = EvictFromBufferPool(database, block_ids);
+	}
+	if (mode == EvictMode::OS || mode == EvictMode::ALL) {
+		auto page_cache_blocks = EvictFromPageCache(database, block_ids);
+		blocks_evicted.insert(blocks_evicted.end(), page_cache_blocks.begin(), page_cache_blocks.end());
+	}
+	// A block loaded into the buffer pool usually sits in the page cache as well
+	auto distinct_blocks = BlockIdSet::FromUnsorted(std::move(blocks_evicted));
+	return distinct_blocks.size() * database.GetStorageManager().GetBlockManager().GetBlockAllocSize();
+}
+
+vector<block_id_t> BlockEvictor::EvictFromBufferPool(AttachedDatabase &database, const BlockIdSet &block_ids) {
+	auto &block_manager = database.GetStorageManager().GetBlockManager();
+	vector<block_id_t> blocks_evicted;
+	for (block_id_t block_id : block_ids) {
+		// A block nobody holds a handle to is not in the buffer pool
+		if (!block_manager.BlockIsRegistered(block_id)) {
+			continue;
+		}
+		auto handle = block_manager.RegisterBlock(block_id);
+		auto &memory = handle->GetMemory();
+		auto lock = memory.GetLock();
+		if (memory.IsUnloaded() || !memory.CanUnload()) {
+			continue;
+		}
+		memory.Unload(lock);
+		blocks_evicted.push_back(block_id);
+	}
+	return blocks_evicted;
+}
+
+vector<block_id_t> BlockEvictor::EvictFromPageCache(AttachedDatabase &database, const BlockIdSet &block_ids) {
+	auto &storage_manager = database.GetStorageManager();
+	auto block_size = storage_manager.GetBlockManager().GetBlockAllocSize();
+	auto sorted_blocks = block_ids.ToVector();
+	return OSEvictBlocks(storage_manager.GetDBPath(), sorted_blocks, block_size);
+}
+
+} // namespace duckdb
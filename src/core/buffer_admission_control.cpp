@@ -0,0 +1,91 @@
+#include "core/buffer_admission_control.hpp"
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/storage/buffer/block_handle.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+
+namespace {
+
+//! Watched blocks checked per admitted batch, which bounds the cost per batch. Checked blocks that are still loaded go
+//! to the back of the queue, so consecutive batches sweep all of them.
+constexpr idx_t EVICTION_CHECKS_PER_BATCH = 4;
+
+//! Share of the watched batches that may be evicted before admission stops. Concurrent queries evict a block of the
+//! prewarm now and then; once more of them go, the prewarm only evicts what it loaded itself.
+constexpr double EVICTION_STOP_RATIO = 0.1;
+
+} // namespace
+
+BufferAdmissionControl::BufferAdmissionControl(BufferManager &buffer_manager_p, const BufferCapacityInfo &capacity_info)
+    : buffer_manager(buffer_manager_p), block_size(capacity_info.block_size),
+      usage_limit(capacity_info.used_space + capacity_info.max_blocks * capacity_info.block_size) {
+}
+
+bool BufferAdmissionControl::Admit(idx_t blocks) {
+	if (stop_reason.load() != AdmissionStopReason::NONE) {
+		return false;
+	}
+	if (buffer_manager.GetUsedMemory() + blocks * block_size > usage_limit) {
+		Stop(AdmissionStopReason::MEMORY_PRESSURE);
+		return false;
+	}
+	if (EvictionStarted()) {
+		Stop(AdmissionStopReason::EVICTION);
+		return false;
+	}
+	return true;
+}
+
+void BufferAdmissionControl::Track(const vector<shared_ptr<BlockHandle>> &batch) {
+	for (const auto &handle : batch) {
+		// Blocks the prefetch did not load cannot be evicted later
+		if (!handle->GetMemory().IsUnloaded()) {
+			lock_guard<mutex> guard(watched_lock);
+			watched.push_back(weak_ptr<BlockHandle>(handle));
+			watched_batches++;
+			return;
+		}
+	}
+}
+
+bool BufferAdmissionControl::EvictionStarted() {
+	lock_guard<mutex> guard(watched_lock);
+	const idx_t checks = MinValue<idx_t>(watched.size(), EVICTION_CHECKS_PER_BATCH);
+	for (idx_t idx = 0; idx < checks; idx++) {
+		auto handle = watched.front().lock();
+		watched.pop_front();
+		if (!handle) {
+			// Nobody refers to the block anymore, e.g. its table was rewritten: it says nothing about eviction
+			watched_batches--;
+			continue;
+		}
+		if (handle->GetMemory().IsUnloaded()) {
+			evicted_batches++;
+			continue;
+		}
+		watched.push_back(weak_ptr<BlockHandle>(handle));
+	}
+	return evicted_batches > 0 &&
+	       static_cast<double>(evicted_batches) > EVICTION_STOP_RATIO * static_cast<double>(watched_batches);
+}
+
+void BufferAdmissionControl::Stop(AdmissionStopReason reason) {
+	// Keep the first reason, later refusals follow from it
+	auto expected = AdmissionStopReason::NONE;
+	stop_reason.compare_exchange_strong(expected, reason);
+}
+
+string BufferAdmissionControl::StopReasonToString(AdmissionStopReason reason) {
+	switch (reason) {
+	case AdmissionStopReason::MEMORY_PRESSURE:
+		return "concurrent allocations used up the buffer pool headroom, loading more would evict";
+	case AdmissionStopReason::EVICTION:
+		return "the buffer manager started evicting blocks loaded by this prewarm";
+	default:
+		return "none";
+	}
+}
+
+} // namespace duckdb
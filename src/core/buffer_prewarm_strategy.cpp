@@ -1,11 +1,20 @@
 #include "core/buffer_prewarm_strategy.hpp"
 
+#include "core/block_collector.hpp"
+#include "core/buffer_admission_control.hpp"
+#include "core/extent_scheduler.hpp"
+#include "utils/include/bounded_queue.hpp"
+
+#include "duckdb/common/atomic.hpp"
+
 #include "duckdb/logging/logger.hpp"
 #include "duckdb/parallel/task_executor.hpp"
 #include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/storage/buffer/block_handle.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 
+#include <algorithm>
+
 namespace duckdb {
 
 namespace {
@@ -13,83 +22,237 @@ namespace {
 // Use ~4MiB batches (16 * default 256KiB blocks) to balance throughput and buffer pool pressure.
 constexpr idx_t BUFFER_PREFETCH_TARGET_BYTES = 4ULL * 1024ULL * 1024ULL;
 
-class BufferPrefetchTask : public BaseExecutorTask {
+//! Collected batches queued per I/O task when streaming. Collection runs at most this far ahead of I/O, which bounds
+//! the block sets waiting in memory.
+constexpr idx_t STREAM_BATCHES_PER_TASK = 2;
+
+//! Load the batches a collecting thread queues until the queue is closed and drained
+class StreamLoadTask : public BaseExecutorTask {
 public:
-	BufferPrefetchTask(TaskExecutor &executor, BufferManager &buffer_manager_p,
-	                   vector<shared_ptr<BlockHandle>> &handles_p, idx_t start_p, idx_t count_p)
-	    : BaseExecutorTask(executor), buffer_manager(buffer_manager_p), handles(handles_p), start(start_p),
-	      count(count_p) {
+	StreamLoadTask(TaskExecutor &executor, BoundedQueue<BlockIdSet> &batches_p,
+	               const std::function<void(const BlockIdSet &)> &load_batch_p)
+	    : BaseExecutorTask(executor), batches(batches_p), load_batch(load_batch_p) {
 	}
 
 	void ExecuteTask() override {
-		vector<shared_ptr<BlockHandle>> batch;
-		batch.reserve(count);
-		for (idx_t idx = 0; idx < count; idx++) {
-			batch.push_back(handles[start + idx]);
+		BlockIdSet batch;
+		while (batches.Pop(batch)) {
+			load_batch(batch);
 		}
-		buffer_manager.Prefetch(batch);
 	}
 
 	string TaskType() const override {
-		return "BufferPrefetchTask";
+		return "StreamLoadTask";
 	}
 
 private:
-	BufferManager &buffer_manager;
-	vector<shared_ptr<BlockHandle>> &handles;
-	idx_t start;
-	idx_t count;
+	BoundedQueue<BlockIdSet> &batches;
+	const std::function<void(const BlockIdSet &)> &load_batch;
 };
 
 } // namespace
 
-idx_t BufferPrewarmStrategy::Execute(DuckTableEntry &table_entry, const unordered_set<block_id_t> &block_ids,
-                                     idx_t max_blocks) {
-	auto unloaded_handles = GetUnloadedBlockHandles(block_ids);
-	if (unloaded_handles.empty()) {
-		return 0;
+//! State of one load shared by its I/O tasks
+struct BufferPrewarmStrategy::BufferLoad {
+	BufferLoad(BufferManager &buffer_manager, const BufferCapacityInfo &capacity_info_p, idx_t effective_max_p,
+	           idx_t file_size_p)
+	    : capacity_info(capacity_info_p), effective_max(effective_max_p), file_size(file_size_p),
+	      admission(buffer_manager, capacity_info_p), budget(effective_max_p),
+	      io_start(std::chrono::steady_clock::now()) {
 	}
 
-	auto capacity_info = CalculateMaxAvailableBlocks();
-	idx_t effective_max = std::min(capacity_info.max_blocks, max_blocks);
+	const BufferCapacityInfo capacity_info;
+	const idx_t effective_max;
+	const idx_t file_size;
+	//! The budget is a snapshot, admission control re-checks the buffer pool before every batch
+	BufferAdmissionControl admission;
+	atomic<idx_t> budget;
+	atomic<idx_t> blocks_registered {0};
+	atomic<idx_t> blocks_resident {0};
+	atomic<idx_t> blocks_past_eof {0};
+	atomic<idx_t> blocks_throttled {0};
+	atomic<idx_t> blocks_loaded {0};
+	atomic<uint64_t> first_load_us {0};
+	const std::chrono::steady_clock::time_point io_start;
+};
 
-	idx_t total_blocks = block_ids.size();
-	idx_t already_cached = total_blocks - unloaded_handles.size();
-	idx_t blocks_to_prewarm = unloaded_handles.size();
+bool BufferPrewarmStrategy::LoadChunk(block_id_t first_block, idx_t count, BufferLoad &load) {
+	auto chunk_start = std::chrono::steady_clock::now();
+	load.blocks_registered += count;
+	auto batch = GetUnloadedBlockHandles(first_block, count);
+	load.blocks_resident += count - batch.size();
+	// Blocks past EOF cannot be loaded and do not use up the budget, as in the plan of the dry run
+	const idx_t unloaded = batch.size();
+	batch.erase(std::remove_if(batch.begin(), batch.end(),
+	                           [&](const shared_ptr<BlockHandle> &handle) {
+		                           return GetBlockFileBytes(handle->BlockId(), load.file_size) == 0;
+	                           }),
+	            batch.end());
+	load.blocks_past_eof += unloaded - batch.size();
+	const idx_t granted = ClaimBlocks(load.budget, batch.size());
+	const bool budget_left = load.budget.load() > 0;
+	batch.resize(granted);
+	if (batch.empty()) {
+		return budget_left;
+	}
+	if (!load.admission.Admit(batch.size())) {
+		// The refusal is final, the chunks left are not registered either
+		load.blocks_throttled += batch.size();
+		return false;
+	}
+	buffer_manager.Prefetch(batch);
+	load.admission.Track(batch);
+	// Prefetch does not report failures, and blocks may be evicted again by concurrent queries: count what is resident
+	const idx_t batch_loaded = CountLoadedBlocks(batch);
+	load.blocks_loaded += batch_loaded;
+	if (batch_loaded > 0) {
+		RecordFirstLoad(load.first_load_us, load.io_start);
+	}
+	task_timings.Record(chunk_start);
+	return budget_left;
+}
 
-	if (unloaded_handles.size() > effective_max) {
-		idx_t blocks_skipped = unloaded_handles.size() - effective_max;
-		unloaded_handles.resize(effective_max);
+idx_t BufferPrewarmStrategy::FinishLoad(BufferLoad &load, idx_t blocks_planned) {
+	execution_stats.io_us += GetElapsedMicros(load.io_start);
+	execution_stats.first_load_us += load.first_load_us;
 
+	// Blocks of cancelled chunks were never registered and count as unloaded. Once admission stopped they are
+	// throttled, otherwise the budget ran out.
+	const auto &capacity_info = load.capacity_info;
+	const idx_t unloaded_count = blocks_planned - load.blocks_resident;
+	idx_t blocks_over_limit = unloaded_count - load.blocks_past_eof - (load.effective_max - load.budget.load());
+	if (load.admission.GetStopReason() != AdmissionStopReason::NONE) {
+		const idx_t blocks_unregistered = blocks_planned - load.blocks_registered;
+		load.blocks_throttled += blocks_unregistered;
+		blocks_over_limit -= blocks_unregistered;
+	}
+	if (blocks_over_limit > 0) {
 		DUCKDB_LOG_WARNING(context,
 		                   "Buffer pool capacity limit reached.\n"
 		                   "  Table blocks: %llu total (%llu already cached, %llu unloaded)\n"
-		                   "  Prewarming: %llu blocks (skipping %llu due to limit)\n"
+		                   "  Prewarmed: %llu blocks (skipped %llu due to limit)\n"
 		                   "  Memory: %llu bytes available, %llu bytes required for all unloaded blocks",
-		                   total_blocks, already_cached, blocks_to_prewarm, effective_max, blocks_skipped,
-		                   capacity_info.available_space, blocks_to_prewarm * capacity_info.block_size);
+		                   blocks_planned, load.blocks_resident.load(), unloaded_count, load.effective_max,
+		                   blocks_over_limit, capacity_info.available_space,
+		                   unloaded_count * capacity_info.block_size);
+	}
+	if (load.blocks_throttled > 0) {
+		DUCKDB_LOG_WARNING(context,
+		                   "Buffer prewarm stopped before its budget ran out: %s.\n"
+		                   "  Skipped: %llu blocks (%llu bytes), buffer pool usage %llu of %llu bytes allowed",
+		                   BufferAdmissionControl::StopReasonToString(load.admission.GetStopReason()),
+		                   load.blocks_throttled.load(), load.blocks_throttled * capacity_info.block_size,
+		                   buffer_manager.GetUsedMemory(), load.admission.GetUsageLimit());
+	}
+
+	// A block only loads if all of it lies within the file, it counts in full
+	const idx_t bytes_loaded = load.blocks_loaded * capacity_info.block_size;
+	execution_stats.blocks_planned += blocks_planned;
+	execution_stats.blocks_resident += load.blocks_resident;
+	execution_stats.blocks_skipped += unloaded_count - load.blocks_loaded;
+	execution_stats.blocks_throttled += load.blocks_throttled;
+	execution_stats.blocks_loaded += load.blocks_loaded;
+	execution_stats.bytes_loaded += bytes_loaded;
+	return bytes_loaded;
+}
+
+idx_t BufferPrewarmStrategy::Execute(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) {
+	if (block_ids.empty()) {
+		return 0;
+	}
+
+	auto capacity_info = CalculateMaxAvailableBlocks();
+	idx_t effective_max = std::min(capacity_info.max_blocks, max_blocks);
+	if (effective_max == 0) {
+		// Nothing can be loaded, the blocks are not even registered to tell resident ones apart
+		DUCKDB_LOG_WARNING(context,
+		                   "Insufficient memory to prewarm any blocks (available: %llu bytes, block size: %llu bytes)",
+		                   capacity_info.available_space, capacity_info.block_size);
+		execution_stats.blocks_planned += block_ids.size();
+		execution_stats.blocks_skipped += block_ids.size();
+		return 0;
 	}
 
+	// Every task registers the chunk it claimed, filters out resident blocks and loads the rest right away, so the
+	// first blocks load before the last ones are registered and at most one chunk of handles per task is in flight.
+	// Chunks are sized from the plan, resident blocks do not use up the budget; the scheduler is cancelled once the
+	// budget is gone so that the rest of the table is not registered for nothing.
 	auto thread_count = std::max(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
-	auto blocks_per_task =
-	    CalculateBlocksPerTask(capacity_info.block_size, effective_max, thread_count, BUFFER_PREFETCH_TARGET_BYTES);
-	if (blocks_per_task == 0) {
+	auto blocks_per_chunk = CalculateBlocksPerTask(capacity_info.block_size, block_ids.size(), thread_count,
+	                                               GetTargetBatchBytes(BUFFER_PREFETCH_TARGET_BYTES));
+	ExtentScheduler scheduler(block_ids, blocks_per_chunk);
+	BufferLoad load(buffer_manager, capacity_info, effective_max, GetDatabaseFileSize(database));
+	scheduler.Run(context, static_cast<idx_t>(thread_count), [&](const ExtentChunk &chunk) {
+		if (!LoadChunk(chunk.first_block, chunk.count, load)) {
+			scheduler.Cancel();
+		}
+	});
+	return FinishLoad(load, block_ids.size());
+}
+
+idx_t BufferPrewarmStrategy::ExecuteStream(AttachedDatabase &database, TableBlockStream &stream, idx_t max_blocks) {
+	auto capacity_info = CalculateMaxAvailableBlocks();
+	idx_t effective_max = std::min(capacity_info.max_blocks, max_blocks);
+	auto thread_count = std::max(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+	// The table size is not known up front, chunks are sized from the budget instead
+	auto blocks_per_chunk = CalculateBlocksPerTask(capacity_info.block_size, effective_max, thread_count,
+	                                               GetTargetBatchBytes(BUFFER_PREFETCH_TARGET_BYTES));
+	stream.SetMinBatchBlocks(blocks_per_chunk);
+	if (effective_max == 0) {
+		// Nothing can be loaded; the table is still collected so that its blocks count as skipped, like in Execute()
+		DUCKDB_LOG_WARNING(context,
+		                   "Insufficient memory to prewarm any blocks (available: %llu bytes, block size: %llu bytes)",
+		                   capacity_info.available_space, capacity_info.block_size);
+		BlockIdSet batch;
+		while (stream.Next(batch)) {
+			execution_stats.blocks_planned += batch.size();
+			execution_stats.blocks_skipped += batch.size();
+		}
 		return 0;
 	}
 
-	std::sort(
-	    unloaded_handles.begin(), unloaded_handles.end(),
-	    [](const shared_ptr<BlockHandle> &a, const shared_ptr<BlockHandle> &b) { return a->BlockId() < b->BlockId(); });
+	BufferLoad load(buffer_manager, capacity_info, effective_max, GetDatabaseFileSize(database));
+	BoundedQueue<BlockIdSet> batches(static_cast<idx_t>(thread_count) * STREAM_BATCHES_PER_TASK);
+	atomic<bool> stopped {false};
+	const std::function<void(const BlockIdSet &)> load_batch = [&](const BlockIdSet &batch) {
+		// Batches queued before loading stopped are drained without registering them
+		for (const auto &extent : batch.GetExtents()) {
+			for (idx_t start = 0; start < extent.count && !stopped; start += blocks_per_chunk) {
+				const idx_t count = MinValue(blocks_per_chunk, extent.count - start);
+				if (!LoadChunk(extent.start + static_cast<block_id_t>(start), count, load)) {
+					stopped = true;
+					batches.Close();
+				}
+			}
+		}
+	};
 
+	// I/O tasks load what the calling thread collects. While the queue is full the calling thread loads queued
+	// batches itself, so collection never blocks and a single thread works through both.
 	TaskExecutor executor(context);
-	for (idx_t start = 0; start < unloaded_handles.size(); start += blocks_per_task) {
-		auto count = std::min<idx_t>(blocks_per_task, unloaded_handles.size() - start);
-		auto task = make_uniq<BufferPrefetchTask>(executor, buffer_manager, unloaded_handles, start, count);
-		executor.ScheduleTask(std::move(task));
+	for (int worker = 0; worker < thread_count; worker++) {
+		executor.ScheduleTask(make_uniq<StreamLoadTask>(executor, batches, load_batch));
+	}
+	idx_t blocks_planned = 0;
+	try {
+		BlockIdSet batch;
+		while (!stopped && !executor.HasError() && stream.Next(batch)) {
+			blocks_planned += batch.size();
+			BlockIdSet queued;
+			while (batches.Size() >= batches.Capacity() && batches.TryPop(queued)) {
+				load_batch(queued);
+			}
+			// Only this thread pushes, so a queue with room does not fill up in between; a closed queue drops it
+			batches.Push(std::move(batch));
+		}
+	} catch (...) {
+		batches.Close();
+		executor.WorkOnTasks();
+		throw;
 	}
+	batches.Close();
 	executor.WorkOnTasks();
-
-	return unloaded_handles.size() * capacity_info.block_size;
+	return FinishLoad(load, blocks_planned);
 }
 
 } // namespace duckdb
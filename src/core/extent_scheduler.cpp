@@ -0,0 +1,60 @@
+#include "core/extent_scheduler.hpp"
+
+#include "duckdb/common/helper.hpp"
+
+namespace duckdb {
+
+ExtentScheduler::ExtentScheduler(const vector<block_id_t> &block_ids, idx_t chunk_blocks)
+    : chunks(ChunkBlocks(block_ids, chunk_blocks)), queue(chunks.size()) {
+}
+
+ExtentScheduler::ExtentScheduler(const BlockIdSet &block_ids, idx_t chunk_blocks)
+    : chunks(ChunkBlocks(block_ids, chunk_blocks)), queue(chunks.size()) {
+}
+
+vector<ExtentChunk> ExtentScheduler::ChunkBlocks(const vector<block_id_t> &block_ids, idx_t chunk_blocks) {
+	chunk_blocks = MaxValue<idx_t>(chunk_blocks, 1);
+	vector<ExtentChunk> result;
+	idx_t extent_start = 0;
+	while (extent_start < block_ids.size()) {
+		idx_t extent_end = extent_start + 1;
+		while (extent_end < block_ids.size() && block_ids[extent_end] == block_ids[extent_end - 1] + 1) {
+			extent_end++;
+		}
+		for (idx_t offset = extent_start; offset < extent_end; offset += chunk_blocks) {
+			result.push_back(ExtentChunk {offset, block_ids[offset], MinValue(chunk_blocks, extent_end - offset)});
+		}
+		extent_start = extent_end;
+	}
+	return result;
+}
+
+vector<ExtentChunk> ExtentScheduler::ChunkBlocks(const BlockIdSet &block_ids, idx_t chunk_blocks) {
+	chunk_blocks = MaxValue<idx_t>(chunk_blocks, 1);
+	vector<ExtentChunk> result;
+	idx_t extent_offset = 0;
+	for (const auto &extent : block_ids.GetExtents()) {
+		for (idx_t start = 0; start < extent.count; start += chunk_blocks) {
+			result.push_back(ExtentChunk {extent_offset + start, extent.start + static_cast<block_id_t>(start),
+			                              MinValue(chunk_blocks, extent.count - start)});
+		}
+		extent_offset += extent.count;
+	}
+	return result;
+}
+
+bool ExtentScheduler::Next(ExtentChunk &chunk) {
+	idx_t chunk_idx;
+	if (!queue.Next(chunk_idx)) {
+		return false;
+	}
+	chunk = chunks[chunk_idx];
+	return true;
+}
+
+void ExtentScheduler::Run(ClientContext &context, idx_t max_workers,
+                          const std::function<void(const ExtentChunk &)> &process) {
+	queue.Run(context, max_workers, [&](idx_t chunk_idx) { process(chunks[chunk_idx]); });
+}
+
+} // namespace duckdb
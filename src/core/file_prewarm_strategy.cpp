@@ -0,0 +1,157 @@
+#include "core/file_prewarm_strategy.hpp"
+
+#include "core/os_prefetch.hpp"
+#include "core/work_queue.hpp"
+
+#include "duckdb/common/allocator.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/helper.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+namespace {
+
+//! Default bytes per chunk: large enough for sequential throughput on big files, small enough to spread a few large
+//! files over all threads
+constexpr idx_t FILE_PREWARM_TARGET_BYTES = 4ULL * 1024ULL * 1024ULL;
+
+} // namespace
+
+FilePrewarmStrategy::FilePrewarmStrategy(ClientContext &context_p, PrewarmMode mode_p)
+    : PrewarmStrategy(context_p), mode(mode_p) {
+	if (mode != PrewarmMode::PREFETCH && mode != PrewarmMode::READ) {
+		throw InvalidInputException("prewarm_file supports the 'prefetch' and 'read' modes only, the buffer pool "
+		                            "caches database blocks and not the files read by table functions");
+	}
+}
+
+string FilePrewarmStrategy::GetName() const {
+	return mode == PrewarmMode::READ ? "file_read" : "file_prefetch";
+}
+
+BufferCapacityInfo FilePrewarmStrategy::CalculateMaxAvailableBlocks() {
+	BufferCapacityInfo info;
+	info.block_size = GetTargetBatchBytes(FILE_PREWARM_TARGET_BYTES);
+	info.max_capacity = NumericLimits<idx_t>::Maximum();
+	info.used_space = 0;
+	info.available_space = NumericLimits<idx_t>::Maximum();
+	info.max_blocks = NumericLimits<idx_t>::Maximum();
+	return info;
+}
+
+vector<LocalFileInfo> FilePrewarmStrategy::ListFiles(ClientContext &context, const string &pattern) {
+	if (FileSystem::IsRemoteFile(pattern)) {
+		throw InvalidInputException("prewarm_file only warms local files, use prewarm_remote for '%s'", pattern);
+	}
+	// The client file system applies enable_external_access and allowed_directories. Every file is opened through it
+	// here, which is the access check for the prefetch hints that open the files directly.
+	auto &fs = FileSystem::GetFileSystem(context);
+	vector<LocalFileInfo> files;
+	for (const auto &match : fs.Glob(pattern)) {
+		auto handle = fs.OpenFile(match.path, FileFlags::FILE_FLAGS_READ);
+		files.push_back(LocalFileInfo {match.path, static_cast<idx_t>(handle->GetFileSize())});
+	}
+	if (files.empty()) {
+		throw InvalidInputException("No local files match '%s'", pattern);
+	}
+	std::sort(files.begin(), files.end(),
+	          [](const LocalFileInfo &left, const LocalFileInfo &right) { return left.path < right.path; });
+	return files;
+}
+
+idx_t FilePrewarmStrategy::LoadChunk(const LocalFileInfo &file, const LocalFileChunk &chunk) {
+	if (mode == PrewarmMode::PREFETCH) {
+		// ListFiles() opened the file through the client file system, which checked the access settings
+		return OSPrefetchFileRange(file.path, chunk.offset, chunk.length);
+	}
+	try {
+		auto &fs = FileSystem::GetFileSystem(context);
+		auto handle = fs.OpenFile(file.path, FileFlags::FILE_FLAGS_READ);
+		// The file may have been truncated since it was listed
+		auto file_size = static_cast<idx_t>(handle->GetFileSize());
+		if (chunk.offset >= file_size) {
+			return 0;
+		}
+		auto length = MinValue(chunk.length, file_size - chunk.offset);
+		auto buffer = Allocator::Get(context).Allocate(length);
+		handle->Read(buffer.get(), length, chunk.offset);
+		return length;
+	} catch (const IOException &e) {
+		DUCKDB_LOG_WARNING(context, "READ prewarm failed for '%s' (offset %llu, %llu bytes): %s", file.path,
+		                   static_cast<uint64_t>(chunk.offset), static_cast<uint64_t>(chunk.length), e.what());
+		return 0;
+	}
+}
+
+idx_t FilePrewarmStrategy::Execute(const vector<LocalFileInfo> &files, idx_t max_bytes) {
+#ifdef _WIN32
+	if (mode == PrewarmMode::PREFETCH) {
+		throw NotImplementedException(
+		    "PREFETCH prewarm strategy is only supported on Unix-like systems (Linux, macOS, BSD)");
+	}
+#endif
+	// Split the files into chunks in path order, the budget cuts off the chunks after it. The files go to the page
+	// cache, so it is bounded by the page cache budget as well as by max_bytes.
+	const idx_t chunk_bytes = GetTargetBatchBytes(FILE_PREWARM_TARGET_BYTES);
+	const auto page_cache = GetPageCacheBudget();
+	vector<LocalFileChunk> chunks;
+	idx_t budget = MinValue(max_bytes, page_cache.budget_bytes);
+	idx_t chunks_over_budget = 0;
+	for (idx_t file_idx = 0; file_idx < files.size(); file_idx++) {
+		for (idx_t offset = 0; offset < files[file_idx].size; offset += chunk_bytes) {
+			const idx_t length = MinValue(chunk_bytes, files[file_idx].size - offset);
+			execution_stats.blocks_planned++;
+			if (budget == 0) {
+				chunks_over_budget++;
+				continue;
+			}
+			chunks.push_back(LocalFileChunk {file_idx, offset, MinValue(length, budget)});
+			budget -= chunks.back().length;
+		}
+	}
+	execution_stats.blocks_skipped += chunks_over_budget;
+	if (chunks_over_budget > 0 && page_cache.budget_bytes < max_bytes) {
+		DUCKDB_LOG_WARNING(context,
+		                   "Page cache budget reached: %llu chunks skipped, %llu bytes available to the page cache "
+		                   "(limited by %s)",
+		                   chunks_over_budget, page_cache.available_bytes, page_cache.source);
+	}
+	if (chunks.empty()) {
+		return 0;
+	}
+
+	atomic<idx_t> chunks_loaded {0};
+	atomic<idx_t> bytes_loaded {0};
+	atomic<uint64_t> first_load_us {0};
+	auto io_start = std::chrono::steady_clock::now();
+	WorkQueue queue(chunks.size());
+	auto thread_count = std::max(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+	queue.Run(context, static_cast<idx_t>(thread_count), [&](idx_t chunk_idx) {
+		const auto &chunk = chunks[chunk_idx];
+		auto chunk_start = std::chrono::steady_clock::now();
+		auto chunk_loaded = LoadChunk(files[chunk.file_idx], chunk);
+		if (chunk_loaded > 0) {
+			chunks_loaded++;
+			bytes_loaded += chunk_loaded;
+			RecordFirstLoad(first_load_us, io_start);
+		}
+		task_timings.Record(chunk_start);
+	});
+	execution_stats.io_us += GetElapsedMicros(io_start);
+	execution_stats.first_load_us += first_load_us;
+
+	// Chunks over the budget were counted as skipped when planning, failed ones are skipped as well
+	execution_stats.blocks_skipped += chunks.size() - chunks_loaded;
+	execution_stats.blocks_loaded += chunks_loaded;
+	execution_stats.bytes_loaded += bytes_loaded;
+	return bytes_loaded;
+}
+
+} // namespace duckdb
@@ -0,0 +1,274 @@
+#include "core/keep_warm_manager.hpp"
+
+#include "core/block_collector.hpp"
+#include "core/os_prefetch.hpp"
+#include "core/prewarm_stats.hpp"
+#include "core/prewarm_strategy.hpp"
+
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/storage/block_manager.hpp"
+#include "duckdb/storage/buffer/block_handle.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+namespace {
+
+// Reload in ~4MiB batches like the buffer strategy, the rate limit is applied between batches.
+constexpr idx_t KEEP_WARM_BATCH_BYTES = 4ULL * 1024ULL * 1024ULL;
+
+//! Strategy name of keep-warm checks in prewarm_stats(), one call per check
+constexpr const char *KEEP_WARM_STATS_NAME = "keep_warm";
+
+} // namespace
+
+KeepWarmManager::~KeepWarmManager() {
+	StopWorker();
+}
+
+void KeepWarmManager::Keep(KeepWarmPolicy policy, idx_t max_bytes_per_sec_p) {
+	policy.next_check = std::chrono::steady_clock::now();
+	auto new_policy = make_shared_ptr<KeepWarmPolicy>(std::move(policy));
+	lock_guard<mutex> lock(mu);
+	max_bytes_per_sec = max_bytes_per_sec_p;
+	auto existing = std::find_if(policies.begin(), policies.end(), [&](const shared_ptr<KeepWarmPolicy> &entry) {
+		return entry->table_name == new_policy->table_name;
+	});
+	if (existing != policies.end()) {
+		*existing = std::move(new_policy);
+	} else {
+		policies.push_back(std::move(new_policy));
+	}
+	if (!worker.joinable()) {
+		stop_requested = false;
+		window_start = std::chrono::steady_clock::now();
+		window_bytes = 0;
+		worker = std::thread([this]() { WorkerLoop(); });
+	}
+	cv.notify_all();
+}
+
+bool KeepWarmManager::Unkeep(const string &table_name) {
+	lock_guard<mutex> lock(mu);
+	auto existing = std::find_if(policies.begin(), policies.end(), [&](const shared_ptr<KeepWarmPolicy> &entry) {
+		return entry->table_name == table_name;
+	});
+	if (existing == policies.end()) {
+		return false;
+	}
+	policies.erase(existing);
+	cv.notify_all();
+	return true;
+}
+
+void KeepWarmManager::QueryEnd(ClientContext &context) {
+	auto &db_manager = DatabaseManager::Get(DatabaseInstance::GetDatabase(context));
+	lock_guard<mutex> lock(mu);
+	policies.erase(std::remove_if(policies.begin(), policies.end(),
+	                              [&](const shared_ptr<KeepWarmPolicy> &entry) {
+		                              // A database attached again under the same name is a different AttachedDatabase
+		                              auto database = entry->database.lock();
+		                              return !database || db_manager.GetDatabase(database->GetName()) != database;
+	                              }),
+	               policies.end());
+}
+
+void KeepWarmManager::StopWorker() {
+	{
+		lock_guard<mutex> lock(mu);
+		stop_requested = true;
+		cv.notify_all();
+	}
+	if (worker.joinable()) {
+		worker.join();
+	}
+}
+
+void KeepWarmManager::WorkerLoop() {
+	while (true) {
+		shared_ptr<KeepWarmPolicy> due_policy;
+		{
+			unique_lock<mutex> lock(mu);
+			if (stop_requested) {
+				return;
+			}
+			// Pick the policy checked longest ago, or sleep until the next one is due
+			auto now = std::chrono::steady_clock::now();
+			auto next_check = std::chrono::steady_clock::time_point::max();
+			for (auto &policy : policies) {
+				if (policy->next_check <= now && (!due_policy || policy->next_check < due_policy->next_check)) {
+					due_policy = policy;
+				}
+				next_check = std::min(next_check, policy->next_check);
+			}
+			if (!due_policy) {
+				if (next_check == std::chrono::steady_clock::time_point::max()) {
+					cv.wait(lock);
+				} else {
+					cv.wait_until(lock, next_check);
+				}
+				continue;
+			}
+			due_policy->next_check = now + std::chrono::milliseconds(due_policy->interval_ms);
+		}
+		if (!CheckPolicy(*due_policy)) {
+			return;
+		}
+	}
+}
+
+void KeepWarmManager::DropPolicy(KeepWarmPolicy &policy) {
+	lock_guard<mutex> lock(mu);
+	policies.erase(std::remove_if(policies.begin(), policies.end(),
+	                              [&](const shared_ptr<KeepWarmPolicy> &entry) { return entry.get() == &policy; }),
+	               policies.end());
+}
+
+bool KeepWarmManager::RefreshBlocks(KeepWarmPolicy &policy, AttachedDatabase &database) {
+	// The worker has no client of its own, the table is collected again on a connection of its own
+	try {
+		Connection con(database.GetDatabase());
+		con.BeginTransaction();
+		auto resolved = BlockCollector::ResolveTable(*con.context, policy.table_name);
+		if (resolved.database.get() != &database) {
+			return false;
+		}
+		auto &block_manager = database.GetStorageManager().GetBlockManager();
+		const auto checkpoint_stamp = static_cast<uint64_t>(block_manager.GetMetaBlock());
+		auto block_ids = BlockCollector::CollectTableBlocks(*con.context, resolved.table.get());
+		con.Commit();
+		policy.block_ids = block_ids.ToVector();
+		policy.checkpoint_stamp = checkpoint_stamp;
+		return true;
+	} catch (std::exception &) {
+		// The table was dropped or renamed
+		return false;
+	}
+}
+
+bool KeepWarmManager::CheckPolicy(KeepWarmPolicy &policy) {
+	auto database = policy.database.lock();
+	if (!database) {
+		// The database was detached, its blocks are gone for good
+		DropPolicy(policy);
+		return WaitFor(std::chrono::steady_clock::duration::zero());
+	}
+	auto &block_manager = database->GetStorageManager().GetBlockManager();
+	auto &buffer_manager = database->GetDatabase().GetBufferManager();
+	// A checkpoint may have freed or reused blocks of the list and written the table's changes to new ones
+	if (static_cast<uint64_t>(block_manager.GetMetaBlock()) != policy.checkpoint_stamp &&
+	    !RefreshBlocks(policy, *database)) {
+		DUCKDB_LOG_WARNING(database->GetDatabase(), "prewarm_keep: stopped keeping '%s' warm, the table is gone",
+		                   policy.table_name);
+		DropPolicy(policy);
+		return WaitFor(std::chrono::steady_clock::duration::zero());
+	}
+	const idx_t block_size = block_manager.GetBlockAllocSize();
+	const idx_t batch_blocks = MaxValue<idx_t>(1, KEEP_WARM_BATCH_BYTES / block_size);
+	// Blocks past the end of the file were truncated away by a checkpoint
+	const auto total_blocks = static_cast<block_id_t>(block_manager.TotalBlocks());
+	auto valid_end = std::lower_bound(policy.block_ids.begin(), policy.block_ids.end(), total_blocks);
+
+	auto check_start = std::chrono::steady_clock::now();
+	PrewarmExecutionStats stats;
+	stats.blocks_planned = static_cast<idx_t>(valid_end - policy.block_ids.begin());
+	vector<uint64_t> batch_durations_us;
+	if (policy.mode == PrewarmMode::PREFETCH) {
+		// The OS does not tell which pages are cached, every block is hinted again
+		const auto db_path = database->GetStorageManager().GetDBPath();
+		for (auto it = policy.block_ids.begin(); it < valid_end; it += batch_blocks) {
+			auto count = MinValue<idx_t>(batch_blocks, static_cast<idx_t>(valid_end - it));
+			if (!Throttle(count * block_size)) {
+				return false;
+			}
+			auto batch_start = std::chrono::steady_clock::now();
+			stats.blocks_loaded +=
+			    OSPrefetchBlocks(db_path, Span<const block_id_t>(&*it, count), block_size, &stats.bytes_loaded);
+			batch_durations_us.push_back(GetElapsedMicros(batch_start));
+		}
+	} else {
+		D_ASSERT(policy.mode == PrewarmMode::BUFFER);
+		vector<shared_ptr<BlockHandle>> unloaded_handles;
+		for (auto it = policy.block_ids.begin(); it < valid_end; ++it) {
+			auto handle = block_manager.RegisterBlock(*it);
+			if (handle->GetMemory().IsUnloaded()) {
+				unloaded_handles.emplace_back(std::move(handle));
+			}
+		}
+		stats.blocks_resident = stats.blocks_planned - unloaded_handles.size();
+		stats.register_us = GetElapsedMicros(check_start);
+		auto max_memory = buffer_manager.GetMaxMemory();
+		auto used_memory = buffer_manager.GetUsedMemory();
+		auto available = max_memory > used_memory ? max_memory - used_memory : 0;
+		// Same headroom as the prewarm strategies: keeping a table warm must not push everything else out
+		auto max_blocks = static_cast<idx_t>(static_cast<double>(available) * PREWARM_BUFFER_USAGE_RATIO /
+		                                     static_cast<double>(block_size));
+		if (unloaded_handles.size() > max_blocks) {
+			unloaded_handles.resize(max_blocks);
+		}
+		for (idx_t start = 0; start < unloaded_handles.size(); start += batch_blocks) {
+			auto count = MinValue<idx_t>(batch_blocks, unloaded_handles.size() - start);
+			if (!Throttle(count * block_size)) {
+				return false;
+			}
+			auto batch_start = std::chrono::steady_clock::now();
+			vector<shared_ptr<BlockHandle>> batch(unloaded_handles.begin() + start,
+			                                      unloaded_handles.begin() + start + count);
+			buffer_manager.Prefetch(batch);
+			for (const auto &handle : batch) {
+				if (!handle->GetMemory().IsUnloaded()) {
+					stats.blocks_loaded++;
+				}
+			}
+			batch_durations_us.push_back(GetElapsedMicros(batch_start));
+		}
+		stats.bytes_loaded = stats.blocks_loaded * block_size;
+	}
+	stats.blocks_skipped = stats.blocks_planned - stats.blocks_resident - stats.blocks_loaded;
+	stats.io_us = GetElapsedMicros(check_start) - stats.register_us;
+	PrewarmStatsRegistry::Get().Record(KEEP_WARM_STATS_NAME, database->GetName(), /*collection_us=*/0, stats,
+	                                   batch_durations_us);
+	return WaitFor(std::chrono::steady_clock::duration::zero());
+}
+
+bool KeepWarmManager::Throttle(idx_t bytes) {
+	std::chrono::steady_clock::time_point release_time;
+	{
+		lock_guard<mutex> lock(mu);
+		if (stop_requested) {
+			return false;
+		}
+		if (max_bytes_per_sec == 0) {
+			return true;
+		}
+		// Start a new window once the previous one has drained, so idle time does not build up a burst
+		auto now = std::chrono::steady_clock::now();
+		auto window_end =
+		    window_start + std::chrono::microseconds(window_bytes * 1000000ULL / max_bytes_per_sec);
+		if (window_end <= now) {
+			window_start = now;
+			window_bytes = 0;
+		}
+		release_time = window_start + std::chrono::microseconds(window_bytes * 1000000ULL / max_bytes_per_sec);
+		window_bytes += bytes;
+	}
+	return WaitFor(release_time - std::chrono::steady_clock::now());
+}
+
+bool KeepWarmManager::WaitFor(std::chrono::steady_clock::duration duration) {
+	unique_lock<mutex> lock(mu);
+	if (duration > std::chrono::steady_clock::duration::zero()) {
+		cv.wait_for(lock, duration, [this]() { return stop_requested; });
+	}
+	return !stop_requested;
+}
+
+} // namespace duckdb
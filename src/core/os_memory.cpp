@@ -0,0 +1,206 @@
+#include "core/os_memory.hpp"
+
+#include "scope_guard.hpp"
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/vector.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+//! Parse a decimal number that makes up all of `text`
+//! @return false for empty text, other characters or overflow
+bool TryParseUnsigned(const string &text, idx_t &result) {
+	if (text.empty()) {
+		return false;
+	}
+	idx_t value = 0;
+	for (char c : text) {
+		if (c < '0' || c > '9') {
+			return false;
+		}
+		const idx_t digit = static_cast<idx_t>(c - '0');
+		if (value > (NumericLimits<idx_t>::Maximum() - digit) / 10) {
+			return false;
+		}
+		value = value * 10 + digit;
+	}
+	result = value;
+	return true;
+}
+
+//! Whitespace separated fields of a line, runs of blanks count as one separator
+vector<string> SplitFields(const string &line) {
+	vector<string> fields;
+	idx_t pos = 0;
+	while (pos < line.size()) {
+		while (pos < line.size() && StringUtil::CharacterIsSpace(line[pos])) {
+			pos++;
+		}
+		const idx_t start = pos;
+		while (pos < line.size() && !StringUtil::CharacterIsSpace(line[pos])) {
+			pos++;
+		}
+		if (pos > start) {
+			fields.push_back(line.substr(start, pos - start));
+		}
+	}
+	return fields;
+}
+
+//! Memory the cgroup can take before the kernel reclaims more than cold page cache
+idx_t GetCgroupHeadroom(const OSMemoryInfo &info) {
+	if (info.cgroup_max == OS_MEMORY_UNKNOWN || info.cgroup_current == OS_MEMORY_UNKNOWN) {
+		return OS_MEMORY_UNKNOWN;
+	}
+	const idx_t reclaimable = info.cgroup_inactive_file == OS_MEMORY_UNKNOWN ? 0 : info.cgroup_inactive_file;
+	const idx_t working_set = info.cgroup_current > reclaimable ? info.cgroup_current - reclaimable : 0;
+	return info.cgroup_max > working_set ? info.cgroup_max - working_set : 0;
+}
+
+#ifdef __linux__
+//! Mount point of the cgroup v2 hierarchy
+constexpr const char *CGROUP_V2_MOUNT = "/sys/fs/cgroup";
+
+//! Content of a small procfs or cgroupfs file, which report a size of 0 and have to be read until EOF
+//! @return Empty if the file cannot be read
+string ReadSmallFile(const string &path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return string();
+	}
+	SCOPE_EXIT {
+		close(fd);
+	};
+	string content;
+	char buffer[4096];
+	while (true) {
+		auto bytes_read = read(fd, buffer, sizeof(buffer));
+		if (bytes_read < 0 && errno == EINTR) {
+			continue;
+		}
+		if (bytes_read <= 0) {
+			break;
+		}
+		content.append(buffer, static_cast<size_t>(bytes_read));
+	}
+	return content;
+}
+#endif
+
+} // namespace
+
+idx_t ParseMemAvailable(const string &meminfo) {
+	for (auto &line : StringUtil::Split(meminfo, '\n')) {
+		// "MemAvailable:   12345678 kB"
+		auto fields = SplitFields(line);
+		if (fields.empty() || fields[0] != "MemAvailable:") {
+			continue;
+		}
+		idx_t value;
+		if (fields.size() < 2 || !TryParseUnsigned(fields[1], value)) {
+			return OS_MEMORY_UNKNOWN;
+		}
+		const bool in_kb = fields.size() > 2 && fields[2] == "kB";
+		return in_kb ? value * 1024 : value;
+	}
+	return OS_MEMORY_UNKNOWN;
+}
+
+idx_t ParseCgroupMemoryValue(const string &content) {
+	auto value_text = content;
+	StringUtil::Trim(value_text);
+	idx_t value;
+	if (!TryParseUnsigned(value_text, value)) {
+		return OS_MEMORY_UNKNOWN;
+	}
+	return value;
+}
+
+idx_t ParseCgroupMemoryStat(const string &memory_stat, const string &field) {
+	for (auto &line : StringUtil::Split(memory_stat, '\n')) {
+		// "inactive_file 1234"
+		auto fields = SplitFields(line);
+		idx_t value;
+		if (fields.size() == 2 && fields[0] == field && TryParseUnsigned(fields[1], value)) {
+			return value;
+		}
+	}
+	return OS_MEMORY_UNKNOWN;
+}
+
+string ParseCgroupV2Path(const string &proc_self_cgroup) {
+	for (auto &line : StringUtil::Split(proc_self_cgroup, '\n')) {
+		// cgroup v1 lines name their controllers ("4:memory:/path"), the single v2 line is "0::/path"
+		if (StringUtil::StartsWith(line, "0::")) {
+			auto path = line.substr(3);
+			StringUtil::Trim(path);
+			return path;
+		}
+	}
+	return string();
+}
+
+OSMemoryInfo ReadOSMemoryInfo() {
+	OSMemoryInfo info;
+#ifdef __linux__
+	info.mem_available = ParseMemAvailable(ReadSmallFile("/proc/meminfo"));
+
+	auto cgroup_path = ParseCgroupV2Path(ReadSmallFile("/proc/self/cgroup"));
+	if (cgroup_path.empty()) {
+		return info;
+	}
+	// A limit on any ancestor applies as well; keep the level with the least headroom. The root cgroup has no
+	// memory.max, inside a cgroup namespace the mount point is the container's cgroup and has one.
+	idx_t min_headroom = OS_MEMORY_UNKNOWN;
+	while (true) {
+		const string dir = string(CGROUP_V2_MOUNT) + (cgroup_path == "/" ? "" : cgroup_path);
+		OSMemoryInfo level;
+		level.cgroup_max = ParseCgroupMemoryValue(ReadSmallFile(dir + "/memory.max"));
+		if (level.cgroup_max != OS_MEMORY_UNKNOWN) {
+			level.cgroup_current = ParseCgroupMemoryValue(ReadSmallFile(dir + "/memory.current"));
+			level.cgroup_inactive_file = ParseCgroupMemoryStat(ReadSmallFile(dir + "/memory.stat"), "inactive_file");
+			const idx_t headroom = GetCgroupHeadroom(level);
+			if (headroom < min_headroom) {
+				min_headroom = headroom;
+				info.cgroup_max = level.cgroup_max;
+				info.cgroup_current = level.cgroup_current;
+				info.cgroup_inactive_file = level.cgroup_inactive_file;
+			}
+		}
+		if (cgroup_path == "/" || cgroup_path.empty()) {
+			break;
+		}
+		auto parent_end = cgroup_path.find_last_of('/');
+		cgroup_path = parent_end == 0 || parent_end == string::npos ? "/" : cgroup_path.substr(0, parent_end);
+	}
+#endif
+	return info;
+}
+
+PageCacheBudget CalculatePageCacheBudget(const OSMemoryInfo &info, double usage_ratio) {
+	PageCacheBudget budget;
+	if (info.mem_available != OS_MEMORY_UNKNOWN) {
+		budget.available_bytes = info.mem_available;
+		budget.source = "MemAvailable";
+	}
+	const idx_t cgroup_headroom = GetCgroupHeadroom(info);
+	if (cgroup_headroom < budget.available_bytes) {
+		budget.available_bytes = cgroup_headroom;
+		budget.source = "cgroup memory.max";
+	}
+	if (budget.available_bytes != OS_MEMORY_UNKNOWN) {
+		budget.budget_bytes = static_cast<idx_t>(static_cast<double>(budget.available_bytes) * usage_ratio);
+	}
+	return budget;
+}
+
+} // namespace duckdb
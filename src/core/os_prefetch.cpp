@@ -7,6 +7,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 #if defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
 #include <sys/fcntl.h>
 #endif
@@ -14,7 +17,51 @@
 
 namespace duckdb {
 
-idx_t OSPrefetchBlocks(const string &db_path, Span<const block_id_t> block_ids, idx_t block_size) {
+#ifndef _WIN32
+namespace {
+
+//! Hint the OS to read a byte range of an open file into the page cache
+//! @return false if the hint failed or no hint is available on this platform
+bool AdviseWillNeed(int fd, off_t offset, off_t amount) {
+	// Following PostgreSQL's FilePrefetch implementation
+#if defined(__linux__) || (defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L)
+	// Use posix_fadvise with POSIX_FADV_WILLNEED on Linux and POSIX.1-2001 systems
+	// This is the simplest standardized interface for prefetching
+	int result;
+retry_posix:
+	result = posix_fadvise(fd, offset, amount, POSIX_FADV_WILLNEED);
+
+	// Retry on interrupt signal, following PostgreSQL's pattern
+	if (result == EINTR) {
+		goto retry_posix;
+	}
+	return result == 0;
+
+#elif defined(__APPLE__)
+	// macOS: Use fcntl with F_RDADVISE
+	// This is the macOS-specific equivalent to posix_fadvise
+	struct radvisory {
+		off_t ra_offset; // offset into the file
+		int ra_count;    // size of the read
+	} ra;
+
+	ra.ra_offset = offset;
+	ra.ra_count = static_cast<int>(std::min(amount, static_cast<off_t>(INT_MAX)));
+
+	// fcntl returns -1 on error, anything else on success
+	return fcntl(fd, F_RDADVISE, &ra) != -1;
+
+#else
+	// No OS-level prefetch hint is issued on this platform, so nothing counts as prefetched
+	return false;
+#endif
+}
+
+} // namespace
+#endif // !_WIN32
+
+idx_t OSPrefetchBlocks(const string &db_path, Span<const block_id_t> block_ids, idx_t block_size,
+                       idx_t *bytes_prefetched) {
 #ifndef _WIN32
 	int fd = open(db_path.c_str(), O_RDONLY);
 	if (fd < 0) {
@@ -53,51 +100,122 @@ idx_t OSPrefetchBlocks(const string &db_path, Span<const block_id_t> block_ids,
 			}
 		}
 
-		// Prefetch this block using OS-specific hints
-		// Following PostgreSQL's FilePrefetch implementation
-#if defined(__linux__) || (defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L)
-		// Use posix_fadvise with POSIX_FADV_WILLNEED on Linux and POSIX.1-2001 systems
-		// This is the simplest standardized interface for prefetching
+		if (AdviseWillNeed(fd, static_cast<off_t>(offset), amount)) {
+			blocks_prefetched++;
+			if (bytes_prefetched) {
+				*bytes_prefetched += static_cast<idx_t>(amount);
+			}
+		}
+	}
+
+	return blocks_prefetched;
+#else
+	// Windows: Not supported
+	return 0;
+#endif // !_WIN32
+}
+
+idx_t OSPrefetchFileRange(const string &path, idx_t offset, idx_t length) {
+#ifndef _WIN32
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return 0;
+	}
+	SCOPE_EXIT {
+		close(fd);
+	};
+
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		return 0;
+	}
+	const auto file_size = static_cast<uint64_t>(st.st_size);
+	if (offset >= file_size) {
+		return 0;
+	}
+	const auto amount = static_cast<off_t>(std::min<uint64_t>(length, file_size - offset));
+	if (amount <= 0 || !AdviseWillNeed(fd, static_cast<off_t>(offset), amount)) {
+		return 0;
+	}
+	return static_cast<idx_t>(amount);
+#else
+	// Windows: Not supported
+	return 0;
+#endif // !_WIN32
+}
+
+vector<block_id_t> OSEvictBlocks(const string &db_path, Span<const block_id_t> block_ids, idx_t block_size) {
+#ifdef __linux__
+	int fd = open(db_path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return {};
+	}
+	SCOPE_EXIT {
+		close(fd);
+	};
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		return {};
+	}
+	const auto file_size = static_cast<uint64_t>(st.st_size);
+	// mincore() reports the residency of mapped pages without faulting them in
+	void *mapping = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (mapping == MAP_FAILED) {
+		return {};
+	}
+	SCOPE_EXIT {
+		munmap(mapping, file_size);
+	};
+	const auto page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+
+	vector<block_id_t> blocks_evicted;
+	vector<unsigned char> residency;
+	for (const auto &block_id : block_ids) {
+		const uint64_t offset = GetBlockFileOffset(block_id, block_size);
+		if (offset >= file_size) {
+			continue;
+		}
+		const uint64_t end = std::min<uint64_t>(offset + block_size, file_size);
+		const uint64_t page_start = offset - offset % page_size;
+		const idx_t page_count = static_cast<idx_t>((end - page_start + page_size - 1) / page_size);
+		residency.resize(page_count);
+		if (mincore(static_cast<char *>(mapping) + page_start, end - page_start, residency.data()) != 0) {
+			continue;
+		}
+		bool resident = false;
+		for (auto page : residency) {
+			resident = resident || (page & 1);
+		}
+		if (!resident) {
+			continue;
+		}
 		int result;
 	retry_posix:
-		result = posix_fadvise(fd, static_cast<off_t>(offset), amount, POSIX_FADV_WILLNEED);
-
-		// Retry on interrupt signal, following PostgreSQL's pattern
+		result = posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(end - offset), POSIX_FADV_DONTNEED);
 		if (result == EINTR) {
 			goto retry_posix;
 		}
-
 		if (result == 0) {
-			blocks_prefetched++;
+			blocks_evicted.push_back(block_id);
 		}
-
-#elif defined(__APPLE__)
-		// macOS: Use fcntl with F_RDADVISE
-		// This is the macOS-specific equivalent to posix_fadvise
-		struct radvisory {
-			off_t ra_offset; // offset into the file
-			int ra_count;    // size of the read
-		} ra;
-
-		ra.ra_offset = static_cast<off_t>(offset);
-		ra.ra_count = static_cast<int>(std::min(static_cast<off_t>(amount), static_cast<off_t>(INT_MAX)));
-
-		int result = fcntl(fd, F_RDADVISE, &ra);
-		// fcntl returns -1 on error, anything else on success
-		if (result != -1) {
-			blocks_prefetched++;
-		}
-
+	}
+	return blocks_evicted;
 #else
-		// No OS-level prefetch hint is issued on this platform, so do not count this block
-		// as successfully prefetched.
+	// Other platforms offer no per-range page cache eviction, or no way to tell which pages are cached
+	return {};
 #endif
-	}
+}
 
-	return blocks_prefetched;
+idx_t OSGetFileSize(const string &path) {
+#ifndef _WIN32
+	struct stat st;
+	if (stat(path.c_str(), &st) != 0) {
+		return OS_FILE_SIZE_UNKNOWN;
+	}
+	return static_cast<idx_t>(st.st_size);
 #else
 	// Windows: Not supported
-	return 0;
+	return OS_FILE_SIZE_UNKNOWN;
 #endif // !_WIN32
 }
 
@@ -0,0 +1,100 @@
+#include "core/parquet_metadata_prewarm_strategy.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/prepared_statement.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+BufferCapacityInfo ParquetMetadataPrewarmStrategy::CalculateMaxAvailableBlocks() {
+	BufferCapacityInfo info;
+	info.block_size = 0;
+	info.max_capacity = NumericLimits<idx_t>::Maximum();
+	info.used_space = 0;
+	info.available_space = NumericLimits<idx_t>::Maximum();
+	info.max_blocks = NumericLimits<idx_t>::Maximum();
+	return info;
+}
+
+vector<string> ParquetMetadataPrewarmStrategy::ListFiles(ClientContext &context, const string &pattern) {
+	// The virtual file system serves local paths as well as remote ones through cache_httpfs
+	auto &fs = FileSystem::GetFileSystem(context);
+	vector<string> file_paths;
+	for (const auto &file_info : fs.Glob(pattern)) {
+		file_paths.emplace_back(file_info.path);
+	}
+	if (file_paths.empty()) {
+		throw InvalidInputException("No files match '%s'", pattern);
+	}
+	std::sort(file_paths.begin(), file_paths.end());
+	return file_paths;
+}
+
+idx_t ParquetMetadataPrewarmStrategy::CacheFooters(PreparedStatement &statement, const vector<string> &file_paths,
+                                                   idx_t start, idx_t end) {
+	vector<Value> paths;
+	paths.reserve(end - start);
+	for (idx_t idx = start; idx < end; idx++) {
+		paths.emplace_back(file_paths[idx]);
+	}
+	vector<Value> parameters {Value::LIST(LogicalType::VARCHAR, std::move(paths))};
+	auto footers = statement.Execute(parameters, /*allow_stream_result=*/false);
+	if (!footers->HasError()) {
+		return end - start;
+	}
+	if (end - start == 1) {
+		DUCKDB_LOG_WARNING(context, "Parquet metadata prewarm failed for '%s': %s", file_paths[start],
+		                   footers->GetError());
+		return 0;
+	}
+	// One unreadable file fails the whole range, split it to cache all the others
+	const idx_t middle = start + (end - start) / 2;
+	return CacheFooters(statement, file_paths, start, middle) + CacheFooters(statement, file_paths, middle, end);
+}
+
+idx_t ParquetMetadataPrewarmStrategy::Execute(const vector<string> &file_paths) {
+	execution_stats.blocks_planned += file_paths.size();
+	if (file_paths.empty()) {
+		return 0;
+	}
+	Value metadata_cache;
+	if (!context.TryGetCurrentSetting("parquet_metadata_cache", metadata_cache) || metadata_cache.IsNull() ||
+	    !metadata_cache.GetValue<bool>()) {
+		DUCKDB_LOG_WARNING(context, "parquet_metadata_cache is disabled for this connection, its queries will not use "
+		                            "the prewarmed footers until it is enabled");
+	}
+
+	auto io_start = std::chrono::steady_clock::now();
+	Connection connection(DatabaseInstance::GetDatabase(context));
+	// The parquet reader only inserts footers into the object cache when the cache is enabled
+	auto enable_cache = connection.Query("SET SESSION parquet_metadata_cache = true");
+	if (enable_cache->HasError()) {
+		enable_cache->ThrowError();
+	}
+	auto statement = connection.Prepare("SELECT count(*) FROM parquet_file_metadata($1::VARCHAR[])");
+	if (statement->HasError()) {
+		statement->error.Throw();
+	}
+	const idx_t files_cached = CacheFooters(*statement, file_paths, 0, file_paths.size());
+	task_timings.Record(io_start);
+	const auto io_us = GetElapsedMicros(io_start);
+	execution_stats.io_us += io_us;
+	// The footers become visible together when the query finishes
+	if (files_cached > 0) {
+		execution_stats.first_load_us += io_us;
+	}
+
+	execution_stats.blocks_skipped += file_paths.size() - files_cached;
+	execution_stats.blocks_loaded += files_cached;
+	return files_cached;
+}
+
+} // namespace duckdb
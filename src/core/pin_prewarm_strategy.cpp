@@ -0,0 +1,171 @@
+#include "core/pin_prewarm_strategy.hpp"
+
+#include "core/extent_scheduler.hpp"
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer/block_handle.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Same ~4MiB batches as BUFFER: every batch is loaded with one Prefetch call, then pinned block by block.
+constexpr idx_t PIN_PREWARM_TARGET_BYTES = 4ULL * 1024ULL * 1024ULL;
+
+//! Give back a claim made with PrewarmStrategy::ClaimBlocks()
+void ReturnBlocks(atomic<idx_t> &budget, idx_t blocks) {
+	budget += blocks;
+}
+
+} // namespace
+
+idx_t PinPrewarmStrategy::GetPinCap() const {
+	double fraction = DEFAULT_PREWARM_PIN_MAX_MEMORY_FRACTION;
+	Value fraction_val;
+	if (context.TryGetCurrentSetting(PREWARM_PIN_MAX_MEMORY_FRACTION_SETTING, fraction_val) &&
+	    !fraction_val.IsNull()) {
+		fraction = fraction_val.GetValue<double>();
+	}
+	fraction = MaxValue(0.0, MinValue(1.0, fraction));
+	return static_cast<idx_t>(static_cast<double>(buffer_manager.GetMaxMemory()) * fraction);
+}
+
+BufferCapacityInfo PinPrewarmStrategy::CalculateMaxAvailableBlocks() {
+	auto info = LocalPrewarmStrategy::CalculateMaxAvailableBlocks();
+	const idx_t cap = GetPinCap();
+	const idx_t pinned_bytes = PinnedMemoryBudget::GetReserved(DatabaseInstance::GetDatabase(context));
+	const idx_t pin_blocks = cap > pinned_bytes ? (cap - pinned_bytes) / info.block_size : 0;
+	info.max_blocks = MinValue(info.max_blocks, pin_blocks);
+	return info;
+}
+
+idx_t PinPrewarmStrategy::Execute(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) {
+	execution_stats.blocks_planned += block_ids.size();
+	pinned = make_uniq<PinnedBlocks>(database.shared_from_this(), block_manager.GetBlockAllocSize());
+	if (block_ids.empty()) {
+		return 0;
+	}
+
+	// Loading is limited by free memory like BUFFER; pinning, of loaded and resident blocks alike, by the pin cap
+	auto capacity_info = LocalPrewarmStrategy::CalculateMaxAvailableBlocks();
+	const idx_t block_size = capacity_info.block_size;
+	auto &db_instance = database.GetDatabase();
+	const idx_t wanted_blocks = MinValue(max_blocks, block_ids.size());
+	PinnedMemoryReservation reservation(db_instance, wanted_blocks * block_size, GetPinCap());
+	atomic<idx_t> pin_budget {reservation.GetBytes() / block_size};
+	atomic<idx_t> load_budget {capacity_info.max_blocks};
+
+	auto thread_count = std::max(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+	auto blocks_per_chunk = CalculateBlocksPerTask(block_size, wanted_blocks, thread_count,
+	                                               GetTargetBatchBytes(PIN_PREWARM_TARGET_BYTES));
+	ExtentScheduler scheduler(block_ids, MaxValue<idx_t>(blocks_per_chunk, 1));
+
+	mutex pinned_lock;
+	atomic<idx_t> blocks_resident {0};
+	atomic<idx_t> blocks_loaded {0};
+	atomic<idx_t> blocks_failed {0};
+	atomic<uint64_t> first_load_us {0};
+	auto io_start = std::chrono::steady_clock::now();
+	if (pin_budget.load() == 0) {
+		scheduler.Cancel();
+	}
+	scheduler.Run(context, static_cast<idx_t>(thread_count), [&](const ExtentChunk &chunk) {
+		auto chunk_start = std::chrono::steady_clock::now();
+		vector<shared_ptr<BlockHandle>> to_pin;
+		vector<shared_ptr<BlockHandle>> to_load;
+		// Whether each block to pin was unloaded when registered
+		vector<bool> pin_unloaded;
+		to_pin.reserve(chunk.count);
+		for (idx_t offset = 0; offset < chunk.count; offset++) {
+			auto handle = block_manager.RegisterBlock(chunk.first_block + static_cast<block_id_t>(offset));
+			const bool unloaded = handle->GetMemory().IsUnloaded();
+			if (ClaimBlocks(pin_budget, 1) == 0) {
+				break;
+			}
+			if (unloaded && ClaimBlocks(load_budget, 1) == 0) {
+				ReturnBlocks(pin_budget, 1);
+				continue;
+			}
+			if (unloaded) {
+				to_load.push_back(handle);
+			}
+			to_pin.push_back(std::move(handle));
+			pin_unloaded.push_back(unloaded);
+		}
+		// Nothing more can be pinned, leave the remaining chunks unclaimed
+		if (pin_budget.load() == 0) {
+			scheduler.Cancel();
+		}
+		if (to_pin.empty()) {
+			return;
+		}
+		// Load the batch in one go, pinning the loaded blocks afterwards does no I/O unless they were evicted since
+		if (!to_load.empty()) {
+			buffer_manager.Prefetch(to_load);
+		}
+
+		vector<BufferHandle> batch_pins;
+		batch_pins.reserve(to_pin.size());
+		idx_t batch_resident = 0;
+		for (idx_t idx = 0; idx < to_pin.size(); idx++) {
+			auto &handle = to_pin[idx];
+			try {
+				batch_pins.push_back(buffer_manager.Pin(handle));
+			} catch (const IOException &e) {
+				DUCKDB_LOG_WARNING(context, "PIN prewarm failed for block %lld: %s",
+				                   static_cast<int64_t>(handle->BlockId()), e.what());
+				continue;
+			} catch (const OutOfMemoryException &e) {
+				DUCKDB_LOG_WARNING(context, "PIN prewarm failed for block %lld: %s",
+				                   static_cast<int64_t>(handle->BlockId()), e.what());
+				continue;
+			}
+			if (!pin_unloaded[idx]) {
+				batch_resident++;
+			}
+		}
+		blocks_resident += batch_resident;
+		blocks_loaded += batch_pins.size() - batch_resident;
+		blocks_failed += to_pin.size() - batch_pins.size();
+		if (batch_pins.size() > batch_resident) {
+			RecordFirstLoad(first_load_us, io_start);
+		}
+		{
+			lock_guard<mutex> guard(pinned_lock);
+			for (auto &pin : batch_pins) {
+				pinned->Add(std::move(pin));
+			}
+			// The pinned blocks return their bytes when unpinned, the reservation returns the rest
+			reservation.Transfer(batch_pins.size() * block_size);
+		}
+		task_timings.Record(chunk_start);
+	});
+	execution_stats.io_us += GetElapsedMicros(io_start);
+	execution_stats.first_load_us += first_load_us;
+
+	// Blocks neither pinned nor failed ran out of pin or load budget, including those of chunks never claimed
+	const idx_t blocks_over_limit = block_ids.size() - blocks_resident - blocks_loaded - blocks_failed;
+	if (blocks_over_limit > 0) {
+		DUCKDB_LOG_WARNING(context,
+		                   "Pin limit reached.\n"
+		                   "  Table blocks: %llu\n"
+		                   "  Pinned: %llu blocks (skipped %llu due to limit)\n"
+		                   "  Pin cap: %llu bytes, consider increasing prewarm_pin_max_memory_fraction or memory_limit",
+		                   block_ids.size(), pinned->GetBlockCount(), blocks_over_limit, GetPinCap());
+	}
+
+	const idx_t bytes_loaded = blocks_loaded * block_size;
+	execution_stats.blocks_resident += blocks_resident;
+	execution_stats.blocks_skipped += block_ids.size() - blocks_resident - blocks_loaded;
+	execution_stats.blocks_loaded += blocks_loaded;
+	execution_stats.bytes_loaded += bytes_loaded;
+	return bytes_loaded;
+}
+
+} // namespace duckdb
@@ -0,0 +1,169 @@
+#include "core/pinned_blocks.hpp"
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/database_manager.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct PinnedMemoryState {
+	mutex lock;
+	//! Reserved bytes by database instance, entries are dropped once everything is released
+	unordered_map<const DatabaseInstance *, idx_t> reserved;
+};
+
+PinnedMemoryState &GetPinnedMemoryState() {
+	static PinnedMemoryState state;
+	return state;
+}
+
+} // namespace
+
+idx_t PinnedMemoryBudget::Reserve(const DatabaseInstance &db, idx_t wanted, idx_t cap) {
+	auto &state = GetPinnedMemoryState();
+	lock_guard<mutex> guard(state.lock);
+	auto &reserved = state.reserved[&db];
+	const idx_t granted = reserved >= cap ? 0 : MinValue(wanted, cap - reserved);
+	reserved += granted;
+	if (reserved == 0) {
+		state.reserved.erase(&db);
+	}
+	return granted;
+}
+
+void PinnedMemoryBudget::Release(const DatabaseInstance &db, idx_t bytes) {
+	if (bytes == 0) {
+		return;
+	}
+	auto &state = GetPinnedMemoryState();
+	lock_guard<mutex> guard(state.lock);
+	auto entry = state.reserved.find(&db);
+	D_ASSERT(entry != state.reserved.end() && entry->second >= bytes);
+	if (entry == state.reserved.end()) {
+		return;
+	}
+	entry->second -= MinValue(entry->second, bytes);
+	if (entry->second == 0) {
+		state.reserved.erase(entry);
+	}
+}
+
+idx_t PinnedMemoryBudget::GetReserved(const DatabaseInstance &db) {
+	auto &state = GetPinnedMemoryState();
+	lock_guard<mutex> guard(state.lock);
+	auto entry = state.reserved.find(&db);
+	return entry == state.reserved.end() ? 0 : entry->second;
+}
+
+PinnedMemoryReservation::PinnedMemoryReservation(const DatabaseInstance &db_p, idx_t wanted, idx_t cap)
+    : db(db_p), bytes(PinnedMemoryBudget::Reserve(db_p, wanted, cap)) {
+}
+
+PinnedMemoryReservation::~PinnedMemoryReservation() {
+	PinnedMemoryBudget::Release(db, bytes);
+}
+
+void PinnedMemoryReservation::Transfer(idx_t transferred) {
+	D_ASSERT(transferred <= bytes);
+	bytes -= MinValue(bytes, transferred);
+}
+
+PinnedBlocks::PinnedBlocks(shared_ptr<AttachedDatabase> database_p, idx_t block_size_p)
+    : database(std::move(database_p)), block_size(block_size_p) {
+}
+
+PinnedBlocks::~PinnedBlocks() {
+	const idx_t bytes = GetBytes();
+	// Unpin before returning the bytes, so the budget never undercounts what is pinned
+	handles.clear();
+	PinnedMemoryBudget::Release(database->GetDatabase(), bytes);
+}
+
+void PinnedBlocks::Add(BufferHandle handle) {
+	handles.push_back(std::move(handle));
+}
+
+void PinnedBlockRegistry::Pin(const string &table_name, unique_ptr<PinnedBlocks> pinned) {
+	unique_ptr<PinnedBlocks> replaced;
+	{
+		lock_guard<mutex> guard(lock);
+		replaced = std::move(pins[table_name]);
+		pins[table_name] = std::move(pinned);
+	}
+}
+
+idx_t PinnedBlockRegistry::Release(const string &table_name) {
+	unique_ptr<PinnedBlocks> released;
+	{
+		lock_guard<mutex> guard(lock);
+		auto entry = pins.find(table_name);
+		if (entry == pins.end()) {
+			return 0;
+		}
+		released = std::move(entry->second);
+		pins.erase(entry);
+	}
+	// Unpinned outside the lock when `released` goes out of scope
+	return released->GetBytes();
+}
+
+idx_t PinnedBlockRegistry::ReleaseAll() {
+	map<string, unique_ptr<PinnedBlocks>> released;
+	{
+		lock_guard<mutex> guard(lock);
+		released = std::move(pins);
+		pins.clear();
+	}
+	idx_t bytes = 0;
+	for (const auto &entry : released) {
+		bytes += entry.second->GetBytes();
+	}
+	return bytes;
+}
+
+idx_t PinnedBlockRegistry::ReleaseDetached(ClientContext &context) {
+	auto &db_manager = DatabaseManager::Get(DatabaseInstance::GetDatabase(context));
+	vector<unique_ptr<PinnedBlocks>> released;
+	{
+		lock_guard<mutex> guard(lock);
+		for (auto entry = pins.begin(); entry != pins.end();) {
+			auto &database = entry->second->GetDatabase();
+			// A database attached again under the same name is a different AttachedDatabase
+			auto attached = db_manager.GetDatabase(database.GetName());
+			if (attached.get() == &database) {
+				++entry;
+				continue;
+			}
+			released.push_back(std::move(entry->second));
+			entry = pins.erase(entry);
+		}
+	}
+	idx_t bytes = 0;
+	for (const auto &pinned : released) {
+		bytes += pinned->GetBytes();
+	}
+	return bytes;
+}
+
+void PinnedBlockRegistry::QueryEnd(ClientContext &context) {
+	{
+		lock_guard<mutex> guard(lock);
+		if (pins.empty()) {
+			return;
+		}
+	}
+	ReleaseDetached(context);
+}
+
+idx_t PinnedBlockRegistry::GetPinnedBytes(const string &table_name) const {
+	lock_guard<mutex> guard(lock);
+	auto entry = pins.find(table_name);
+	return entry == pins.end() ? 0 : entry->second->GetBytes();
+}
+
+} // namespace duckdb
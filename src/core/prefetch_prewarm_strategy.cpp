@@ -1,10 +1,13 @@
 #include "core/prefetch_prewarm_strategy.hpp"
+#include "core/extent_scheduler.hpp"
 #include "core/os_prefetch.hpp"
 
 #include "duckdb/common/atomic.hpp"
-#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/logging/logger.hpp"
 #include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer/block_handle.hpp"
 #include "duckdb/storage/storage_info.hpp"
+#include "duckdb/main/attached_database.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 
 namespace duckdb {
@@ -14,82 +17,103 @@ namespace {
 // Target ~512KiB per hint batch to align with page cache granularity.
 constexpr idx_t PREFETCH_CHUNK_SIZE = Storage::SECTOR_SIZE * 128;
 
-class OSPrefetchTask : public BaseExecutorTask {
-public:
-	OSPrefetchTask(TaskExecutor &executor, const string &db_path_p, Span<const block_id_t> block_ids_p,
-	               idx_t block_size_p, atomic<idx_t> &blocks_prefetched_p)
-	    : BaseExecutorTask(executor), db_path(db_path_p), block_ids(block_ids_p), block_size(block_size_p),
-	      blocks_prefetched(blocks_prefetched_p) {
-	}
-
-	void ExecuteTask() override {
-		auto count = OSPrefetchBlocks(db_path, block_ids, block_size);
-		blocks_prefetched += count;
-	}
-
-	string TaskType() const override {
-		return "OSPrefetchTask";
-	}
-
-private:
-	string db_path;
-	Span<const block_id_t> block_ids;
-	idx_t block_size;
-	atomic<idx_t> &blocks_prefetched;
-};
-
 } // namespace
 
-idx_t PrefetchPrewarmStrategy::Execute(DuckTableEntry &table_entry, const unordered_set<block_id_t> &block_ids,
-                                       idx_t max_blocks) {
+PrewarmPlanSummary PrefetchPrewarmStrategy::Plan(AttachedDatabase &database, const BlockIdSet &block_ids,
+                                                 idx_t max_blocks) {
 	CheckDirectIO("PREFETCH");
+	return LocalPrewarmStrategy::Plan(database, block_ids, max_blocks);
+}
 
-	auto block_size = block_manager.GetBlockAllocSize();
+idx_t PrefetchPrewarmStrategy::Execute(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) {
+	CheckDirectIO("PREFETCH");
 
-	// Sort block IDs for sequential prefetch hints
-	auto sorted_blocks = vector<block_id_t>(block_ids.begin(), block_ids.end());
-	std::sort(sorted_blocks.begin(), sorted_blocks.end());
-	auto total_blocks = sorted_blocks.size();
+	auto block_size = block_manager.GetBlockAllocSize();
+	// Get the database file path from the storage manager
+	string db_path = database.GetStorageManager().GetDBPath();
+	const idx_t file_size = GetDatabaseFileSize(database);
+	execution_stats.blocks_planned += block_ids.size();
+	if (block_ids.empty()) {
+		return 0;
+	}
 
 	auto capacity_info = CalculateMaxAvailableBlocks();
 	idx_t effective_max = std::min(capacity_info.max_blocks, max_blocks);
-	if (total_blocks > effective_max) {
-		idx_t blocks_skipped = total_blocks - effective_max;
-		sorted_blocks.resize(effective_max);
-
-		DUCKDB_LOG_WARNING(context,
-		                   "Maximum blocks to prefetch limit reached.\n"
-		                   "  Table blocks: %llu\n"
-		                   "  Prewarming: %llu blocks (skipping %llu due to limit)\n"
-		                   "  Current available memory: %llu bytes, consider increasing memory_limit",
-		                   total_blocks, effective_max, blocks_skipped, capacity_info.available_space);
-		total_blocks = sorted_blocks.size();
-	}
 
 #ifndef _WIN32
-	// Get the database file path from the storage manager
-	auto &catalog = table_entry.ParentCatalog();
-	auto &storage_manager = StorageManager::Get(catalog);
-	string db_path = storage_manager.GetDBPath();
-
-	auto thread_count = std::max(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
-	auto blocks_per_task = CalculateBlocksPerTask(block_size, total_blocks, thread_count, PREFETCH_CHUNK_SIZE);
-	if (blocks_per_task == 0) {
+	if (effective_max == 0) {
+		DUCKDB_LOG_WARNING(context, "Insufficient memory to prewarm any blocks (available: %llu bytes, limited by %s)",
+		                   capacity_info.available_space, capacity_info.limited_by);
+		execution_stats.blocks_skipped += block_ids.size();
 		return 0;
 	}
 
-	TaskExecutor executor(context);
-	atomic<idx_t> blocks_prefetched {0};
+	// Like READ, every task registers the chunk it claimed and hints the blocks that are not in the buffer pool, the
+	// plan is never expanded as a whole. Chunks are sized from the plan, the scheduler is cancelled once the budget is
+	// gone.
+	auto thread_count = std::max(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+	auto blocks_per_chunk = CalculateBlocksPerTask(block_size, block_ids.size(), thread_count,
+	                                               GetTargetBatchBytes(PREFETCH_CHUNK_SIZE));
+	ExtentScheduler scheduler(block_ids, blocks_per_chunk);
 
-	for (idx_t start_idx = 0; start_idx < total_blocks; start_idx += blocks_per_task) {
-		auto count = std::min<idx_t>(blocks_per_task, total_blocks - start_idx);
-		Span<const block_id_t> block_ids_span(sorted_blocks.data() + start_idx, count);
-		auto task = make_uniq<OSPrefetchTask>(executor, db_path, block_ids_span, block_size, blocks_prefetched);
-		executor.ScheduleTask(std::move(task));
+	atomic<idx_t> budget {effective_max};
+	atomic<idx_t> blocks_resident {0};
+	atomic<idx_t> blocks_prefetched {0};
+	atomic<idx_t> bytes_prefetched {0};
+	atomic<uint64_t> first_load_us {0};
+	auto io_start = std::chrono::steady_clock::now();
+	scheduler.Run(context, static_cast<idx_t>(thread_count), [&](const ExtentChunk &chunk) {
+		auto chunk_start = std::chrono::steady_clock::now();
+		// Blocks in the buffer pool are not read from the file again, whether they are in the page cache or not
+		auto unloaded_handles = GetUnloadedBlockHandles(chunk.first_block, chunk.count);
+		blocks_resident += chunk.count - unloaded_handles.size();
+		vector<block_id_t> chunk_blocks;
+		chunk_blocks.reserve(unloaded_handles.size());
+		for (const auto &handle : unloaded_handles) {
+			chunk_blocks.push_back(handle->BlockId());
+		}
+		unloaded_handles.clear();
+		// Blocks past EOF have nothing to prefetch and do not use up the budget
+		ClipToDatabaseFile(file_size, chunk_blocks);
+		const idx_t granted = ClaimBlocks(budget, chunk_blocks.size());
+		if (budget.load() == 0) {
+			scheduler.Cancel();
+		}
+		chunk_blocks.resize(granted);
+		if (chunk_blocks.empty()) {
+			return;
+		}
+		idx_t chunk_bytes = 0;
+		const idx_t chunk_prefetched = OSPrefetchBlocks(db_path, chunk_blocks, block_size, &chunk_bytes);
+		blocks_prefetched += chunk_prefetched;
+		bytes_prefetched += chunk_bytes;
+		if (chunk_prefetched > 0) {
+			RecordFirstLoad(first_load_us, io_start);
+		}
+		task_timings.Record(chunk_start);
+	});
+	execution_stats.io_us += GetElapsedMicros(io_start);
+	execution_stats.first_load_us += first_load_us;
+
+	// Blocks of cancelled chunks were never registered, they count as over the limit like unclaimed blocks past EOF
+	const idx_t blocks_claimed = effective_max - budget.load();
+	if (budget.load() == 0 && block_ids.size() > blocks_resident + blocks_claimed) {
+		const idx_t blocks_over_limit = block_ids.size() - blocks_resident - blocks_claimed;
+		DUCKDB_LOG_WARNING(context,
+		                   "Maximum blocks to prefetch limit reached.\n"
+		                   "  Table blocks: %llu\n"
+		                   "  Prewarmed: %llu blocks (skipped %llu due to limit)\n"
+		                   "  Memory available to the page cache: %llu bytes (limited by %s)",
+		                   block_ids.size(), effective_max, blocks_over_limit, capacity_info.available_space,
+		                   capacity_info.limited_by);
 	}
-	executor.WorkOnTasks();
 
-	return blocks_prefetched * block_size;
+	// Blocks past EOF, past the limit and blocks whose hint failed were not prefetched
+	execution_stats.blocks_resident += blocks_resident;
+	execution_stats.blocks_skipped += block_ids.size() - blocks_resident - blocks_prefetched;
+	execution_stats.blocks_loaded += blocks_prefetched;
+	execution_stats.bytes_loaded += bytes_prefetched;
+	return bytes_prefetched;
 
 #else
 	// Non-Unix platforms not supported
@@ -0,0 +1,308 @@
+#include "core/prewarm_manifest.hpp"
+
+#include "duckdb/common/checksum.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/helper.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+
+namespace {
+
+constexpr char MANIFEST_MAGIC[] = {'D', 'P', 'W', 'M', 'A', 'N', 'I', 'F'};
+constexpr uint32_t MANIFEST_VERSION = 1;
+constexpr idx_t MANIFEST_HEADER_SIZE = sizeof(MANIFEST_MAGIC) + 2 * sizeof(uint32_t) + 3 * sizeof(uint64_t);
+constexpr idx_t SECTION_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint64_t);
+
+class ManifestWriter {
+public:
+	template <class T>
+	void Write(T value) {
+		auto offset = buffer.size();
+		buffer.resize(offset + sizeof(T));
+		Store<T>(value, buffer.data() + offset);
+	}
+
+	//! LEB128: 7 bits per byte, high bit set on every byte but the last
+	void WriteVarint(uint64_t value) {
+		while (value >= 0x80) {
+			buffer.push_back(static_cast<data_t>(value | 0x80));
+			value >>= 7;
+		}
+		buffer.push_back(static_cast<data_t>(value));
+	}
+
+	void WriteString(const string &value) {
+		WriteVarint(value.size());
+		WriteBytes(value.data(), value.size());
+	}
+
+	void WriteBytes(const void *data, idx_t size) {
+		auto offset = buffer.size();
+		buffer.resize(offset + size);
+		if (size > 0) {
+			memcpy(buffer.data() + offset, data, size);
+		}
+	}
+
+	vector<data_t> buffer;
+};
+
+class ManifestReader {
+public:
+	ManifestReader(const string &path_p, const_data_ptr_t data_p, idx_t size_p)
+	    : path(path_p), data(data_p), size(size_p), offset(0) {
+	}
+
+	template <class T>
+	T Read() {
+		Require(sizeof(T));
+		auto value = Load<T>(data + offset);
+		offset += sizeof(T);
+		return value;
+	}
+
+	uint64_t ReadVarint() {
+		uint64_t value = 0;
+		for (idx_t shift = 0; shift < 64; shift += 7) {
+			Require(1);
+			auto byte = data[offset++];
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) {
+				return value;
+			}
+		}
+		throw InvalidInputException("Prewarm manifest '%s' contains an invalid varint", path);
+	}
+
+	string ReadString() {
+		auto length = ReadVarint();
+		Require(length);
+		string value(const_char_ptr_cast(data + offset), length);
+		offset += length;
+		return value;
+	}
+
+	const_data_ptr_t Skip(idx_t length) {
+		Require(length);
+		auto start = data + offset;
+		offset += length;
+		return start;
+	}
+
+	idx_t Remaining() const {
+		return size - offset;
+	}
+
+	void Require(idx_t length) const {
+		if (Remaining() < length) {
+			throw InvalidInputException("Prewarm manifest '%s' is truncated", path);
+		}
+	}
+
+private:
+	const string &path;
+	const_data_ptr_t data;
+	idx_t size;
+	idx_t offset;
+};
+
+//! Sort and merge overlapping or adjacent ranges, dropping empty ones
+vector<std::pair<idx_t, idx_t>> NormalizeRanges(vector<std::pair<idx_t, idx_t>> ranges) {
+	std::sort(ranges.begin(), ranges.end());
+	vector<std::pair<idx_t, idx_t>> merged;
+	for (const auto &range : ranges) {
+		if (range.second == 0) {
+			continue;
+		}
+		if (!merged.empty() && range.first <= merged.back().first + merged.back().second) {
+			auto end = MaxValue(merged.back().first + merged.back().second, range.first + range.second);
+			merged.back().second = end - merged.back().first;
+			continue;
+		}
+		merged.push_back(range);
+	}
+	return merged;
+}
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Section Views
+//===--------------------------------------------------------------------===//
+
+vector<block_id_t> PrewarmManifestDatabase::DecodeBlockIds() const {
+	ManifestReader reader(database_name, encoded_blocks, encoded_size);
+	vector<block_id_t> block_ids;
+	block_ids.reserve(block_count);
+	uint64_t block_id = 0;
+	for (idx_t idx = 0; idx < block_count; idx++) {
+		block_id += reader.ReadVarint();
+		block_ids.push_back(static_cast<block_id_t>(block_id));
+	}
+	return block_ids;
+}
+
+vector<std::pair<idx_t, idx_t>> PrewarmManifestRemoteFile::DecodeRanges() const {
+	ManifestReader reader(file_path, encoded_ranges, encoded_size);
+	vector<std::pair<idx_t, idx_t>> ranges;
+	ranges.reserve(range_count);
+	idx_t previous_end = 0;
+	for (idx_t idx = 0; idx < range_count; idx++) {
+		auto offset = previous_end + reader.ReadVarint();
+		auto length = reader.ReadVarint();
+		ranges.emplace_back(offset, length);
+		previous_end = offset + length;
+	}
+	return ranges;
+}
+
+//===--------------------------------------------------------------------===//
+// Writer
+//===--------------------------------------------------------------------===//
+
+void PrewarmManifestWriter::AddDatabase(const string &database_name, const string &database_path,
+                                        uint64_t checkpoint_stamp, idx_t block_size, vector<block_id_t> block_ids) {
+	std::sort(block_ids.begin(), block_ids.end());
+	block_ids.erase(std::unique(block_ids.begin(), block_ids.end()), block_ids.end());
+	// Only persistent blocks can be prewarmed, they are never negative
+	block_ids.erase(block_ids.begin(), std::lower_bound(block_ids.begin(), block_ids.end(), 0));
+
+	ManifestWriter body;
+	body.WriteString(database_name);
+	body.WriteString(database_path);
+	body.Write<uint64_t>(checkpoint_stamp);
+	body.Write<uint64_t>(block_size);
+	body.WriteVarint(block_ids.size());
+	uint64_t previous = 0;
+	for (auto block_id : block_ids) {
+		body.WriteVarint(static_cast<uint64_t>(block_id) - previous);
+		previous = static_cast<uint64_t>(block_id);
+	}
+	AddSection(PrewarmManifestSectionKind::DATABASE, body.buffer);
+	entry_count += block_ids.size();
+}
+
+void PrewarmManifestWriter::AddRemoteFile(const string &file_path, idx_t file_size,
+                                          vector<std::pair<idx_t, idx_t>> ranges) {
+	auto merged = NormalizeRanges(std::move(ranges));
+
+	ManifestWriter body;
+	body.WriteString(file_path);
+	body.WriteVarint(file_size);
+	body.WriteVarint(merged.size());
+	idx_t previous_end = 0;
+	for (const auto &range : merged) {
+		body.WriteVarint(range.first - previous_end);
+		body.WriteVarint(range.second);
+		previous_end = range.first + range.second;
+	}
+	AddSection(PrewarmManifestSectionKind::REMOTE_FILE, body.buffer);
+	entry_count += merged.size();
+}
+
+void PrewarmManifestWriter::AddSection(PrewarmManifestSectionKind kind, const vector<data_t> &body) {
+	ManifestWriter section;
+	section.Write<uint32_t>(static_cast<uint32_t>(kind));
+	section.Write<uint64_t>(body.size());
+	payload.insert(payload.end(), section.buffer.begin(), section.buffer.end());
+	payload.insert(payload.end(), body.begin(), body.end());
+	section_count++;
+}
+
+void PrewarmManifestWriter::Write(FileSystem &fs, const string &path) const {
+	ManifestWriter header;
+	header.WriteBytes(MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC));
+	header.Write<uint32_t>(MANIFEST_VERSION);
+	header.Write<uint32_t>(section_count);
+	header.Write<uint64_t>(payload.size());
+	header.Write<uint64_t>(Checksum(const_cast<data_ptr_t>(payload.data()), payload.size()));
+	header.Write<uint64_t>(0);
+	D_ASSERT(header.buffer.size() == MANIFEST_HEADER_SIZE);
+
+	auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_WRITE | FileOpenFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	handle->Write(const_cast<data_ptr_t>(header.buffer.data()), header.buffer.size());
+	if (!payload.empty()) {
+		handle->Write(const_cast<data_ptr_t>(payload.data()), payload.size());
+	}
+	handle->Sync();
+}
+
+//===--------------------------------------------------------------------===//
+// Reader
+//===--------------------------------------------------------------------===//
+
+PrewarmManifestReader::PrewarmManifestReader(FileSystem &fs, const string &path)
+    : file(make_uniq<MappedFile>(fs, path)) {
+	ManifestReader reader(path, file->data(), file->size());
+	reader.Require(sizeof(MANIFEST_MAGIC));
+	if (memcmp(file->data(), MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC)) != 0) {
+		throw InvalidInputException("File '%s' is not a prewarm manifest", path);
+	}
+	reader.Skip(sizeof(MANIFEST_MAGIC));
+	auto version = reader.Read<uint32_t>();
+	if (version != MANIFEST_VERSION) {
+		throw InvalidInputException("Prewarm manifest '%s' has unsupported version %u (expected %u)", path, version,
+		                            MANIFEST_VERSION);
+	}
+	auto section_count = reader.Read<uint32_t>();
+	auto payload_size = reader.Read<uint64_t>();
+	auto checksum = reader.Read<uint64_t>();
+	reader.Read<uint64_t>();
+	if (payload_size != reader.Remaining()) {
+		throw InvalidInputException("Prewarm manifest '%s' is truncated", path);
+	}
+	auto payload = reader.Skip(payload_size);
+	if (Checksum(const_cast<data_ptr_t>(payload), payload_size) != checksum) {
+		throw InvalidInputException("Prewarm manifest '%s' is corrupted: checksum mismatch", path);
+	}
+
+	ManifestReader sections(path, payload, payload_size);
+	for (uint32_t idx = 0; idx < section_count; idx++) {
+		sections.Require(SECTION_HEADER_SIZE);
+		auto kind = sections.Read<uint32_t>();
+		auto body_size = sections.Read<uint64_t>();
+		ManifestReader body(path, sections.Skip(body_size), body_size);
+		switch (static_cast<PrewarmManifestSectionKind>(kind)) {
+		case PrewarmManifestSectionKind::DATABASE: {
+			PrewarmManifestDatabase database;
+			database.database_name = body.ReadString();
+			database.database_path = body.ReadString();
+			database.checkpoint_stamp = body.Read<uint64_t>();
+			database.block_size = body.Read<uint64_t>();
+			database.block_count = body.ReadVarint();
+			database.encoded_size = body.Remaining();
+			database.encoded_blocks = body.Skip(database.encoded_size);
+			// Every block takes at least one byte
+			if (database.block_count > database.encoded_size) {
+				throw InvalidInputException("Prewarm manifest '%s' is truncated", path);
+			}
+			databases.push_back(std::move(database));
+			break;
+		}
+		case PrewarmManifestSectionKind::REMOTE_FILE: {
+			PrewarmManifestRemoteFile remote_file;
+			remote_file.file_path = body.ReadString();
+			remote_file.file_size = body.ReadVarint();
+			remote_file.range_count = body.ReadVarint();
+			remote_file.encoded_size = body.Remaining();
+			remote_file.encoded_ranges = body.Skip(remote_file.encoded_size);
+			if (remote_file.range_count > remote_file.encoded_size / 2) {
+				throw InvalidInputException("Prewarm manifest '%s' is truncated", path);
+			}
+			remote_files.push_back(std::move(remote_file));
+			break;
+		}
+		default:
+			// Unknown sections come from newer writers of the same version, they are safe to skip
+			break;
+		}
+	}
+	if (sections.Remaining() != 0) {
+		throw InvalidInputException("Prewarm manifest '%s' has trailing data after %u sections", path, section_count);
+	}
+}
+
+} // namespace duckdb
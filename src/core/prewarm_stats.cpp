@@ -0,0 +1,275 @@
+#include "core/prewarm_stats.hpp"
+
+#include "core/prewarm_strategy.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+namespace {
+
+//! Exact decimal seconds for a microsecond count
+string FormatSeconds(uint64_t us) {
+	return StringUtil::Format("%llu.%06llu", us / 1000000, us % 1000000);
+}
+
+//! Escape a Prometheus label value
+string EscapeLabel(const string &value) {
+	string escaped;
+	escaped.reserve(value.size());
+	for (char c : value) {
+		switch (c) {
+		case '\\':
+			escaped += "\\\\";
+			break;
+		case '"':
+			escaped += "\\\"";
+			break;
+		case '\n':
+			escaped += "\\n";
+			break;
+		default:
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+string FormatLabels(const PrewarmStatsEntry &entry) {
+	return StringUtil::Format("strategy=\"%s\",database=\"%s\"", EscapeLabel(entry.strategy),
+	                          EscapeLabel(entry.database));
+}
+
+void AppendMetricHeader(string &text, const char *name, const char *type, const char *help) {
+	text += StringUtil::Format("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+void AppendCounter(string &text, const vector<PrewarmStatsEntry> &entries, const char *name, const char *help,
+                   idx_t PrewarmStatsEntry::*counter) {
+	AppendMetricHeader(text, name, "counter", help);
+	for (const auto &entry : entries) {
+		text += StringUtil::Format("%s{%s} %llu\n", name, FormatLabels(entry), entry.*counter);
+	}
+}
+
+void AppendSecondsCounter(string &text, const vector<PrewarmStatsEntry> &entries, const char *name, const char *help,
+                          uint64_t PrewarmStatsEntry::*counter_us) {
+	AppendMetricHeader(text, name, "counter", help);
+	for (const auto &entry : entries) {
+		text += StringUtil::Format("%s{%s} %s\n", name, FormatLabels(entry), FormatSeconds(entry.*counter_us));
+	}
+}
+
+void AppendHistogram(string &text, const vector<PrewarmStatsEntry> &entries, const char *name, const char *help,
+                     LatencyHistogram PrewarmStatsEntry::*histogram_member) {
+	AppendMetricHeader(text, name, "histogram", help);
+	for (const auto &entry : entries) {
+		const auto &histogram = entry.*histogram_member;
+		const auto labels = FormatLabels(entry);
+		idx_t cumulative = 0;
+		for (idx_t bucket = 0; bucket + 1 < LatencyHistogram::BUCKET_COUNT; bucket++) {
+			cumulative += histogram.GetBucketCount(bucket);
+			text += StringUtil::Format("%s_bucket{%s,le=\"%s\"} %llu\n", name, labels,
+			                           FormatSeconds(LatencyHistogram::GetBucketUpperBound(bucket)), cumulative);
+		}
+		text += StringUtil::Format("%s_bucket{%s,le=\"+Inf\"} %llu\n", name, labels, histogram.GetCount());
+		text += StringUtil::Format("%s_sum{%s} %s\n", name, labels, FormatSeconds(histogram.GetSumUs()));
+		text += StringUtil::Format("%s_count{%s} %llu\n", name, labels, histogram.GetCount());
+	}
+}
+
+} // namespace
+
+PrewarmStatsRegistry &PrewarmStatsRegistry::Get() {
+	static PrewarmStatsRegistry registry;
+	return registry;
+}
+
+PrewarmStatsRegistry::~PrewarmStatsRegistry() {
+	StopTextfileWriter();
+}
+
+void PrewarmStatsRegistry::Record(const string &database, uint64_t collection_us, const PrewarmStrategy &strategy) {
+	Record(strategy.GetName(), database, collection_us, strategy.GetExecutionStats(),
+	       strategy.GetTaskTimings().GetDurationsUs());
+}
+
+void PrewarmStatsRegistry::Record(const string &strategy, const string &database, uint64_t collection_us,
+                                  const PrewarmExecutionStats &stats, const vector<uint64_t> &task_durations_us) {
+	lock_guard<mutex> guard(stats_lock);
+	auto &entry = entries[std::make_pair(strategy, database)];
+	if (entry.calls == 0) {
+		entry.strategy = strategy;
+		entry.database = database;
+	}
+	entry.calls++;
+	entry.blocks_planned += stats.blocks_planned;
+	entry.blocks_resident += stats.blocks_resident;
+	entry.blocks_loaded += stats.blocks_loaded;
+	entry.blocks_skipped += stats.blocks_skipped;
+	entry.blocks_throttled += stats.blocks_throttled;
+	entry.bytes_loaded += stats.bytes_loaded;
+	entry.bytes_failed += stats.bytes_failed;
+	entry.collection_us += collection_us;
+	entry.register_us += stats.register_us;
+	entry.sort_us += stats.sort_us;
+	entry.io_us += stats.io_us;
+	entry.first_load_us += stats.first_load_us;
+	entry.call_latency.Add(collection_us + stats.register_us + stats.sort_us + stats.io_us);
+	for (auto duration_us : task_durations_us) {
+		entry.task_latency.Add(duration_us);
+	}
+}
+
+vector<PrewarmStatsEntry> PrewarmStatsRegistry::GetEntries() const {
+	vector<PrewarmStatsEntry> result;
+	lock_guard<mutex> guard(stats_lock);
+	result.reserve(entries.size());
+	for (const auto &entry : entries) {
+		result.push_back(entry.second);
+	}
+	return result;
+}
+
+void PrewarmStatsRegistry::Reset() {
+	lock_guard<mutex> guard(stats_lock);
+	entries.clear();
+}
+
+double PrewarmStatsRegistry::GetThroughput(const string &strategy) const {
+	idx_t bytes_loaded = 0;
+	uint64_t io_us = 0;
+	lock_guard<mutex> guard(stats_lock);
+	for (const auto &entry : entries) {
+		if (entry.second.strategy == strategy) {
+			bytes_loaded += entry.second.bytes_loaded;
+			io_us += entry.second.io_us;
+		}
+	}
+	if (bytes_loaded == 0 || io_us == 0) {
+		return 0;
+	}
+	return static_cast<double>(bytes_loaded) * 1e6 / static_cast<double>(io_us);
+}
+
+string PrewarmStatsRegistry::ToPrometheusText() const {
+	auto snapshot = GetEntries();
+	string text;
+	AppendCounter(text, snapshot, "duckdb_prewarm_calls_total", "Prewarm calls.", &PrewarmStatsEntry::calls);
+	AppendCounter(text, snapshot, "duckdb_prewarm_blocks_planned_total", "Blocks requested by prewarm calls.",
+	              &PrewarmStatsEntry::blocks_planned);
+	AppendCounter(text, snapshot, "duckdb_prewarm_blocks_resident_total",
+	              "Requested blocks that were already resident.", &PrewarmStatsEntry::blocks_resident);
+	AppendCounter(text, snapshot, "duckdb_prewarm_blocks_loaded_total", "Blocks loaded by prewarm calls.",
+	              &PrewarmStatsEntry::blocks_loaded);
+	AppendCounter(text, snapshot, "duckdb_prewarm_blocks_skipped_total",
+	              "Blocks not loaded because of a limit or a failed read.", &PrewarmStatsEntry::blocks_skipped);
+	AppendCounter(text, snapshot, "duckdb_prewarm_blocks_throttled_total",
+	              "Skipped blocks held back because loading them would have evicted.",
+	              &PrewarmStatsEntry::blocks_throttled);
+	AppendCounter(text, snapshot, "duckdb_prewarm_loaded_bytes_total", "Bytes loaded by prewarm calls.",
+	              &PrewarmStatsEntry::bytes_loaded);
+	AppendCounter(text, snapshot, "duckdb_prewarm_failed_bytes_total", "Bytes of blocks whose read failed.",
+	              &PrewarmStatsEntry::bytes_failed);
+	AppendSecondsCounter(text, snapshot, "duckdb_prewarm_collection_seconds_total",
+	                     "Time spent collecting the blocks to prewarm.", &PrewarmStatsEntry::collection_us);
+	AppendSecondsCounter(text, snapshot, "duckdb_prewarm_register_seconds_total",
+	                     "Time spent registering block handles and filtering out resident blocks.",
+	                     &PrewarmStatsEntry::register_us);
+	AppendSecondsCounter(text, snapshot, "duckdb_prewarm_sort_seconds_total",
+	                     "Time spent sorting blocks into I/O order.", &PrewarmStatsEntry::sort_us);
+	AppendSecondsCounter(text, snapshot, "duckdb_prewarm_io_seconds_total", "Time spent loading blocks.",
+	                     &PrewarmStatsEntry::io_us);
+	AppendSecondsCounter(text, snapshot, "duckdb_prewarm_first_load_seconds_total",
+	                     "Time from the start of I/O until the first batch was loaded.",
+	                     &PrewarmStatsEntry::first_load_us);
+	AppendHistogram(text, snapshot, "duckdb_prewarm_call_latency_seconds", "Latency of prewarm calls.",
+	                &PrewarmStatsEntry::call_latency);
+	AppendHistogram(text, snapshot, "duckdb_prewarm_task_latency_seconds", "Latency of prewarm I/O tasks.",
+	                &PrewarmStatsEntry::task_latency);
+	return text;
+}
+
+void PrewarmStatsRegistry::WriteTextfile(FileSystem &fs, const string &path) const {
+	auto text = ToPrometheusText();
+	const auto temp_path = path + ".tmp";
+	{
+		auto handle =
+		    fs.OpenFile(temp_path, FileOpenFlags::FILE_FLAGS_WRITE | FileOpenFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(const_cast<char *>(text.data()), text.size());
+		handle->Sync();
+	}
+	fs.MoveFile(temp_path, path);
+}
+
+void PrewarmStatsRegistry::ConfigureTextfile(FileSystem &fs, const string &path, idx_t interval_ms) {
+	// Connections may configure the file concurrently; only one of them may stop, join and replace the worker
+	lock_guard<mutex> config_guard(textfile_config_lock);
+	StopTextfileWriter();
+	if (path.empty()) {
+		return;
+	}
+	// Fail in the statement that configures the file rather than silently on the background thread. Writing through
+	// the client's file system also checks that the client may write there; a path it may not write is rejected
+	// before the process-wide writer starts.
+	WriteTextfile(fs, path);
+
+	lock_guard<mutex> guard(textfile_lock);
+	textfile_stop = false;
+	textfile_path = path;
+	textfile_interval_ms = MaxValue<idx_t>(interval_ms, 1);
+	textfile_worker = std::thread([this]() { TextfileLoop(); });
+}
+
+void PrewarmStatsRegistry::TextfileLoop() {
+	// The path was checked by the client file system in ConfigureTextfile()
+	auto fs = FileSystem::CreateLocal();
+	unique_lock<mutex> lock(textfile_lock);
+	while (true) {
+		textfile_cv.wait_for(lock, std::chrono::milliseconds(textfile_interval_ms), [this]() { return textfile_stop; });
+		if (textfile_stop) {
+			return;
+		}
+		auto path = textfile_path;
+		lock.unlock();
+		try {
+			WriteTextfile(*fs, path);
+		} catch (std::exception &) {
+			// Keep the last complete file; the next interval tries again
+		}
+		lock.lock();
+	}
+}
+
+void PrewarmStatsRegistry::StopTextfileWriter() {
+	{
+		lock_guard<mutex> guard(textfile_lock);
+		textfile_stop = true;
+		textfile_cv.notify_all();
+	}
+	if (textfile_worker.joinable()) {
+		textfile_worker.join();
+	}
+}
+
+void RecordPrewarmCall(ClientContext &context, const string &database, uint64_t collection_us,
+                       const PrewarmStrategy &strategy) {
+	const auto &stats = strategy.GetExecutionStats();
+	DUCKDB_LOG_INFO(context,
+	                "Prewarm phases (%s, database '%s'):\n"
+	                "  Collect: %llu us\n"
+	                "  Register: %llu us\n"
+	                "  Sort: %llu us\n"
+	                "  I/O: %llu us (%llu tasks, first batch loaded after %llu us)\n"
+	                "  Blocks: %llu planned, %llu resident, %llu loaded, %llu skipped (%llu throttled)",
+	                strategy.GetName(), database, collection_us, stats.register_us, stats.sort_us, stats.io_us,
+	                strategy.GetTaskTimings().GetDurationsUs().size(), stats.first_load_us, stats.blocks_planned,
+	                stats.blocks_resident, stats.blocks_loaded, stats.blocks_skipped, stats.blocks_throttled);
+	PrewarmStatsRegistry::Get().Record(database, collection_us, strategy);
+}
+
+} // namespace duckdb
@@ -1,17 +1,68 @@
 #include "core/prewarm_strategy.hpp"
 
+#include "core/os_prefetch.hpp"
+#include "utils/include/block_offset.hpp"
+
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/helper.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/buffer/block_handle.hpp"
 
+#include <algorithm>
+
 namespace duckdb {
 
-namespace {
-//! Maximum fraction of available (unused) buffer pool memory to use for prewarming.
-//! Applied to remaining memory after subtracting current buffer pool usage (max_memory - used_memory).
-//! The 0.8 ratio leaves 20% headroom for concurrent operations and prevents buffer pool overload.
-//! The 0.8 ratio leaves 20% headroom for concurrent operations and prevents buffer pool overload.
-constexpr double PREWARM_BUFFER_USAGE_RATIO = 0.8;
-} // namespace
+void PrewarmTaskTimings::Record(std::chrono::steady_clock::time_point start) {
+	auto duration_us = GetElapsedMicros(start);
+	lock_guard<mutex> guard(lock);
+	durations_us.push_back(duration_us);
+}
+
+vector<uint64_t> PrewarmTaskTimings::GetDurationsUs() const {
+	lock_guard<mutex> guard(lock);
+	return durations_us;
+}
+
+idx_t PrewarmStrategy::GetTargetBatchBytes(idx_t default_bytes) const {
+	Value batch_bytes;
+	if (context.TryGetCurrentSetting(PREWARM_BATCH_BYTES_SETTING, batch_bytes) && !batch_bytes.IsNull()) {
+		auto configured = batch_bytes.GetValue<uint64_t>();
+		if (configured > 0) {
+			return configured;
+		}
+	}
+	return default_bytes;
+}
+
+idx_t PrewarmStrategy::ClaimBlocks(atomic<idx_t> &budget, idx_t wanted) {
+	auto remaining = budget.load();
+	idx_t granted;
+	do {
+		granted = MinValue(remaining, wanted);
+	} while (granted > 0 && !budget.compare_exchange_weak(remaining, remaining - granted));
+	return granted;
+}
+
+void PrewarmStrategy::RecordFirstLoad(atomic<uint64_t> &first_load_us, std::chrono::steady_clock::time_point io_start) {
+	// 0 means no batch finished yet; a batch finishing within the first microsecond is recorded as 1
+	uint64_t unset = 0;
+	first_load_us.compare_exchange_strong(unset, MaxValue<uint64_t>(GetElapsedMicros(io_start), 1));
+}
+
+PageCacheBudget PrewarmStrategy::GetPageCacheBudget() const {
+	auto memory_info = ReadOSMemoryInfo();
+	auto budget = CalculatePageCacheBudget(memory_info, PREWARM_BUFFER_USAGE_RATIO);
+	if (!budget.source.empty()) {
+		DUCKDB_LOG_DEBUG(context,
+		                 "Page cache budget: %llu of %llu bytes available (%s); MemAvailable %llu, cgroup max %llu, "
+		                 "current %llu, inactive_file %llu",
+		                 budget.budget_bytes, budget.available_bytes, budget.source, memory_info.mem_available,
+		                 memory_info.cgroup_max, memory_info.cgroup_current, memory_info.cgroup_inactive_file);
+	}
+	return budget;
+}
 
 idx_t PrewarmStrategy::CalculateBlocksPerTask(idx_t block_size, idx_t max_blocks, idx_t max_threads,
                                               idx_t target_bytes) {
@@ -50,8 +101,23 @@ BufferCapacityInfo LocalPrewarmStrategy::CalculateMaxAvailableBlocks() {
 	return info;
 }
 
-vector<shared_ptr<BlockHandle>>
-LocalPrewarmStrategy::GetUnloadedBlockHandles(const unordered_set<block_id_t> &block_ids) {
+BufferCapacityInfo LocalPrewarmStrategy::CalculatePageCacheCapacity() {
+	auto budget = GetPageCacheBudget();
+	if (budget.source.empty()) {
+		return LocalPrewarmStrategy::CalculateMaxAvailableBlocks();
+	}
+	BufferCapacityInfo info;
+	info.block_size = block_manager.GetBlockAllocSize();
+	info.max_capacity = budget.available_bytes;
+	info.used_space = 0;
+	info.available_space = budget.available_bytes;
+	info.max_blocks = budget.budget_bytes / info.block_size;
+	info.limited_by = budget.source;
+	return info;
+}
+
+vector<shared_ptr<BlockHandle>> LocalPrewarmStrategy::GetUnloadedBlockHandles(const BlockIdSet &block_ids) {
+	auto register_start = std::chrono::steady_clock::now();
 	vector<shared_ptr<BlockHandle>> unloaded_handles;
 	unloaded_handles.reserve(block_ids.size());
 	for (block_id_t block_id : block_ids) {
@@ -60,8 +126,101 @@ LocalPrewarmStrategy::GetUnloadedBlockHandles(const unordered_set<block_id_t> &b
 			unloaded_handles.emplace_back(std::move(handle));
 		}
 	}
+	execution_stats.register_us += GetElapsedMicros(register_start);
 
 	return unloaded_handles;
 }
 
+vector<shared_ptr<BlockHandle>> LocalPrewarmStrategy::GetUnloadedBlockHandles(block_id_t first_block, idx_t count) {
+	vector<shared_ptr<BlockHandle>> unloaded_handles;
+	unloaded_handles.reserve(count);
+	for (idx_t offset = 0; offset < count; offset++) {
+		auto handle = block_manager.RegisterBlock(first_block + static_cast<block_id_t>(offset));
+		if (handle->GetMemory().IsUnloaded()) {
+			unloaded_handles.emplace_back(std::move(handle));
+		}
+	}
+	return unloaded_handles;
+}
+
+idx_t LocalPrewarmStrategy::CountLoadedBlocks(const vector<shared_ptr<BlockHandle>> &handles) {
+	idx_t loaded = 0;
+	for (const auto &handle : handles) {
+		if (!handle->GetMemory().IsUnloaded()) {
+			loaded++;
+		}
+	}
+	return loaded;
+}
+
+idx_t LocalPrewarmStrategy::GetDatabaseFileSize(AttachedDatabase &database) {
+	return OSGetFileSize(database.GetStorageManager().GetDBPath());
+}
+
+idx_t LocalPrewarmStrategy::GetBlockFileBytes(block_id_t block_id, idx_t file_size) const {
+	return duckdb::GetBlockFileBytes(block_id, block_manager.GetBlockAllocSize(), file_size);
+}
+
+vector<idx_t> LocalPrewarmStrategy::ClipToDatabaseFile(idx_t file_size, vector<block_id_t> &block_ids) const {
+	vector<idx_t> file_bytes;
+	file_bytes.reserve(block_ids.size());
+	idx_t kept = 0;
+	for (idx_t idx = 0; idx < block_ids.size(); idx++) {
+		const idx_t block_bytes = GetBlockFileBytes(block_ids[idx], file_size);
+		if (block_bytes == 0) {
+			continue;
+		}
+		block_ids[kept++] = block_ids[idx];
+		file_bytes.push_back(block_bytes);
+	}
+	block_ids.resize(kept);
+	return file_bytes;
+}
+
+PrewarmPlanSummary LocalPrewarmStrategy::Plan(AttachedDatabase &database, const BlockIdSet &block_ids,
+                                              idx_t max_blocks) {
+	const idx_t file_size = GetDatabaseFileSize(database);
+	auto unloaded_handles = GetUnloadedBlockHandles(block_ids);
+	vector<block_id_t> candidates;
+	candidates.reserve(unloaded_handles.size());
+	for (const auto &handle : unloaded_handles) {
+		candidates.push_back(handle->BlockId());
+	}
+	auto candidate_bytes = ClipToDatabaseFile(file_size, candidates);
+
+	// Resident blocks are counted like loaded ones, by the part of the block within the file
+	idx_t resident_bytes = 0;
+	for (block_id_t block_id : block_ids) {
+		resident_bytes += GetBlockFileBytes(block_id, file_size);
+	}
+	for (idx_t bytes : candidate_bytes) {
+		resident_bytes -= bytes;
+	}
+	return SummarizePlan(block_ids.size(), resident_bytes, candidates, candidate_bytes, max_blocks);
+}
+
+PrewarmPlanSummary LocalPrewarmStrategy::SummarizePlan(idx_t planned_blocks, idx_t resident_bytes,
+                                                       const vector<block_id_t> &candidates,
+                                                       const vector<idx_t> &candidate_bytes, idx_t max_blocks) {
+	D_ASSERT(candidate_bytes.size() == candidates.size());
+	auto capacity_info = CalculateMaxAvailableBlocks();
+	const idx_t effective_max = std::min(capacity_info.max_blocks, max_blocks);
+
+	PrewarmPlanSummary summary;
+	summary.planned_blocks = planned_blocks;
+	summary.resident_bytes = resident_bytes;
+	for (idx_t idx = 0; idx < candidates.size(); idx++) {
+		if (idx >= effective_max) {
+			summary.skipped_bytes += candidate_bytes[idx];
+			continue;
+		}
+		summary.blocks++;
+		summary.bytes += candidate_bytes[idx];
+		if (idx == 0 || candidates[idx] != candidates[idx - 1] + 1) {
+			summary.extents++;
+		}
+	}
+	return summary;
+}
+
 } // namespace duckdb
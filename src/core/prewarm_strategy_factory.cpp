@@ -1,9 +1,11 @@
 #include "core/prewarm_strategy_factory.hpp"
 
 #include "core/buffer_prewarm_strategy.hpp"
+#include "core/pin_prewarm_strategy.hpp"
 #include "core/read_prewarm_strategy.hpp"
 #include "core/prefetch_prewarm_strategy.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
 
 namespace duckdb {
 
@@ -11,6 +13,27 @@ namespace duckdb {
 // Strategy Factory
 //===--------------------------------------------------------------------===//
 
+PrewarmMode ParsePrewarmMode(const Value &mode_val) {
+	if (mode_val.IsNull()) {
+		return PrewarmMode::BUFFER;
+	}
+	auto lower_mode = StringUtil::Lower(mode_val.ToString());
+	if (lower_mode == "prefetch") {
+		return PrewarmMode::PREFETCH;
+	}
+	if (lower_mode == "read") {
+		return PrewarmMode::READ;
+	}
+	if (lower_mode == "buffer") {
+		return PrewarmMode::BUFFER;
+	}
+	if (lower_mode == "pin") {
+		return PrewarmMode::PIN;
+	}
+	throw InvalidInputException("Invalid prewarm mode '%s'. Valid modes are: 'prefetch', 'read', 'buffer', 'pin'",
+	                            mode_val.ToString());
+}
+
 unique_ptr<LocalPrewarmStrategy> CreateLocalPrewarmStrategy(ClientContext &context, PrewarmMode mode,
                                                             BlockManager &block_manager,
                                                             BufferManager &buffer_manager) {
@@ -21,6 +44,8 @@ unique_ptr<LocalPrewarmStrategy> CreateLocalPrewarmStrategy(ClientContext &conte
 		return make_uniq<ReadPrewarmStrategy>(context, block_manager, buffer_manager);
 	case PrewarmMode::PREFETCH:
 		return make_uniq<PrefetchPrewarmStrategy>(context, block_manager, buffer_manager);
+	case PrewarmMode::PIN:
+		return make_uniq<PinPrewarmStrategy>(context, block_manager, buffer_manager);
 	default:
 		throw InternalException("Unknown prewarm mode");
 	}
@@ -0,0 +1,370 @@
+#include "core/query_block_collector.hpp"
+
+#include "core/block_collector.hpp"
+
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/set.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/planner/filter/table_filter.hpp"
+#include "duckdb/planner/logical_operator.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/main/prepared_statement.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
+#include "duckdb/storage/table/row_group.hpp"
+#include "duckdb/storage/table_storage_info.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+namespace {
+
+bool IsParquetScan(const string &function_name) {
+	return function_name == "read_parquet" || function_name == "parquet_scan";
+}
+
+bool IsCsvScan(const string &function_name) {
+	return function_name == "read_csv" || function_name == "read_csv_auto";
+}
+
+//! Whether Parquet column chunk statistics with the given bounds rule out every row for the filter. parquet_metadata()
+//! reports them as text, so only types with numeric statistics (integers, floating point, decimals, dates and
+//! timestamps) are checked; anything that cannot be parsed may match.
+bool ZonemapExcludes(const TableFilter &filter, const LogicalType &type, const string &min_str, const string &max_str) {
+	if (BaseStatistics::GetStatsType(type) != StatisticsType::NUMERIC_STATS) {
+		return false;
+	}
+	Value min_value;
+	Value max_value;
+	if (!Value(min_str).DefaultTryCastAs(type, min_value, nullptr) ||
+	    !Value(max_str).DefaultTryCastAs(type, max_value, nullptr)) {
+		return false;
+	}
+	// Nullness is unknown, keep both possibilities so only the bounds decide
+	auto stats = NumericStats::CreateUnknown(type);
+	NumericStats::SetMin(stats, min_value);
+	NumericStats::SetMax(stats, max_value);
+	return filter.CheckStatistics(stats) == FilterPropagateResult::FILTER_ALWAYS_FALSE;
+}
+
+//! Row groups of a table whose zonemap rules out every row for the filter of one of the columns, by the row group
+//! index ColumnSegmentInfo reports
+unordered_set<idx_t> GetPrunedRowGroups(ClientContext &context, DataTable &storage,
+                                        const unordered_map<idx_t, reference<const TableFilter>> &column_filters) {
+	unordered_set<idx_t> pruned_row_groups;
+	if (column_filters.empty()) {
+		return pruned_row_groups;
+	}
+	auto row_groups = BlockCollector::GetRowGroups(context, storage);
+	for (idx_t row_group_index = 0; row_group_index < row_groups.size(); row_group_index++) {
+		auto &row_group = row_groups[row_group_index].get();
+		for (const auto &entry : column_filters) {
+			auto stats = row_group.GetStatistics(entry.first);
+			if (entry.second.get().CheckStatistics(*stats) == FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+				pruned_row_groups.insert(row_group_index);
+				break;
+			}
+		}
+	}
+	return pruned_row_groups;
+}
+
+//! Size of the Parquet trailer: the 4-byte little-endian footer length and the "PAR1" magic
+constexpr idx_t PARQUET_TRAILER_SIZE = 8;
+
+//! Column name a Parquet column chunk belongs to, "a, b" for nested columns
+string GetTopLevelColumnName(const string &path_in_schema) {
+	auto separator = path_in_schema.find(", ");
+	return separator == string::npos ? path_in_schema : path_in_schema.substr(0, separator);
+}
+
+//! Column chunk of a Parquet file as reported by parquet_metadata()
+struct ParquetColumnChunk {
+	string file_path;
+	idx_t row_group_id;
+	string column_name;
+	idx_t offset;
+	idx_t size;
+	Value stats_min;
+	Value stats_max;
+};
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Query Block Collector Implementation
+//===--------------------------------------------------------------------===//
+
+QueryPrewarmPlan QueryBlockCollector::CollectQueryBlocks(Connection &planner, const string &query) {
+	// Binding and optimizing push projections and filters into the scans; nothing is executed
+	auto logical_plan = planner.context->ExtractPlan(query);
+	QueryPrewarmPlan plan;
+	CollectOperator(planner, *logical_plan, plan);
+	return plan;
+}
+
+vector<std::pair<idx_t, idx_t>> QueryBlockCollector::GetFileRanges(FileHandle &file_handle, idx_t file_size,
+                                                                   const QueryFileRanges &file) {
+	if (file.whole_file) {
+		return {{0, file_size}};
+	}
+	auto ranges = file.ranges;
+	if (!file.include_footer || file_size == 0) {
+		return ranges;
+	}
+	if (file_size >= PARQUET_TRAILER_SIZE) {
+		uint8_t trailer[PARQUET_TRAILER_SIZE];
+		file_handle.Read(trailer, PARQUET_TRAILER_SIZE, file_size - PARQUET_TRAILER_SIZE);
+		const idx_t footer_size = static_cast<idx_t>(trailer[0]) | static_cast<idx_t>(trailer[1]) << 8 |
+		                          static_cast<idx_t>(trailer[2]) << 16 | static_cast<idx_t>(trailer[3]) << 24;
+		if (memcmp(trailer + 4, "PAR1", 4) == 0 && footer_size <= file_size - PARQUET_TRAILER_SIZE) {
+			const idx_t footer_start = file_size - PARQUET_TRAILER_SIZE - footer_size;
+			ranges.emplace_back(footer_start, file_size - footer_start);
+			return ranges;
+		}
+	}
+	ranges.emplace_back(file_size - 1, 1);
+	return ranges;
+}
+
+void QueryBlockCollector::CollectOperator(Connection &planner, LogicalOperator &op, QueryPrewarmPlan &plan) {
+	if (op.type == LogicalOperatorType::LOGICAL_GET) {
+		auto &get = op.Cast<LogicalGet>();
+		auto table = get.GetTable();
+		if (table && table->IsDuckTable()) {
+			CollectTableScan(*planner.context, get, table->Cast<DuckTableEntry>(), plan);
+		} else if (IsParquetScan(get.function.name)) {
+			CollectFileScan(planner, get, /*is_parquet=*/true, plan);
+		} else if (IsCsvScan(get.function.name)) {
+			CollectFileScan(planner, get, /*is_parquet=*/false, plan);
+		} else {
+			DUCKDB_LOG_DEBUG(*planner.context, "prewarm_query: skipping unsupported scan '%s'", get.function.name);
+		}
+	}
+	for (auto &child : op.children) {
+		CollectOperator(planner, *child, plan);
+	}
+}
+
+void QueryBlockCollector::CollectTableScan(ClientContext &context, LogicalGet &get, DuckTableEntry &table,
+                                           QueryPrewarmPlan &plan) {
+	// Scanned columns (projected and filter-only) by storage index, and the filters pushed into them
+	auto &columns = table.GetColumns();
+	unordered_set<idx_t> scanned_columns;
+	unordered_map<idx_t, reference<const TableFilter>> column_filters;
+	const auto &column_ids = get.GetColumnIds();
+	for (idx_t scan_idx = 0; scan_idx < column_ids.size(); scan_idx++) {
+		const auto &column_index = column_ids[scan_idx];
+		if (column_index.IsRowIdColumn() || column_index.GetPrimaryIndex() >= columns.LogicalColumnCount()) {
+			continue;
+		}
+		auto &column = columns.GetColumn(LogicalIndex(column_index.GetPrimaryIndex()));
+		if (column.Generated()) {
+			continue;
+		}
+		const idx_t storage_idx = column.StorageOid();
+		scanned_columns.insert(storage_idx);
+		auto filter_entry = get.table_filters.filters.find(scan_idx);
+		if (filter_entry != get.table_filters.filters.end()) {
+			column_filters.emplace(storage_idx, *filter_entry->second);
+		}
+	}
+	if (scanned_columns.empty()) {
+		return;
+	}
+
+	// A row group is pruned if the zonemap of one of its filtered columns fails the filter
+	auto pruned_row_groups = GetPrunedRowGroups(context, table.GetStorage(), column_filters);
+	// Reads the headers of some compressed segments, as BlockCollector::CollectTableBlocks() does
+	QueryContext query_context(context);
+	auto segment_infos = table.GetColumnSegmentInfo(query_context);
+
+	QueryDatabaseBlocks *database_blocks = nullptr;
+	for (auto &entry : plan.databases) {
+		if (&entry.database.get() == &table.ParentCatalog().GetAttached()) {
+			database_blocks = &entry;
+			break;
+		}
+	}
+	if (!database_blocks) {
+		plan.databases.emplace_back(table.ParentCatalog().GetAttached());
+		database_blocks = &plan.databases.back();
+	}
+
+	auto &block_ids = database_blocks->block_ids;
+	const idx_t blocks_before = block_ids.size();
+	vector<block_id_t> scan_blocks;
+	for (const auto &segment_info : segment_infos) {
+		if (!segment_info.persistent || scanned_columns.find(segment_info.column_id) == scanned_columns.end() ||
+		    pruned_row_groups.find(segment_info.row_group_index) != pruned_row_groups.end()) {
+			continue;
+		}
+		if (segment_info.block_id != INVALID_BLOCK) {
+			scan_blocks.push_back(segment_info.block_id);
+		}
+		for (block_id_t additional_block : segment_info.additional_blocks) {
+			if (additional_block != INVALID_BLOCK) {
+				scan_blocks.push_back(additional_block);
+			}
+		}
+	}
+	block_ids = block_ids.Union(BlockIdSet::FromUnsorted(std::move(scan_blocks)));
+	DUCKDB_LOG_DEBUG(context, "prewarm_query: table '%s' scans %llu columns, %llu row groups pruned, %llu new blocks",
+	                 table.name, scanned_columns.size(), pruned_row_groups.size(), block_ids.size() - blocks_before);
+}
+
+void QueryBlockCollector::CollectFileScan(Connection &planner, LogicalGet &get, bool is_parquet,
+                                          QueryPrewarmPlan &plan) {
+	auto &context = *planner.context;
+	if (get.parameters.empty()) {
+		return;
+	}
+	vector<string> patterns;
+	const auto &files_param = get.parameters[0];
+	if (files_param.type().id() == LogicalTypeId::LIST) {
+		for (const auto &child : ListValue::GetChildren(files_param)) {
+			patterns.emplace_back(child.ToString());
+		}
+	} else {
+		patterns.emplace_back(files_param.ToString());
+	}
+
+	// Only remote files go through the cache_httpfs cache; local files are served by the OS page cache
+	auto &fs = FileSystem::GetFileSystem(context);
+	vector<string> file_paths;
+	for (const auto &pattern : patterns) {
+		for (const auto &file_info : fs.Glob(pattern)) {
+			if (!FileSystem::IsRemoteFile(file_info.path)) {
+				DUCKDB_LOG_DEBUG(context, "prewarm_query: skipping local file '%s'", file_info.path);
+				continue;
+			}
+			file_paths.emplace_back(file_info.path);
+		}
+	}
+	if (file_paths.empty()) {
+		return;
+	}
+
+	if (is_parquet) {
+		CollectParquetRanges(planner, get, file_paths, plan);
+		return;
+	}
+	for (auto &file_path : file_paths) {
+		QueryFileRanges file_ranges;
+		file_ranges.file_path = std::move(file_path);
+		file_ranges.whole_file = true;
+		plan.files.emplace_back(std::move(file_ranges));
+	}
+}
+
+void QueryBlockCollector::CollectParquetRanges(Connection &planner, LogicalGet &get, const vector<string> &file_paths,
+                                               QueryPrewarmPlan &plan) {
+	auto &context = *planner.context;
+
+	// Projected and filtered columns by name, with the filters pushed into them
+	case_insensitive_set_t scanned_columns;
+	case_insensitive_map_t<std::pair<reference<const TableFilter>, LogicalType>> column_filters;
+	const auto &column_ids = get.GetColumnIds();
+	for (idx_t scan_idx = 0; scan_idx < column_ids.size(); scan_idx++) {
+		const auto &column_index = column_ids[scan_idx];
+		const idx_t primary_index = column_index.GetPrimaryIndex();
+		if (column_index.IsRowIdColumn() || primary_index >= get.names.size()) {
+			continue;
+		}
+		scanned_columns.insert(get.names[primary_index]);
+		auto filter_entry = get.table_filters.filters.find(scan_idx);
+		if (filter_entry != get.table_filters.filters.end()) {
+			column_filters.emplace(get.names[primary_index],
+			                       std::make_pair(reference<const TableFilter>(*filter_entry->second),
+			                                      get.returned_types[primary_index]));
+		}
+	}
+
+	vector<Value> paths;
+	paths.reserve(file_paths.size());
+	for (const auto &file_path : file_paths) {
+		paths.emplace_back(file_path);
+	}
+	vector<Value> parameters {Value::LIST(LogicalType::VARCHAR, std::move(paths))};
+	auto statement = planner.Prepare(
+	    "SELECT file_name, row_group_id, path_in_schema, dictionary_page_offset, data_page_offset, "
+	    "total_compressed_size, stats_min_value, stats_max_value FROM parquet_metadata($1::VARCHAR[])");
+	auto result = statement->HasError() ? nullptr : statement->Execute(parameters, /*allow_stream_result=*/false);
+	if (!result || result->HasError()) {
+		// Without column chunk locations, fall back to warming the whole files
+		DUCKDB_LOG_DEBUG(context, "prewarm_query: cannot read Parquet metadata, warming whole files: %s",
+		                 result ? result->GetError() : statement->GetError());
+		for (const auto &file_path : file_paths) {
+			QueryFileRanges file_ranges;
+			file_ranges.file_path = file_path;
+			file_ranges.whole_file = true;
+			plan.files.emplace_back(std::move(file_ranges));
+		}
+		return;
+	}
+	auto &metadata = result->Cast<MaterializedResult>();
+
+	vector<ParquetColumnChunk> chunks;
+	chunks.reserve(metadata.RowCount());
+	set<std::pair<string, idx_t>> pruned_row_groups;
+	for (idx_t row = 0; row < metadata.RowCount(); row++) {
+		ParquetColumnChunk chunk;
+		chunk.file_path = metadata.GetValue(0, row).ToString();
+		chunk.row_group_id = metadata.GetValue(1, row).GetValue<int64_t>();
+		chunk.column_name = GetTopLevelColumnName(metadata.GetValue(2, row).ToString());
+		auto dictionary_offset = metadata.GetValue(3, row);
+		auto data_offset = metadata.GetValue(4, row);
+		auto compressed_size = metadata.GetValue(5, row);
+		if (data_offset.IsNull() || compressed_size.IsNull()) {
+			continue;
+		}
+		chunk.offset = data_offset.GetValue<int64_t>();
+		if (!dictionary_offset.IsNull() && dictionary_offset.GetValue<int64_t>() > 0) {
+			chunk.offset = MinValue<idx_t>(chunk.offset, dictionary_offset.GetValue<int64_t>());
+		}
+		chunk.size = compressed_size.GetValue<int64_t>();
+		chunk.stats_min = metadata.GetValue(6, row);
+		chunk.stats_max = metadata.GetValue(7, row);
+
+		auto filter_entry = column_filters.find(chunk.column_name);
+		if (filter_entry != column_filters.end() && !chunk.stats_min.IsNull() && !chunk.stats_max.IsNull() &&
+		    ZonemapExcludes(filter_entry->second.first.get(), filter_entry->second.second, chunk.stats_min.ToString(),
+		                    chunk.stats_max.ToString())) {
+			pruned_row_groups.emplace(chunk.file_path, chunk.row_group_id);
+		}
+		chunks.emplace_back(std::move(chunk));
+	}
+
+	// Column chunks of the scanned columns in surviving row groups, grouped per file in input order
+	unordered_map<string, idx_t> file_indexes;
+	for (const auto &file_path : file_paths) {
+		file_indexes.emplace(file_path, plan.files.size());
+		QueryFileRanges file_ranges;
+		file_ranges.file_path = file_path;
+		file_ranges.include_footer = true;
+		plan.files.emplace_back(std::move(file_ranges));
+	}
+	idx_t pruned_chunks = 0;
+	for (const auto &chunk : chunks) {
+		auto file_entry = file_indexes.find(chunk.file_path);
+		if (file_entry == file_indexes.end() || scanned_columns.find(chunk.column_name) == scanned_columns.end()) {
+			continue;
+		}
+		if (pruned_row_groups.find(std::make_pair(chunk.file_path, chunk.row_group_id)) != pruned_row_groups.end()) {
+			pruned_chunks++;
+			continue;
+		}
+		plan.files[file_entry->second].ranges.emplace_back(chunk.offset, chunk.size);
+	}
+	DUCKDB_LOG_DEBUG(context, "prewarm_query: %llu Parquet files, %llu row groups pruned, %llu column chunks skipped",
+	                 file_paths.size(), pruned_row_groups.size(), pruned_chunks);
+}
+
+} // namespace duckdb
@@ -1,11 +1,12 @@
 #include "core/read_prewarm_strategy.hpp"
 
+#include "core/extent_scheduler.hpp"
+
 #include "duckdb/common/atomic.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/storage/buffer/block_handle.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/logging/logger.hpp"
-#include "duckdb/parallel/task_executor.hpp"
 #include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/storage/storage_info.hpp"
 #include <algorithm>
@@ -17,121 +18,130 @@ namespace {
 // Target ~512KiB per read batch to align with page cache granularity while limiting temp buffer usage.
 constexpr idx_t READ_PREFETCH_TARGET_BYTES = Storage::SECTOR_SIZE * 128;
 
-class ReadBlockGroupTask : public BaseExecutorTask {
-public:
-	ReadBlockGroupTask(TaskExecutor &executor, ClientContext &context_p, BlockManager &block_manager_p,
-	                   BufferManager &buffer_manager_p, block_id_t first_block_id_p, idx_t block_count_p,
-	                   atomic<idx_t> &blocks_read_p)
-	    : BaseExecutorTask(executor), block_manager(block_manager_p), buffer_manager(buffer_manager_p),
-	      context(context_p), first_block_id(first_block_id_p), block_count(block_count_p), blocks_read(blocks_read_p) {
-	}
-
-	void ExecuteTask() override {
-		try {
-			auto block_size = block_manager.GetBlockAllocSize();
-			auto total_size = block_count * block_size;
-			auto temp_buffer = buffer_manager.Allocate(MemoryTag::BASE_TABLE, total_size, true);
-			block_manager.ReadBlocks(temp_buffer.GetFileBuffer(), first_block_id, block_count);
-			blocks_read += block_count;
-		} catch (const IOException &e) {
-			// TODO: the SingleFileBlockManager::ReadBlock sometimes throws file out-of-bounds exception, we have to do
-			// further investigation and fix it.
-			// https://github.com/dentiny/duckdb-cache-prewarm/issues/23
-			DUCKDB_LOG_WARNING(context, "READ prewarm failed for block %lld (count %llu): %s",
-			                   static_cast<int64_t>(first_block_id), static_cast<uint64_t>(block_count), e.what());
-		}
+//! Read a run of consecutive blocks into a temporary buffer, which leaves them in the OS page cache
+//! @return false if the read failed
+bool ReadBlockGroup(ClientContext &context, BlockManager &block_manager, BufferManager &buffer_manager,
+                    block_id_t first_block_id, idx_t block_count) {
+	try {
+		auto block_size = block_manager.GetBlockAllocSize();
+		auto total_size = block_count * block_size;
+		auto temp_buffer = buffer_manager.Allocate(MemoryTag::BASE_TABLE, total_size, true);
+		block_manager.ReadBlocks(temp_buffer.GetFileBuffer(), first_block_id, block_count);
+		return true;
+	} catch (const IOException &e) {
+		// TODO: the SingleFileBlockManager::ReadBlock sometimes throws file out-of-bounds exception, we have to do
+		// further investigation and fix it.
+		// https://github.com/dentiny/duckdb-cache-prewarm/issues/23
+		DUCKDB_LOG_WARNING(context, "READ prewarm failed for block %lld (count %llu): %s",
+		                   static_cast<int64_t>(first_block_id), static_cast<uint64_t>(block_count), e.what());
+		return false;
 	}
-
-	string TaskType() const override {
-		return "ReadBlockGroupTask";
-	}
-
-private:
-	BlockManager &block_manager;
-	BufferManager &buffer_manager;
-	ClientContext &context;
-	block_id_t first_block_id;
-	idx_t block_count;
-	atomic<idx_t> &blocks_read;
-};
+}
 
 } // namespace
 
-idx_t ReadPrewarmStrategy::Execute(DuckTableEntry &table_entry, const unordered_set<block_id_t> &block_ids,
-                                   idx_t max_blocks) {
+PrewarmPlanSummary ReadPrewarmStrategy::Plan(AttachedDatabase &database, const BlockIdSet &block_ids,
+                                             idx_t max_blocks) {
 	CheckDirectIO("READ");
+	return LocalPrewarmStrategy::Plan(database, block_ids, max_blocks);
+}
 
-	auto unloaded_handles = GetUnloadedBlockHandles(block_ids);
-	if (unloaded_handles.empty()) {
+idx_t ReadPrewarmStrategy::Execute(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) {
+	CheckDirectIO("READ");
+	execution_stats.blocks_planned += block_ids.size();
+	if (block_ids.empty()) {
 		return 0;
 	}
 
-	idx_t blocks_read = 0;
 	auto block_size = block_manager.GetBlockAllocSize();
-
 	auto capacity_info = CalculateMaxAvailableBlocks();
 	idx_t effective_max = std::min(capacity_info.max_blocks, max_blocks);
-	idx_t total_blocks = unloaded_handles.size();
-	idx_t max_batch_size = effective_max;
-	if (max_batch_size == 0) {
+	if (effective_max == 0) {
 		DUCKDB_LOG_WARNING(context,
 		                   "Insufficient memory to prewarm any blocks (available: %llu bytes, block size: %llu bytes)",
 		                   capacity_info.available_space, capacity_info.block_size);
+		execution_stats.blocks_skipped += block_ids.size();
 		return 0;
 	}
-	if (total_blocks > effective_max) {
-		idx_t blocks_skipped = total_blocks - effective_max;
-		unloaded_handles.resize(effective_max);
-
-		DUCKDB_LOG_WARNING(context,
-		                   "Maximum blocks to read limit reached.\n"
-		                   "  Table blocks: %llu\n"
-		                   "  Prewarming: %llu blocks (skipping %llu due to limit)\n"
-		                   "  Current available memory: %llu bytes, consider increasing memory_limit",
-		                   total_blocks, effective_max, blocks_skipped, capacity_info.available_space);
-		total_blocks = unloaded_handles.size();
-	}
-
-	// Sort unloaded block IDs for sequential reading
-	std::sort(
-	    unloaded_handles.begin(), unloaded_handles.end(),
-	    [](const shared_ptr<BlockHandle> &a, const shared_ptr<BlockHandle> &b) { return a->BlockId() < b->BlockId(); });
 
+	// Every task registers the chunk it claimed, filters out resident blocks and reads the rest right away, so the
+	// first blocks are read before the last ones are registered and at most one chunk per task is in flight. Chunks
+	// are sized from the plan, the scheduler is cancelled once the budget is gone.
 	auto thread_count = std::max(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
-	auto blocks_per_task = CalculateBlocksPerTask(block_size, max_batch_size, thread_count, READ_PREFETCH_TARGET_BYTES);
-	if (blocks_per_task == 0) {
-		return 0;
-	}
-
-	TaskExecutor executor(context);
-	atomic<idx_t> parallel_blocks_read {0};
-
-	// Read blocks in batches where possible
-	for (size_t i = 0; i < unloaded_handles.size();) {
-		block_id_t first_block_id = unloaded_handles[i]->BlockId();
-		idx_t block_count = 1;
-
-		// Find consecutive blocks and limit the batch size to prevent memory overflow
-		while (i + block_count < unloaded_handles.size() &&
-		       unloaded_handles[i + block_count]->BlockId() == first_block_id + block_count &&
-		       block_count < max_batch_size) {
-			block_count++;
+	auto blocks_per_chunk = CalculateBlocksPerTask(block_size, block_ids.size(), thread_count,
+	                                               GetTargetBatchBytes(READ_PREFETCH_TARGET_BYTES));
+	ExtentScheduler scheduler(block_ids, blocks_per_chunk);
+	const idx_t file_size = GetDatabaseFileSize(database);
+
+	atomic<idx_t> budget {effective_max};
+	atomic<idx_t> blocks_resident {0};
+	atomic<idx_t> blocks_read {0};
+	atomic<idx_t> bytes_read {0};
+	atomic<uint64_t> first_load_us {0};
+	auto io_start = std::chrono::steady_clock::now();
+	scheduler.Run(context, static_cast<idx_t>(thread_count), [&](const ExtentChunk &chunk) {
+		auto chunk_start = std::chrono::steady_clock::now();
+		auto unloaded_handles = GetUnloadedBlockHandles(chunk.first_block, chunk.count);
+		blocks_resident += chunk.count - unloaded_handles.size();
+		vector<block_id_t> read_blocks;
+		read_blocks.reserve(unloaded_handles.size());
+		for (const auto &handle : unloaded_handles) {
+			read_blocks.push_back(handle->BlockId());
+		}
+		unloaded_handles.clear();
+		// Blocks past EOF cannot be read and do not use up the budget
+		auto file_bytes = ClipToDatabaseFile(file_size, read_blocks);
+		const idx_t granted = ClaimBlocks(budget, read_blocks.size());
+		if (budget.load() == 0) {
+			scheduler.Cancel();
+		}
+		read_blocks.resize(granted);
+		if (read_blocks.empty()) {
+			return;
 		}
 
-		for (idx_t offset = 0; offset < block_count; offset += blocks_per_task) {
-			auto task_block_count = std::min<idx_t>(blocks_per_task, block_count - offset);
-			auto task_first_block_id = first_block_id + static_cast<block_id_t>(offset);
-			auto task = make_uniq<ReadBlockGroupTask>(executor, context, block_manager, buffer_manager,
-			                                          task_first_block_id, task_block_count, parallel_blocks_read);
-			executor.ScheduleTask(std::move(task));
+		// Resident blocks split the chunk into runs of consecutive blocks, each run is one sequential read
+		idx_t run_start = 0;
+		while (run_start < read_blocks.size()) {
+			idx_t run_end = run_start + 1;
+			while (run_end < read_blocks.size() && read_blocks[run_end] == read_blocks[run_end - 1] + 1) {
+				run_end++;
+			}
+			if (ReadBlockGroup(context, block_manager, buffer_manager, read_blocks[run_start], run_end - run_start)) {
+				idx_t run_bytes = 0;
+				for (idx_t idx = run_start; idx < run_end; idx++) {
+					run_bytes += file_bytes[idx];
+				}
+				blocks_read += run_end - run_start;
+				bytes_read += run_bytes;
+				RecordFirstLoad(first_load_us, io_start);
+			}
+			run_start = run_end;
 		}
-		i += block_count;
+		task_timings.Record(chunk_start);
+	});
+	execution_stats.io_us += GetElapsedMicros(io_start);
+	execution_stats.first_load_us += first_load_us;
+
+	// Blocks of cancelled chunks were never registered, they count as over the limit like unclaimed blocks past EOF
+	const idx_t blocks_claimed = effective_max - budget.load();
+	if (budget.load() == 0 && block_ids.size() > blocks_resident + blocks_claimed) {
+		const idx_t blocks_over_limit = block_ids.size() - blocks_resident - blocks_claimed;
+		DUCKDB_LOG_WARNING(context,
+		                   "Maximum blocks to read limit reached.\n"
+		                   "  Table blocks: %llu\n"
+		                   "  Prewarmed: %llu blocks (skipped %llu due to limit)\n"
+		                   "  Memory available to the page cache: %llu bytes (limited by %s)",
+		                   block_ids.size(), effective_max, blocks_over_limit, capacity_info.available_space,
+		                   capacity_info.limited_by);
 	}
 
-	executor.WorkOnTasks();
-	blocks_read = parallel_blocks_read;
-
-	return blocks_read * block_size;
+	// Blocks past EOF, past the limit and blocks of failed reads were not loaded
+	execution_stats.blocks_resident += blocks_resident;
+	execution_stats.blocks_skipped += block_ids.size() - blocks_resident - blocks_read;
+	execution_stats.blocks_loaded += blocks_read;
+	execution_stats.bytes_loaded += bytes_read;
+	return bytes_read;
 }
 
 } // namespace duckdb
@@ -1,20 +1,92 @@
 #include "core/remote_block_collector.hpp"
 
-#include "chunk_utils.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/limits.hpp"
+
+#include <algorithm>
 
 namespace duckdb {
 
+RemoteBlockRef RemoteBlockRef::Create(const string &file_path, idx_t file_index, idx_t block_index) {
+	if (file_index > NumericLimits<uint32_t>::Maximum()) {
+		throw InvalidInputException("Too many files to prewarm in a single call (limit %llu)",
+		                            static_cast<uint64_t>(NumericLimits<uint32_t>::Maximum()));
+	}
+	if (block_index > NumericLimits<uint32_t>::Maximum()) {
+		throw InvalidInputException("Remote file '%s' has too many blocks to prewarm, increase the cache block size",
+		                            file_path);
+	}
+	return RemoteBlockRef(static_cast<uint32_t>(file_index), static_cast<uint32_t>(block_index));
+}
+
+//===--------------------------------------------------------------------===//
+// Remote Block Plan Implementation
+//===--------------------------------------------------------------------===//
+
+idx_t RemoteBlockPlan::AddFileDescriptor(string file_path, idx_t file_size) {
+	if (files.size() >= NumericLimits<uint32_t>::Maximum()) {
+		throw InvalidInputException("Too many files to prewarm in a single call (limit %llu)",
+		                            static_cast<uint64_t>(NumericLimits<uint32_t>::Maximum()));
+	}
+	file_block_starts.emplace_back(blocks.size());
+	files.emplace_back(std::move(file_path), file_size);
+	return files.size() - 1;
+}
+
+idx_t RemoteBlockPlan::AddFile(string file_path, idx_t file_size) {
+	auto file_index = AddFileDescriptor(std::move(file_path), file_size);
+	auto block_count = files.back().GetBlockCount(block_size);
+	blocks.reserve(blocks.size() + block_count);
+	for (idx_t block_index = 0; block_index < block_count; block_index++) {
+		AddBlock(file_index, block_index);
+	}
+	return file_index;
+}
+
+idx_t RemoteBlockPlan::AddFileRanges(string file_path, idx_t file_size, vector<std::pair<idx_t, idx_t>> ranges) {
+	auto file_index = AddFileDescriptor(std::move(file_path), file_size);
+	std::sort(ranges.begin(), ranges.end());
+	// Next block index not yet added, ranges are sorted so blocks come out ascending and deduplicated
+	idx_t next_block = 0;
+	for (const auto &range : ranges) {
+		if (range.second == 0 || range.first >= file_size) {
+			continue;
+		}
+		const idx_t range_end = MinValue<idx_t>(range.first + range.second, file_size);
+		const idx_t first_block = MaxValue<idx_t>(range.first / block_size, next_block);
+		const idx_t last_block = (range_end - 1) / block_size;
+		for (idx_t block_index = first_block; block_index <= last_block; block_index++) {
+			AddBlock(file_index, block_index);
+		}
+		next_block = MaxValue<idx_t>(next_block, last_block + 1);
+	}
+	return file_index;
+}
+
+void RemoteBlockPlan::AddBlock(idx_t file_index, idx_t block_index) {
+	if (file_index + 1 != files.size()) {
+		throw InternalException("Remote blocks must be added to the most recently added file");
+	}
+	blocks.push_back(RemoteBlockRef::Create(files[file_index].file_path, file_index, block_index));
+}
+
+Span<const RemoteBlockRef> RemoteBlockPlan::GetFileBlocks(idx_t file_index) const {
+	D_ASSERT(file_index < files.size());
+	const idx_t start = file_block_starts[file_index];
+	const idx_t end = file_index + 1 < files.size() ? file_block_starts[file_index + 1] : blocks.size();
+	return Span<const RemoteBlockRef>(blocks.data() + start, end - start);
+}
+
 //===--------------------------------------------------------------------===//
 // Remote Block Collector Implementation
 //===--------------------------------------------------------------------===//
 
-RemoteFileBlockMap RemoteBlockCollector::CollectRemoteBlocks(FileSystem &fs, const string &pattern, idx_t block_size) {
-	RemoteFileBlockMap file_blocks;
+RemoteBlockPlan RemoteBlockCollector::CollectRemoteBlocks(FileSystem &fs, const string &pattern, idx_t block_size) {
+	RemoteBlockPlan plan(block_size);
 	auto glob_results = fs.Glob(pattern);
 	if (glob_results.empty()) {
-		return file_blocks;
+		return plan;
 	}
 
 	// Process each file
@@ -31,26 +103,11 @@ RemoteFileBlockMap RemoteBlockCollector::CollectRemoteBlocks(FileSystem &fs, con
 			continue;
 		}
 
-		// Divide file into blocks
-		const ReadRequestParams read_params {
-		    .requested_start_offset = 0,
-		    .requested_bytes_to_read = file_size,
-		    .block_size = block_size,
-		};
-		const ChunkAlignmentInfo alignment_info = CalculateChunkAlignment(read_params);
-		vector<RemoteBlockInfo> blocks;
-		blocks.reserve(alignment_info.subrequest_count);
-
-		for (idx_t i = 0; i < alignment_info.subrequest_count; i++) {
-			idx_t offset = alignment_info.aligned_start_offset + i * block_size;
-			idx_t actual_size = std::min(block_size, file_size - offset);
-			blocks.emplace_back(file_info.path, offset, static_cast<int64_t>(actual_size), file_size);
-		}
-
-		file_blocks[file_info.path] = std::move(blocks);
+		// Divide file into blocks, offsets and sizes are derived from the block index
+		plan.AddFile(file_info.path, file_size);
 	}
 
-	return file_blocks;
+	return plan;
 }
 
 } // namespace duckdb
@@ -0,0 +1,247 @@
+#include "core/remote_fetch_pipeline.hpp"
+
+#include "core/prewarm_strategy.hpp"
+#include "thread_pool.hpp"
+
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+
+namespace duckdb {
+
+RemoteFetchErrorKind ClassifyRemoteFetchError(const ErrorData &error) {
+	switch (error.Type()) {
+	case ExceptionType::INTERRUPT:
+	case ExceptionType::INTERNAL:
+	case ExceptionType::FATAL:
+	case ExceptionType::OUT_OF_MEMORY:
+		return RemoteFetchErrorKind::FATAL;
+	case ExceptionType::IO:
+	case ExceptionType::CONNECTION:
+		return RemoteFetchErrorKind::TRANSIENT;
+	case ExceptionType::HTTP: {
+		const auto &extra_info = error.ExtraInfo();
+		auto status_entry = extra_info.find("status_code");
+		if (status_entry == extra_info.end()) {
+			return RemoteFetchErrorKind::TRANSIENT;
+		}
+		const auto status_code = std::atoi(status_entry->second.c_str());
+		// Timeouts, throttling and server-side errors may go away, other client errors will not.
+		if (status_code == 408 || status_code == 425 || status_code == 429 || status_code >= 500 ||
+		    status_code < 400) {
+			return RemoteFetchErrorKind::TRANSIENT;
+		}
+		return RemoteFetchErrorKind::PERMANENT;
+	}
+	default:
+		return RemoteFetchErrorKind::PERMANENT;
+	}
+}
+
+RemoteFetchPipeline::RemoteFetchPipeline(idx_t worker_count, idx_t queue_capacity, idx_t max_open_files_p,
+                                         RemoteRetryPolicy retry_policy_p, PrewarmTaskTimings *timings_p)
+    : queue(queue_capacity), retry_policy(retry_policy_p), timings(timings_p), bytes_fetched(0), blocks_fetched(0),
+      bytes_failed(0), blocks_failed(0), retries(0), finished(false),
+      max_open_files(MaxValue<idx_t>(max_open_files_p, 1)), open_files(0), aborted(false) {
+	worker_count = MaxValue<idx_t>(worker_count, 1);
+	thread_pool = make_uniq<ThreadPool>(worker_count);
+	worker_futures.reserve(worker_count);
+	for (idx_t idx = 0; idx < worker_count; idx++) {
+		worker_futures.emplace_back(thread_pool->Push([this]() { WorkerLoop(); }));
+	}
+}
+
+RemoteFetchPipeline::~RemoteFetchPipeline() {
+	if (finished) {
+		return;
+	}
+	// The planner bailed out (e.g. an exception while listing); let the workers drain and exit before the queue goes
+	// away.
+	queue.Close();
+	for (auto &future : worker_futures) {
+		if (future.valid()) {
+			future.wait();
+		}
+	}
+}
+
+shared_ptr<RemoteOpenFile> RemoteFetchPipeline::OpenFile(FileSystem &fs, const string &file_path) {
+	{
+		unique_lock<mutex> lock(file_slot_mu);
+		file_slot_cv.wait(lock, [this]() { return aborted || open_files < max_open_files; });
+		if (aborted) {
+			return nullptr;
+		}
+		open_files++;
+	}
+
+	unique_ptr<FileHandle> handle;
+	try {
+		handle = fs.OpenFile(file_path, FileOpenFlags::FILE_FLAGS_READ | FileOpenFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+	} catch (...) {
+		lock_guard<mutex> lock(file_slot_mu);
+		open_files--;
+		file_slot_cv.notify_one();
+		throw;
+	}
+	if (!handle) {
+		lock_guard<mutex> lock(file_slot_mu);
+		open_files--;
+		file_slot_cv.notify_one();
+		return nullptr;
+	}
+
+	auto file = make_shared_ptr<RemoteOpenFile>();
+	file->handle = std::move(handle);
+	// The planner's reference keeps the file open until all of its blocks have been submitted.
+	file->pending_blocks = 1;
+	return file;
+}
+
+bool RemoteFetchPipeline::Submit(RemoteFetchWork work) {
+	auto &file = *work.file;
+	file.pending_blocks++;
+	if (!queue.Push(std::move(work))) {
+		ReleaseFile(file, 1);
+		return false;
+	}
+	return true;
+}
+
+void RemoteFetchPipeline::FinishFile(RemoteOpenFile &file) {
+	ReleaseFile(file, 1);
+}
+
+void RemoteFetchPipeline::ReleaseFile(RemoteOpenFile &file, idx_t count) {
+	if (file.pending_blocks.fetch_sub(count) != count) {
+		return;
+	}
+	// Last reference gone: nobody else touches the handle anymore.
+	file.handle.reset();
+	lock_guard<mutex> lock(file_slot_mu);
+	open_files--;
+	file_slot_cv.notify_one();
+}
+
+idx_t RemoteFetchPipeline::GetOpenFileCount() const {
+	lock_guard<mutex> lock(file_slot_mu);
+	return open_files;
+}
+
+bool RemoteFetchPipeline::IsAborted() const {
+	lock_guard<mutex> lock(file_slot_mu);
+	return aborted;
+}
+
+void RemoteFetchPipeline::Abort() {
+	queue.Close();
+	lock_guard<mutex> lock(file_slot_mu);
+	aborted = true;
+	file_slot_cv.notify_all();
+}
+
+RemotePrewarmResult RemoteFetchPipeline::Finish() {
+	queue.Close();
+	finished = true;
+
+	// Wait for every worker before rethrowing, so no worker outlives the pipeline.
+	std::exception_ptr first_error;
+	for (auto &future : worker_futures) {
+		try {
+			future.get();
+		} catch (...) {
+			if (!first_error) {
+				first_error = std::current_exception();
+			}
+		}
+	}
+	worker_futures.clear();
+	if (first_error) {
+		std::rethrow_exception(first_error);
+	}
+
+	RemotePrewarmResult result;
+	result.bytes_fetched = bytes_fetched.load();
+	result.blocks_fetched = blocks_fetched.load();
+	result.bytes_failed = bytes_failed.load();
+	result.blocks_failed = blocks_failed.load();
+	result.retries = retries.load();
+	return result;
+}
+
+string RemoteFetchPipeline::GetFirstFailure() const {
+	lock_guard<mutex> lock(file_slot_mu);
+	return first_failure;
+}
+
+bool RemoteFetchPipeline::FetchWithRetry(RemoteFetchWork &work, char *buffer) {
+	idx_t backoff_ms = retry_policy.initial_backoff_ms;
+	for (idx_t attempt = 1;; attempt++) {
+		try {
+			work.file->handle->Read(buffer, work.size, work.offset);
+			return true;
+		} catch (std::exception &ex) {
+			ErrorData error(ex);
+			auto kind = ClassifyRemoteFetchError(error);
+			if (kind == RemoteFetchErrorKind::FATAL) {
+				throw;
+			}
+			if (kind == RemoteFetchErrorKind::PERMANENT || attempt >= retry_policy.max_attempts) {
+				lock_guard<mutex> lock(file_slot_mu);
+				if (first_failure.empty()) {
+					first_failure = StringUtil::Format("%s (offset %llu, %llu bytes): %s", work.file->handle->path,
+					                                   work.offset, work.size, error.RawMessage());
+				}
+				return false;
+			}
+		}
+		retries++;
+		if (backoff_ms > 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(backoff_ms));
+		}
+		backoff_ms = MinValue<idx_t>(backoff_ms * 2, retry_policy.max_backoff_ms);
+	}
+}
+
+void RemoteFetchPipeline::WorkerLoop() {
+	// Each worker reuses a single buffer across reads; we only care about the on-disk cache side effect.
+	unique_ptr<char[]> buffer;
+	idx_t buffer_size = 0;
+	RemoteFetchWork work;
+	while (queue.Pop(work)) {
+		if (work.size > buffer_size) {
+			buffer = unique_ptr<char[]>(new char[work.size]);
+			buffer_size = work.size;
+		}
+		auto fetch_start = std::chrono::steady_clock::now();
+		bool fetched;
+		try {
+			fetched = FetchWithRetry(work, buffer.get());
+		} catch (...) {
+			ReleaseFile(*work.file, 1);
+			// Stop accepting new work so the planner does not block on a queue that may never be drained.
+			Abort();
+			throw;
+		}
+		if (timings) {
+			timings->Record(fetch_start);
+		}
+		// Only count a block once its read has actually completed
+		if (fetched) {
+			bytes_fetched += work.size;
+			blocks_fetched++;
+		} else {
+			bytes_failed += work.size;
+			blocks_failed++;
+		}
+		ReleaseFile(*work.file, 1);
+		work.file.reset();
+	}
+}
+
+} // namespace duckdb
@@ -3,23 +3,30 @@
 #include "core/prewarm_strategy.hpp"
 #include "cache_httpfs_instance_state.hpp"
 #include "cache_filesystem_config.hpp"
-#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/logging/logger.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/parallel/task_scheduler.hpp"
 #include "thread_pool.hpp"
-#include <future>
 
 namespace duckdb {
 
+namespace {
+
+//! Upper bound of concurrent fetch workers when cache_httpfs does not cap subrequests.
+constexpr idx_t REMOTE_PREWARM_MAX_FETCH_WORKERS = 64;
+//! Number of queued blocks per fetch worker, deep enough to hide planning latency between files.
+constexpr idx_t REMOTE_PREWARM_QUEUE_DEPTH_PER_WORKER = 4;
+
+} // namespace
+
 RemotePrewarmStrategy::RemotePrewarmStrategy(ClientContext &context_p, FileSystem &fs_p)
     : PrewarmStrategy(context_p), context(context_p), fs(fs_p) {
 }
 
-vector<RemoteBlockInfo> RemotePrewarmStrategy::FilterCachedBlocks(const string &file_path,
-                                                                  const vector<RemoteBlockInfo> &blocks) {
+vector<RemoteBlockRef> RemotePrewarmStrategy::FilterCachedBlocks(const RemoteFileDescriptor &file, idx_t block_size,
+                                                                 Span<const RemoteBlockRef> blocks) {
 	// TODO: implement a API to do this filtering at cache_httpfs side
-	return blocks;
+	return vector<RemoteBlockRef>(blocks.begin(), blocks.end());
 }
 
 BufferCapacityInfo RemotePrewarmStrategy::CalculateMaxAvailableBlocks() {
@@ -33,87 +40,251 @@ BufferCapacityInfo RemotePrewarmStrategy::CalculateMaxAvailableBlocks() {
 	};
 }
 
-idx_t RemotePrewarmStrategy::Execute(const RemoteFileBlockMap &file_blocks, idx_t max_blocks) {
-	if (file_blocks.empty()) {
-		return 0;
+idx_t RemotePrewarmStrategy::GetFetchWorkerCount(idx_t block_count) const {
+	const CacheHttpfsInstanceState &instance_state = GetInstanceStateOrThrow(context);
+	block_count = std::min<idx_t>(block_count, REMOTE_PREWARM_MAX_FETCH_WORKERS);
+	const auto worker_count = GetThreadCountForSubrequests(block_count, instance_state.config.max_subrequest_count);
+	return std::max<idx_t>(1, static_cast<idx_t>(worker_count));
+}
+
+idx_t RemotePrewarmStrategy::GetMaxOpenFiles() const {
+	Value max_open_files;
+	if (context.TryGetCurrentSetting(PREWARM_REMOTE_MAX_OPEN_FILES_SETTING, max_open_files) &&
+	    !max_open_files.IsNull()) {
+		return std::max<idx_t>(1, max_open_files.GetValue<uint64_t>());
 	}
+	return DEFAULT_PREWARM_REMOTE_MAX_OPEN_FILES;
+}
 
-	idx_t total_blocks = 0, total_uncached_blocks = 0;
-	RemoteFileBlockMap uncached_file_blocks;
-	uncached_file_blocks.reserve(file_blocks.size());
-	// map from file_path to file_handle
-	unordered_map<string, unique_ptr<FileHandle>> file_handles;
-	file_handles.reserve(file_blocks.size());
-	for (const auto &blocks : file_blocks) {
-		const auto &file_path = blocks.first;
-		const auto &block_list = blocks.second;
-
-		total_blocks += block_list.size();
-		auto uncached_blocks = FilterCachedBlocks(file_path, block_list);
-		total_uncached_blocks += uncached_blocks.size();
-		if (uncached_blocks.empty()) {
-			// TODO: add a debug logging that we skipped file
-			continue;
+bool RemotePrewarmStrategy::SubmitFileBlocks(RemoteFetchPipeline &pipeline, shared_ptr<RemoteOpenFile> open_file,
+                                             const RemoteFileDescriptor &file, idx_t block_size,
+                                             Span<const RemoteBlockRef> blocks, idx_t block_budget,
+                                             RemotePrewarmProgress &progress) {
+	progress.total_blocks += blocks.size();
+	auto uncached_blocks = FilterCachedBlocks(file, block_size, blocks);
+	progress.uncached_blocks += uncached_blocks.size();
+
+	if (uncached_blocks.empty() || progress.scheduled_blocks >= block_budget) {
+		if (open_file) {
+			pipeline.FinishFile(*open_file);
 		}
-		uncached_file_blocks[file_path] = std::move(uncached_blocks);
-		auto file_handle =
-		    fs.OpenFile(file_path, FileOpenFlags::FILE_FLAGS_READ | FileOpenFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
-		if (!file_handle) {
-			// TODO: add a debug logging that we skipped file
-			continue;
+		return true;
+	}
+
+	// Open lazily, right before the first block of the file is scheduled
+	if (!open_file) {
+		open_file = pipeline.OpenFile(fs, file.file_path);
+		if (!open_file) {
+			if (pipeline.IsAborted()) {
+				return false;
+			}
+			DUCKDB_LOG_DEBUG(context, "Skipping remote file '%s' for prewarm: file not found", file.file_path);
+			return true;
 		}
-		file_handles[file_path] = std::move(file_handle);
 	}
 
-	auto capacity_info = CalculateMaxAvailableBlocks();
+	bool accepted = true;
+	for (const auto &block : uncached_blocks) {
+		if (progress.scheduled_blocks >= block_budget) {
+			break;
+		}
+		RemoteFetchWork work;
+		work.file = open_file;
+		work.offset = file.GetBlockOffset(block.block_index, block_size);
+		work.size = file.GetBlockBytes(block.block_index, block_size);
+		if (!pipeline.Submit(std::move(work))) {
+			accepted = false;
+			break;
+		}
+		progress.scheduled_blocks++;
+	}
+	// The file is closed by the worker completing its last block, or right here if all of them are done already.
+	pipeline.FinishFile(*open_file);
+	return accepted;
+}
+
+RemotePrewarmResult RemotePrewarmStrategy::FinishPipeline(RemoteFetchPipeline &pipeline,
+                                                          const RemotePrewarmProgress &progress, idx_t block_budget) {
+	auto result = pipeline.Finish();
 
-	idx_t blocks_to_prewarm = std::min<idx_t>({total_uncached_blocks, capacity_info.max_blocks, max_blocks});
+	execution_stats.blocks_planned += progress.total_blocks;
+	execution_stats.blocks_resident += progress.total_blocks - progress.uncached_blocks;
+	// Uncached blocks beyond the budget and blocks that failed after retries
+	execution_stats.blocks_skipped += progress.uncached_blocks - result.blocks_fetched;
+	execution_stats.blocks_loaded += result.blocks_fetched;
+	execution_stats.bytes_loaded += result.bytes_fetched;
+	execution_stats.bytes_failed += result.bytes_failed;
+	execution_stats.io_us += GetElapsedMicros(progress.start_time);
 
-	if (blocks_to_prewarm < total_uncached_blocks) {
-		idx_t blocks_skipped = total_uncached_blocks - blocks_to_prewarm;
+	if (result.blocks_failed > 0) {
+		DUCKDB_LOG_WARNING(context,
+		                   "Failed to prewarm %llu remote blocks (%llu bytes) after retries, first failure: %s",
+		                   result.blocks_failed, result.bytes_failed, pipeline.GetFirstFailure());
+	}
+	DUCKDB_LOG_INFO(context,
+	                "Remote prewarm finished.\n"
+	                "  Planned blocks: %llu (limit %llu blocks)\n"
+	                "  Fetched: %llu blocks, %llu bytes (%llu retries)\n"
+	                "  Failed: %llu blocks, %llu bytes",
+	                progress.total_blocks, block_budget, result.blocks_fetched, result.bytes_fetched, result.retries,
+	                result.blocks_failed, result.bytes_failed);
+	return result;
+}
+
+RemotePrewarmResult RemotePrewarmStrategy::Execute(const RemoteBlockPlan &plan, idx_t max_blocks) {
+	if (plan.empty()) {
+		return RemotePrewarmResult();
+	}
+
+	auto capacity_info = CalculateMaxAvailableBlocks();
+	idx_t block_budget = std::min<idx_t>(capacity_info.max_blocks, max_blocks);
+	if (block_budget == 0) {
+		return RemotePrewarmResult();
+	}
+
+	const idx_t total_blocks = plan.BlockCount();
+	const auto &files = plan.GetFiles();
+	RemotePrewarmProgress progress;
+	const auto worker_count = GetFetchWorkerCount(std::min(total_blocks, block_budget));
+	RemoteFetchPipeline pipeline(worker_count, worker_count * REMOTE_PREWARM_QUEUE_DEPTH_PER_WORKER,
+	                             GetMaxOpenFiles(), retry_policy, &task_timings);
+	for (idx_t file_index = 0; file_index < files.size(); file_index++) {
+		if (progress.scheduled_blocks >= block_budget) {
+			break;
+		}
+		auto file_blocks = plan.GetFileBlocks(file_index);
+		if (file_blocks.empty()) {
+			continue;
+		}
+		if (!SubmitFileBlocks(pipeline, nullptr, files[file_index], plan.GetBlockSize(), file_blocks, block_budget,
+		                      progress)) {
+			break;
+		}
+	}
+	auto result = FinishPipeline(pipeline, progress, block_budget);
+	// Files not reached before the budget ran out
+	execution_stats.blocks_planned += total_blocks - progress.total_blocks;
+	execution_stats.blocks_skipped += total_blocks - progress.total_blocks;
 
+	if (progress.scheduled_blocks < progress.uncached_blocks || progress.total_blocks < total_blocks) {
 		DUCKDB_LOG_DEBUG(context,
 		                 "Cache capacity limit reached.\n"
-		                 "  Total blocks: %llu (%llu already cached, %llu uncached)\n"
-		                 "  Prewarming: %llu blocks (skipping %llu due to capacity)",
-		                 total_blocks, total_blocks - total_uncached_blocks, total_uncached_blocks, blocks_to_prewarm,
-		                 blocks_skipped);
-		total_uncached_blocks = blocks_to_prewarm;
+		                 "  Total blocks: %llu (%llu planned, %llu uncached)\n"
+		                 "  Prewarming: %llu blocks (limit %llu blocks)",
+		                 total_blocks, progress.total_blocks, progress.uncached_blocks, progress.scheduled_blocks,
+		                 block_budget);
 	}
+	return result;
+}
 
-	const CacheHttpfsInstanceState &instance_state = GetInstanceStateOrThrow(context);
-	const auto task_count = GetThreadCountForSubrequests(blocks_to_prewarm, instance_state.config.max_subrequest_count);
-	ThreadPool thread_pool(task_count);
-	vector<std::future<void>> prewarm_futures;
-	prewarm_futures.reserve(blocks_to_prewarm);
-	idx_t prewarmed_blocks = 0;
-	idx_t bytes_prewarmed = 0;
-	for (const auto &blocks : uncached_file_blocks) {
-		const auto &file_path = blocks.first;
-		const auto &block_list = blocks.second;
-
-		auto file_handle = file_handles[file_path].get();
-		for (const auto &block : block_list) {
-			if (prewarmed_blocks >= blocks_to_prewarm) {
+RemotePrewarmResult RemotePrewarmStrategy::Execute(const string &pattern, idx_t block_size, idx_t max_blocks) {
+	auto glob_results = fs.Glob(pattern);
+	if (glob_results.empty()) {
+		return RemotePrewarmResult();
+	}
+
+	auto capacity_info = CalculateMaxAvailableBlocks();
+	idx_t block_budget = std::min<idx_t>(capacity_info.max_blocks, max_blocks);
+	if (block_budget == 0) {
+		return RemotePrewarmResult();
+	}
+
+	RemotePrewarmProgress progress;
+	// Blocks of the file currently being planned, reused across files.
+	vector<RemoteBlockRef> file_blocks;
+	const auto worker_count = GetFetchWorkerCount(block_budget);
+	RemoteFetchPipeline pipeline(worker_count, worker_count * REMOTE_PREWARM_QUEUE_DEPTH_PER_WORKER,
+	                             GetMaxOpenFiles(), retry_policy, &task_timings);
+	// Listing -> per-file planning happens here on the calling thread, fetching happens on the pipeline workers.
+	for (idx_t file_index = 0; file_index < glob_results.size(); file_index++) {
+		if (progress.scheduled_blocks >= block_budget) {
+			break;
+		}
+		const auto &file_path = glob_results[file_index].path;
+		// The handle used to stat the file is kept for fetching, it counts against the open file limit.
+		auto open_file = pipeline.OpenFile(fs, file_path);
+		if (!open_file) {
+			if (pipeline.IsAborted()) {
 				break;
 			}
-			auto future = thread_pool.Push([block, file_handle]() {
-				// TODO: add a easy buffer pool to reuse the buffer
-				auto buffer = unique_ptr<char[]>(new char[block.size]);
-				// we only care about on-disk cache file, but not return value
-				file_handle->Read(buffer.get(), block.size, block.offset);
-			});
-			prewarm_futures.emplace_back(std::move(future));
-			bytes_prewarmed += static_cast<idx_t>(block.size);
-			prewarmed_blocks++;
+			DUCKDB_LOG_DEBUG(context, "Skipping remote file '%s' for prewarm: file not found", file_path);
+			continue;
+		}
+		idx_t file_size = fs.GetFileSize(*open_file->handle);
+		if (file_size == 0) {
+			DUCKDB_LOG_DEBUG(context, "Skipping remote file '%s' for prewarm: empty file", file_path);
+			pipeline.FinishFile(*open_file);
+			continue;
+		}
+
+		RemoteFileDescriptor file(file_path, file_size);
+		const idx_t block_count = file.GetBlockCount(block_size);
+		file_blocks.clear();
+		file_blocks.reserve(block_count);
+		for (idx_t block_index = 0; block_index < block_count; block_index++) {
+			file_blocks.push_back(RemoteBlockRef::Create(file_path, file_index, block_index));
+		}
+
+		if (!SubmitFileBlocks(pipeline, std::move(open_file), file, block_size, file_blocks, block_budget,
+		                      progress)) {
+			break;
 		}
 	}
+	auto result = FinishPipeline(pipeline, progress, block_budget);
 
-	for (auto &future : prewarm_futures) {
-		future.get();
+	if (progress.scheduled_blocks < progress.uncached_blocks) {
+		DUCKDB_LOG_DEBUG(context,
+		                 "Cache capacity limit reached.\n"
+		                 "  Planned blocks: %llu (%llu already cached, %llu uncached)\n"
+		                 "  Prewarming: %llu blocks (limit %llu blocks)",
+		                 progress.total_blocks, progress.total_blocks - progress.uncached_blocks,
+		                 progress.uncached_blocks, progress.scheduled_blocks, block_budget);
 	}
+	return result;
+}
 
-	return bytes_prewarmed;
+PrewarmPlanSummary RemotePrewarmStrategy::Plan(const string &pattern, idx_t block_size, idx_t max_blocks) {
+	PrewarmPlanSummary summary;
+	auto capacity_info = CalculateMaxAvailableBlocks();
+	const idx_t block_budget = std::min<idx_t>(capacity_info.max_blocks, max_blocks);
+
+	vector<RemoteBlockRef> file_blocks;
+	auto glob_results = fs.Glob(pattern);
+	for (idx_t file_index = 0; file_index < glob_results.size(); file_index++) {
+		const auto &file_path = glob_results[file_index].path;
+		auto handle =
+		    fs.OpenFile(file_path, FileOpenFlags::FILE_FLAGS_READ | FileOpenFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+		if (!handle) {
+			continue;
+		}
+		RemoteFileDescriptor file(file_path, fs.GetFileSize(*handle));
+		const idx_t block_count = file.GetBlockCount(block_size);
+		file_blocks.clear();
+		file_blocks.reserve(block_count);
+		for (idx_t block_index = 0; block_index < block_count; block_index++) {
+			file_blocks.push_back(RemoteBlockRef::Create(file_path, file_index, block_index));
+		}
+		summary.planned_blocks += block_count;
+
+		auto uncached_blocks = FilterCachedBlocks(file, block_size, file_blocks);
+		idx_t previous_block_index = 0;
+		bool extent_open = false;
+		for (const auto &block : uncached_blocks) {
+			const idx_t block_bytes = file.GetBlockBytes(block.block_index, block_size);
+			if (summary.blocks >= block_budget) {
+				summary.skipped_bytes += block_bytes;
+				continue;
+			}
+			if (!extent_open || block.block_index != previous_block_index + 1) {
+				summary.extents++;
+				extent_open = true;
+			}
+			previous_block_index = block.block_index;
+			summary.blocks++;
+			summary.bytes += block_bytes;
+		}
+	}
+	return summary;
 }
 
 } // namespace duckdb
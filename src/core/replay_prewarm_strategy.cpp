@@ -0,0 +1,136 @@
+#include "core/replay_prewarm_strategy.hpp"
+
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer/block_handle.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace duckdb {
+
+namespace {
+
+// Same ~4MiB batches as the buffer strategy, one wave is a batch per thread.
+constexpr idx_t REPLAY_PREFETCH_TARGET_BYTES = 4ULL * 1024ULL * 1024ULL;
+
+class ReplayBatchTask : public BaseExecutorTask {
+public:
+	ReplayBatchTask(TaskExecutor &executor, BufferManager &buffer_manager_p, vector<shared_ptr<BlockHandle>> &handles_p,
+	                idx_t start_p, idx_t count_p, PrewarmTaskTimings &timings_p)
+	    : BaseExecutorTask(executor), buffer_manager(buffer_manager_p), handles(handles_p), start(start_p),
+	      count(count_p), timings(timings_p) {
+	}
+
+	void ExecuteTask() override {
+		auto task_start = std::chrono::steady_clock::now();
+		vector<shared_ptr<BlockHandle>> batch(handles.begin() + start, handles.begin() + start + count);
+		buffer_manager.Prefetch(batch);
+		timings.Record(task_start);
+	}
+
+	string TaskType() const override {
+		return "ReplayBatchTask";
+	}
+
+private:
+	BufferManager &buffer_manager;
+	vector<shared_ptr<BlockHandle>> &handles;
+	idx_t start;
+	idx_t count;
+	PrewarmTaskTimings &timings;
+};
+
+} // namespace
+
+idx_t ReplayPrewarmStrategy::Execute(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) {
+	return Replay(block_ids.ToVector(), max_blocks, /*time_budget_ms=*/0);
+}
+
+idx_t ReplayPrewarmStrategy::Replay(const vector<block_id_t> &ordered_block_ids, idx_t max_blocks,
+                                    idx_t time_budget_ms) {
+	const auto start_time = std::chrono::steady_clock::now();
+
+	// Keep the requested order, unlike GetUnloadedBlockHandles()
+	auto register_start = std::chrono::steady_clock::now();
+	const auto total_blocks = static_cast<block_id_t>(block_manager.TotalBlocks());
+	unordered_set<block_id_t> seen_blocks;
+	vector<shared_ptr<BlockHandle>> unloaded_handles;
+	unloaded_handles.reserve(ordered_block_ids.size());
+	for (block_id_t block_id : ordered_block_ids) {
+		// Blocks past the end of the file were truncated away, registering them would read past the end
+		if (block_id < 0 || block_id >= total_blocks) {
+			continue;
+		}
+		if (!seen_blocks.insert(block_id).second) {
+			continue;
+		}
+		auto handle = block_manager.RegisterBlock(block_id);
+		if (handle->GetMemory().IsUnloaded()) {
+			unloaded_handles.emplace_back(std::move(handle));
+		}
+	}
+	execution_stats.register_us += GetElapsedMicros(register_start);
+	execution_stats.blocks_planned += seen_blocks.size();
+	execution_stats.blocks_resident += seen_blocks.size() - unloaded_handles.size();
+	if (unloaded_handles.empty()) {
+		return 0;
+	}
+
+	auto capacity_info = CalculateMaxAvailableBlocks();
+	idx_t effective_max = std::min(capacity_info.max_blocks, max_blocks);
+	if (unloaded_handles.size() > effective_max) {
+		DUCKDB_LOG_WARNING(context,
+		                   "Buffer pool capacity limit reached during replay.\n"
+		                   "  Replaying: %llu of %llu unloaded blocks (skipping the last %llu accessed)",
+		                   effective_max, unloaded_handles.size(), unloaded_handles.size() - effective_max);
+		execution_stats.blocks_skipped += unloaded_handles.size() - effective_max;
+		unloaded_handles.resize(effective_max);
+	}
+
+	auto thread_count = static_cast<idx_t>(std::max(1, TaskScheduler::GetScheduler(context).NumberOfThreads()));
+	auto blocks_per_task = CalculateBlocksPerTask(capacity_info.block_size, unloaded_handles.size(), thread_count,
+	                                              GetTargetBatchBytes(REPLAY_PREFETCH_TARGET_BYTES));
+	if (blocks_per_task == 0) {
+		return 0;
+	}
+
+	const idx_t wave_blocks = blocks_per_task * thread_count;
+	auto io_start = std::chrono::steady_clock::now();
+	idx_t blocks_loaded = 0;
+	while (blocks_loaded < unloaded_handles.size()) {
+		if (time_budget_ms > 0) {
+			auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+			                                                                          start_time)
+			                      .count();
+			if (static_cast<idx_t>(elapsed_ms) >= time_budget_ms) {
+				DUCKDB_LOG_INFO(context, "Replay time budget of %llu ms exhausted after %llu of %llu blocks",
+				                time_budget_ms, blocks_loaded, unloaded_handles.size());
+				break;
+			}
+		}
+		const idx_t wave_end = std::min<idx_t>(blocks_loaded + wave_blocks, unloaded_handles.size());
+		TaskExecutor executor(context);
+		for (idx_t start = blocks_loaded; start < wave_end; start += blocks_per_task) {
+			auto count = std::min<idx_t>(blocks_per_task, wave_end - start);
+			executor.ScheduleTask(
+			    make_uniq<ReplayBatchTask>(executor, buffer_manager, unloaded_handles, start, count, task_timings));
+		}
+		executor.WorkOnTasks();
+		blocks_loaded = wave_end;
+	}
+	execution_stats.io_us += GetElapsedMicros(io_start);
+
+	// Blocks left over when the time budget ran out, and blocks that failed to load or were evicted again
+	const idx_t blocks_to_load = unloaded_handles.size();
+	unloaded_handles.resize(blocks_loaded);
+	blocks_loaded = CountLoadedBlocks(unloaded_handles);
+	execution_stats.blocks_skipped += blocks_to_load - blocks_loaded;
+	execution_stats.blocks_loaded += blocks_loaded;
+	execution_stats.bytes_loaded += blocks_loaded * capacity_info.block_size;
+	return blocks_loaded * capacity_info.block_size;
+}
+
+} // namespace duckdb
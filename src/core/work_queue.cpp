@@ -0,0 +1,59 @@
+#include "core/work_queue.hpp"
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+
+namespace duckdb {
+
+namespace {
+
+class WorkQueueTask : public BaseExecutorTask {
+public:
+	WorkQueueTask(TaskExecutor &executor, WorkQueue &queue_p, const std::function<void(idx_t)> &process_p)
+	    : BaseExecutorTask(executor), queue(queue_p), process(process_p) {
+	}
+
+	void ExecuteTask() override {
+		idx_t item;
+		while (queue.Next(item)) {
+			process(item);
+		}
+	}
+
+	string TaskType() const override {
+		return "WorkQueueTask";
+	}
+
+private:
+	WorkQueue &queue;
+	const std::function<void(idx_t)> &process;
+};
+
+} // namespace
+
+bool WorkQueue::Next(idx_t &item) {
+	if (cancelled) {
+		return false;
+	}
+	auto item_idx = next_item.fetch_add(1);
+	if (item_idx >= item_count) {
+		return false;
+	}
+	item = item_idx;
+	return true;
+}
+
+void WorkQueue::Run(ClientContext &context, idx_t max_workers, const std::function<void(idx_t)> &process) {
+	const idx_t worker_count = MinValue(MaxValue<idx_t>(max_workers, 1), item_count);
+	if (worker_count == 0) {
+		return;
+	}
+	TaskExecutor executor(context);
+	for (idx_t worker = 0; worker < worker_count; worker++) {
+		executor.ScheduleTask(make_uniq<WorkQueueTask>(executor, *this, process));
+	}
+	executor.WorkOnTasks();
+}
+
+} // namespace duckdb
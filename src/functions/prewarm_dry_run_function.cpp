@@ -0,0 +1,139 @@
+#include "functions/prewarm_dry_run_function.hpp"
+
+#include "cache_httpfs_instance_state.hpp"
+#include "cache_prewarm_extension.hpp"
+#include "core/block_collector.hpp"
+#include "core/prewarm_stats.hpp"
+#include "core/prewarm_strategy_factory.hpp"
+#include "core/remote_prewarm_strategy.hpp"
+#include "utils/include/parse_size.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct PrewarmDryRunBindData : public TableFunctionData {
+	//! Table name for prewarm_dry_run, glob pattern for prewarm_remote_dry_run
+	string target;
+	PrewarmMode mode = PrewarmMode::BUFFER;
+	idx_t max_bytes = NumericLimits<idx_t>::Maximum();
+};
+
+struct PrewarmDryRunGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+unique_ptr<FunctionData> PrewarmDryRunBind(ClientContext &context, TableFunctionBindInput &input,
+                                           vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<PrewarmDryRunBindData>();
+	if (input.inputs[0].IsNull()) {
+		throw InvalidInputException("%s: target cannot be NULL", input.table_function.name);
+	}
+	bind_data->target = input.inputs[0].ToString();
+	for (const auto &named_parameter : input.named_parameters) {
+		if (named_parameter.first == "mode") {
+			bind_data->mode = ParsePrewarmMode(named_parameter.second);
+		} else if (named_parameter.first == "max_size" && !named_parameter.second.IsNull()) {
+			bind_data->max_bytes = ParseSizeLimit(named_parameter.second.ToString());
+		}
+	}
+
+	names = {"strategy", "planned_blocks", "blocks", "extents", "bytes", "resident_bytes", "skipped_bytes",
+	         "estimated_time_ms"};
+	return_types = {LogicalType {LogicalTypeId::VARCHAR}, LogicalType {LogicalTypeId::UBIGINT},
+	                LogicalType {LogicalTypeId::UBIGINT}, LogicalType {LogicalTypeId::UBIGINT},
+	                LogicalType {LogicalTypeId::UBIGINT}, LogicalType {LogicalTypeId::UBIGINT},
+	                LogicalType {LogicalTypeId::UBIGINT}, LogicalType {LogicalTypeId::DOUBLE}};
+	return std::move(bind_data);
+}
+
+unique_ptr<GlobalTableFunctionState> PrewarmDryRunInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<PrewarmDryRunGlobalState>();
+}
+
+//! Emit the plan as a single row. The duration is estimated from the throughput the strategy achieved in earlier
+//! calls of this process, it is NULL if there were none.
+void EmitPlanRow(const string &strategy, const PrewarmPlanSummary &summary, DataChunk &output) {
+	output.SetValue(0, 0, Value(strategy));
+	output.SetValue(1, 0, Value::UBIGINT(summary.planned_blocks));
+	output.SetValue(2, 0, Value::UBIGINT(summary.blocks));
+	output.SetValue(3, 0, Value::UBIGINT(summary.extents));
+	output.SetValue(4, 0, Value::UBIGINT(summary.bytes));
+	output.SetValue(5, 0, Value::UBIGINT(summary.resident_bytes));
+	output.SetValue(6, 0, Value::UBIGINT(summary.skipped_bytes));
+	Value estimated_time_ms;
+	auto throughput = PrewarmStatsRegistry::Get().GetThroughput(strategy);
+	if (summary.bytes == 0) {
+		estimated_time_ms = Value::DOUBLE(0);
+	} else if (throughput > 0) {
+		estimated_time_ms = Value::DOUBLE(static_cast<double>(summary.bytes) * 1000.0 / throughput);
+	}
+	output.SetValue(7, 0, estimated_time_ms);
+	output.SetCardinality(1);
+}
+
+void PrewarmDryRunFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<PrewarmDryRunGlobalState>();
+	if (state.finished) {
+		return;
+	}
+	state.finished = true;
+	const auto &bind_data = data_p.bind_data->Cast<PrewarmDryRunBindData>();
+
+	auto resolved = BlockCollector::ResolveTable(context, bind_data.target);
+	auto &block_manager = StorageManager::Get(*resolved.database).GetBlockManager();
+	auto block_ids = BlockCollector::CollectTableBlocks(context, resolved.table.get());
+	auto strategy =
+	    CreateLocalPrewarmStrategy(context, bind_data.mode, block_manager, BufferManager::GetBufferManager(context));
+	auto max_blocks = bind_data.max_bytes / block_manager.GetBlockAllocSize();
+	EmitPlanRow(strategy->GetName(), strategy->Plan(*resolved.database, block_ids, max_blocks), output);
+}
+
+void PrewarmRemoteDryRunFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<PrewarmDryRunGlobalState>();
+	if (state.finished) {
+		return;
+	}
+	state.finished = true;
+	const auto &bind_data = data_p.bind_data->Cast<PrewarmDryRunBindData>();
+
+	const idx_t block_size = GetInstanceStateOrThrow(context).config.cache_block_size;
+	// OpenerFileSystem(fs) -> VirtualFileSystem -> CacheFileSystem
+	RemotePrewarmStrategy strategy(context, DatabaseInstance::GetDatabase(context).GetFileSystem());
+	auto summary = strategy.Plan(bind_data.target, block_size, bind_data.max_bytes / block_size);
+	EmitPlanRow(strategy.GetName(), summary, output);
+	// cache_httpfs offers no lookup of the blocks it holds, so which ones are cached already is unknown
+	output.SetValue(5, 0, Value(LogicalType {LogicalTypeId::UBIGINT}));
+}
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Function Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterPrewarmDryRunFunctions(ExtensionLoader &loader) {
+	// prewarm_dry_run(table, mode := ..., max_size := ...): what prewarm() would load, without loading it
+	TableFunction prewarm_dry_run("prewarm_dry_run", /*arguments=*/ {LogicalType {LogicalTypeId::VARCHAR}},
+	                              PrewarmDryRunFunction, PrewarmDryRunBind, PrewarmDryRunInit);
+	prewarm_dry_run.named_parameters["mode"] = LogicalType {LogicalTypeId::VARCHAR};
+	prewarm_dry_run.named_parameters["max_size"] = LogicalType {LogicalTypeId::VARCHAR};
+	loader.RegisterFunction(prewarm_dry_run);
+
+	// prewarm_remote_dry_run(pattern, max_size := ...): what prewarm_remote() would fetch, without fetching it
+	TableFunction prewarm_remote_dry_run("prewarm_remote_dry_run",
+	                                     /*arguments=*/ {LogicalType {LogicalTypeId::VARCHAR}},
+	                                     PrewarmRemoteDryRunFunction, PrewarmDryRunBind, PrewarmDryRunInit);
+	prewarm_remote_dry_run.named_parameters["max_size"] = LogicalType {LogicalTypeId::VARCHAR};
+	loader.RegisterFunction(prewarm_remote_dry_run);
+}
+
+} // namespace duckdb
@@ -0,0 +1,67 @@
+#include "functions/prewarm_evict_function.hpp"
+
+#include "core/block_collector.hpp"
+#include "core/block_evictor.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Prewarm Evict Scalar Function Implementation
+//===--------------------------------------------------------------------===//
+
+static void PrewarmEvictFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+
+	// Parse table name (1st argument), supports qualified names like "schema.table" or "database.schema.table"
+	auto table_val = args.GetValue(0, 0);
+	if (table_val.IsNull()) {
+		throw InvalidInputException("Table name cannot be NULL");
+	}
+	auto resolved = BlockCollector::ResolveTable(context, table_val.ToString());
+
+	// Parse evict mode (2nd argument)
+	EvictMode mode = EvictMode::ALL;
+	if (args.ColumnCount() > 1) {
+		mode = ParseEvictMode(args.GetValue(1, 0));
+	}
+
+	auto &database = *resolved.database;
+	idx_t bytes_evicted = 0;
+	if (!database.GetStorageManager().InMemory()) {
+		auto block_ids = BlockCollector::CollectTableBlocks(context, resolved.table.get());
+		bytes_evicted = BlockEvictor::Evict(database, block_ids, mode);
+		DUCKDB_LOG_DEBUG(context, "prewarm_evict: %llu bytes of %llu blocks of '%s' evicted", bytes_evicted,
+		                 block_ids.size(), resolved.qualified_name);
+	}
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<int64_t>(result)[0] = NumericCast<int64_t>(bytes_evicted);
+}
+
+//===--------------------------------------------------------------------===//
+// Function Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterPrewarmEvictFunction(ExtensionLoader &loader) {
+	// Register prewarm_evict scalar function
+	// Signature: prewarm_evict(table_name, [mode])
+	ScalarFunctionSet prewarm_evict_set("prewarm_evict");
+	// prewarm_evict(table)
+	prewarm_evict_set.AddFunction(ScalarFunction(/*arguments=*/ {/*table=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                             /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                             PrewarmEvictFunction));
+	// prewarm_evict(table, mode)
+	prewarm_evict_set.AddFunction(ScalarFunction(/*arguments=*/ {/*table=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                             /*mode=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                             /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                             PrewarmEvictFunction));
+	loader.RegisterFunction(prewarm_evict_set);
+}
+
+} // namespace duckdb
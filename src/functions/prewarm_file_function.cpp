@@ -0,0 +1,90 @@
+#include "functions/prewarm_file_function.hpp"
+
+#include "core/file_prewarm_strategy.hpp"
+#include "core/prewarm_stats.hpp"
+#include "core/prewarm_strategy_factory.hpp"
+#include "utils/include/parse_size.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Prewarm File Scalar Function Implementation
+//===--------------------------------------------------------------------===//
+namespace {
+
+void PrewarmFileFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+
+	auto pattern_val = args.GetValue(0, 0);
+	if (pattern_val.IsNull()) {
+		throw InvalidInputException("Pattern cannot be NULL");
+	}
+	string pattern = pattern_val.ToString();
+
+	// Parse prewarm mode (2nd argument), the OS page cache is warmed with hints unless reads are requested
+	PrewarmMode mode = PrewarmMode::PREFETCH;
+	if (args.ColumnCount() > 1 && !args.GetValue(1, 0).IsNull()) {
+		mode = ParsePrewarmMode(args.GetValue(1, 0));
+	}
+	FilePrewarmStrategy strategy(context, mode);
+
+	// Parse size limit (3rd argument) - accepts human-readable sizes like '1GB', '100MB'
+	idx_t max_bytes = NumericLimits<idx_t>::Maximum();
+	if (args.ColumnCount() > 2) {
+		auto size_val = args.GetValue(2, 0);
+		if (!size_val.IsNull()) {
+			max_bytes = ParseSizeLimit(size_val.ToString());
+		}
+	}
+
+	// Expanding the pattern and sizing the files is the collection phase
+	auto collection_start = std::chrono::steady_clock::now();
+	auto files = FilePrewarmStrategy::ListFiles(context, pattern);
+	auto collection_us = GetElapsedMicros(collection_start);
+
+	idx_t bytes_prewarmed = strategy.Execute(files, max_bytes);
+	RecordPrewarmCall(context, /*database=*/"", collection_us, strategy);
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<int64_t>(result);
+	result_data[0] = NumericCast<int64_t>(bytes_prewarmed);
+}
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Function Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterPrewarmFileFunction(ExtensionLoader &loader) {
+	// Signature: prewarm_file(pattern, [mode], [max_size])
+	ScalarFunctionSet prewarm_file_set("prewarm_file");
+	// prewarm_file(pattern)
+	prewarm_file_set.AddFunction(ScalarFunction(/*arguments=*/ {/*pattern=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                            /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                            PrewarmFileFunction));
+	// prewarm_file(pattern, mode)
+	prewarm_file_set.AddFunction(ScalarFunction(/*arguments=*/ {/*pattern=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                            /*mode=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                            /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                            PrewarmFileFunction));
+	// prewarm_file(pattern, mode, max_size) - max_size as raw bytes (BIGINT)
+	prewarm_file_set.AddFunction(ScalarFunction(/*arguments=*/ {/*pattern=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                            /*mode=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                            /*max_size=*/LogicalType {LogicalTypeId::BIGINT}},
+	                                            /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                            PrewarmFileFunction));
+	// prewarm_file(pattern, mode, max_size) - max_size as human-readable string like '1GB', '100MB'
+	prewarm_file_set.AddFunction(ScalarFunction(/*arguments=*/ {/*pattern=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                            /*mode=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                            /*max_size=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                            /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                            PrewarmFileFunction));
+	loader.RegisterFunction(prewarm_file_set);
+}
+
+} // namespace duckdb
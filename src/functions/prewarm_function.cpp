@@ -1,54 +1,26 @@
 #include "cache_prewarm_extension.hpp"
 #include "core/block_collector.hpp"
+#include "core/buffer_prewarm_strategy.hpp"
+#include "core/pin_prewarm_strategy.hpp"
+#include "core/pinned_blocks.hpp"
+#include "core/prewarm_stats.hpp"
 #include "core/prewarm_strategy_factory.hpp"
 #include "utils/include/parse_size.hpp"
 
-#include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
-#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/shared_ptr.hpp"
-#include "duckdb/common/string_util.hpp"
 #include "duckdb/common/unordered_set.hpp"
 #include "duckdb/function/scalar_function.hpp"
 #include "duckdb/main/attached_database.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/database.hpp"
-#include "duckdb/main/database_manager.hpp"
-#include "duckdb/parser/qualified_name.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 
 namespace duckdb {
 
-//===--------------------------------------------------------------------===//
-// Helper Functions
-//===--------------------------------------------------------------------===//
-
-namespace {
-
-//! Parse prewarm mode from value
-PrewarmMode ParsePrewarmMode(const Value &mode_val) {
-	if (mode_val.IsNull()) {
-		return PrewarmMode::BUFFER;
-	}
-	auto lower_mode = StringUtil::Lower(mode_val.ToString());
-	if (lower_mode == "prefetch") {
-		return PrewarmMode::PREFETCH;
-	}
-	if (lower_mode == "read") {
-		return PrewarmMode::READ;
-	}
-	if (lower_mode == "buffer") {
-		return PrewarmMode::BUFFER;
-	}
-	throw InvalidInputException("Invalid prewarm mode '%s'. Valid modes are: 'prefetch', 'read', 'buffer'",
-	                            mode_val.ToString());
-}
-
-} // namespace
-
 //===--------------------------------------------------------------------===//
 // Prewarm Scalar Function Implementation
 //===--------------------------------------------------------------------===//
@@ -65,7 +37,7 @@ static void PrewarmFunction(DataChunk &args, ExpressionState &state, Vector &res
 	if (table_val.IsNull()) {
 		throw InvalidInputException("Table name cannot be NULL");
 	}
-	auto qualified_name = QualifiedName::Parse(table_val.ToString());
+	string table_name = table_val.ToString();
 
 	// Parse prewarm mode (2nd argument)
 	PrewarmMode mode = PrewarmMode::BUFFER;
@@ -84,20 +56,12 @@ static void PrewarmFunction(DataChunk &args, ExpressionState &state, Vector &res
 		}
 	}
 
-	string schema = qualified_name.schema.empty() ? "main" : qualified_name.schema;
-	string table_name = std::move(qualified_name.name);
-
-	// Resolve the database: use the catalog from the qualified name if specified, otherwise use the default database
-	auto &db_manager = DatabaseManager::Get(DatabaseInstance::GetDatabase(context));
-	string db_name =
-	    qualified_name.catalog == INVALID_CATALOG ? db_manager.GetDefaultDatabase(context) : qualified_name.catalog;
-	shared_ptr<AttachedDatabase> db = db_manager.GetDatabase(db_name);
-	if (!db) {
-		throw InvalidInputException("Database '%s' not found", db_name);
-	}
-	auto &catalog = db->GetCatalog();
-	auto &table_catalog_entry = catalog.GetEntry<TableCatalogEntry>(context, schema, table_name);
-	auto &duck_table = table_catalog_entry.Cast<DuckTableEntry>();
+	// Resolve the table: the database from the qualified name if specified, otherwise the default database
+	// Resolving the table counts towards the collection phase
+	auto collection_start = std::chrono::steady_clock::now();
+	auto resolved = BlockCollector::ResolveTable(context, table_name);
+	auto &db = resolved.database;
+	auto &duck_table = resolved.table.get();
 
 	// Convert max_bytes to max_blocks using the block size
 	auto &block_manager = StorageManager::Get(*db).GetBlockManager();
@@ -107,15 +71,39 @@ static void PrewarmFunction(DataChunk &args, ExpressionState &state, Vector &res
 		max_blocks = max_bytes / block_size;
 	}
 
-	// Collect all blocks from the table using BlockCollector
-	unordered_set<block_id_t> block_ids = BlockCollector::CollectTableBlocks(context, duck_table);
+	// Re-pinning a table replaces its pins, release the old ones first so they do not count against the pin cap
+	shared_ptr<PinnedBlockRegistry> pin_registry;
+	if (mode == PrewarmMode::PIN) {
+		pin_registry = context.registered_state->GetOrCreate<PinnedBlockRegistry>(PinnedBlockRegistry::STATE_KEY);
+		pin_registry->Release(resolved.qualified_name);
+	}
 
-	// Execute prewarm using the appropriate strategy
 	idx_t bytes_prewarmed = 0;
-	if (!block_ids.empty()) {
-		auto strategy = CreateLocalPrewarmStrategy(context, mode, StorageManager::Get(*db).GetBlockManager(),
-		                                           BufferManager::GetBufferManager(context));
-		bytes_prewarmed = strategy->Execute(duck_table, block_ids, max_blocks);
+	if (mode == PrewarmMode::BUFFER) {
+		// Load the row groups collected first while the later ones are collected
+		TableBlockStream stream(context, duck_table);
+		auto setup_us = GetElapsedMicros(collection_start);
+		auto strategy =
+		    CreateLocalPrewarmStrategy(context, mode, block_manager, BufferManager::GetBufferManager(context));
+		bytes_prewarmed = strategy->Cast<BufferPrewarmStrategy>().ExecuteStream(*db, stream, max_blocks);
+		if (strategy->GetExecutionStats().blocks_planned > 0) {
+			RecordPrewarmCall(context, db->GetName(), setup_us + stream.GetCollectionMicros(), *strategy);
+		}
+	} else {
+		// Collect all blocks from the table using BlockCollector
+		BlockIdSet block_ids = BlockCollector::CollectTableBlocks(context, duck_table);
+		auto collection_us = GetElapsedMicros(collection_start);
+
+		// Execute prewarm using the appropriate strategy
+		if (!block_ids.empty()) {
+			auto strategy =
+			    CreateLocalPrewarmStrategy(context, mode, block_manager, BufferManager::GetBufferManager(context));
+			bytes_prewarmed = strategy->Execute(*db, block_ids, max_blocks);
+			RecordPrewarmCall(context, db->GetName(), collection_us, *strategy);
+			if (pin_registry) {
+				pin_registry->Pin(resolved.qualified_name, strategy->Cast<PinPrewarmStrategy>().TakePinnedBlocks());
+			}
+		}
 	}
 
 	result.SetVectorType(VectorType::CONSTANT_VECTOR);
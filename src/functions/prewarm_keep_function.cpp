@@ -0,0 +1,139 @@
+#include "functions/prewarm_keep_function.hpp"
+
+#include "cache_prewarm_extension.hpp"
+#include "core/block_collector.hpp"
+#include "core/keep_warm_manager.hpp"
+#include "core/prewarm_strategy_factory.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/block_manager.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+
+namespace duckdb {
+
+namespace {
+
+shared_ptr<KeepWarmManager> GetKeepWarmManager(ClientContext &context) {
+	return context.registered_state->GetOrCreate<KeepWarmManager>(KeepWarmManager::STATE_KEY);
+}
+
+idx_t GetKeepMaxBytesPerSec(ClientContext &context) {
+	Value rate;
+	if (context.TryGetCurrentSetting(PREWARM_KEEP_MAX_BYTES_PER_SEC_SETTING, rate) && !rate.IsNull()) {
+		return rate.GetValue<uint64_t>();
+	}
+	return DEFAULT_PREWARM_KEEP_MAX_BYTES_PER_SEC;
+}
+
+string GetTableArgument(DataChunk &args, const char *function_name) {
+	auto table_val = args.GetValue(0, 0);
+	if (table_val.IsNull()) {
+		throw InvalidInputException("%s: table name cannot be NULL", function_name);
+	}
+	return table_val.ToString();
+}
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Keep-Warm Scalar Function Implementation
+//===--------------------------------------------------------------------===//
+
+static void PrewarmKeepFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto table_name = GetTableArgument(args, "prewarm_keep");
+
+	// Parse prewarm mode (2nd argument), only modes with a cheap residency check can be kept warm
+	PrewarmMode mode = PrewarmMode::BUFFER;
+	if (args.ColumnCount() > 1) {
+		mode = ParsePrewarmMode(args.GetValue(1, 0));
+	}
+	if (mode == PrewarmMode::READ) {
+		throw InvalidInputException("prewarm_keep: mode 'read' is not supported, use 'buffer' or 'prefetch'");
+	}
+	if (mode == PrewarmMode::PIN) {
+		throw InvalidInputException("prewarm_keep: mode 'pin' is not supported, pinned blocks stay resident without "
+		                            "refreshing");
+	}
+	if (mode == PrewarmMode::PREFETCH && context.db->config.options.use_direct_io) {
+		throw InvalidInputException("prewarm_keep: mode 'prefetch' is not effective when direct I/O is enabled");
+	}
+
+	// Parse check interval (3rd argument)
+	idx_t interval_ms = DEFAULT_PREWARM_KEEP_INTERVAL_MS;
+	if (args.ColumnCount() > 2) {
+		auto interval_val = args.GetValue(2, 0);
+		if (!interval_val.IsNull()) {
+			auto interval_us = Interval::GetMicro(interval_val.GetValue<interval_t>());
+			if (interval_us <= 0) {
+				throw InvalidInputException("prewarm_keep: interval must be positive");
+			}
+			interval_ms = MaxValue<idx_t>(1, NumericCast<idx_t>(interval_us) / Interval::MICROS_PER_MSEC);
+		}
+	}
+
+	auto resolved = BlockCollector::ResolveTable(context, table_name);
+	if (resolved.database->GetStorageManager().InMemory()) {
+		throw InvalidInputException("prewarm_keep: table '%s' is not stored in a database file",
+		                            resolved.qualified_name);
+	}
+	auto &block_manager = resolved.database->GetStorageManager().GetBlockManager();
+	const auto checkpoint_stamp = static_cast<uint64_t>(block_manager.GetMetaBlock());
+	auto block_id_set = BlockCollector::CollectTableBlocks(context, resolved.table.get());
+
+	KeepWarmPolicy policy;
+	policy.table_name = resolved.qualified_name;
+	policy.checkpoint_stamp = checkpoint_stamp;
+	policy.database = std::move(resolved.database);
+	policy.block_ids = block_id_set.ToVector();
+	policy.mode = mode;
+	policy.interval_ms = interval_ms;
+	const auto block_count = policy.block_ids.size();
+	DUCKDB_LOG_INFO(context, "prewarm_keep: keeping %llu blocks of '%s' warm, checked every %llu ms", block_count,
+	                policy.table_name, interval_ms);
+	GetKeepWarmManager(context)->Keep(std::move(policy), GetKeepMaxBytesPerSec(context));
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<int64_t>(result)[0] = NumericCast<int64_t>(block_count);
+}
+
+static void PrewarmUnkeepFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto table_name = GetTableArgument(args, "prewarm_unkeep");
+	// The table may have been dropped since, so it is not looked up
+	bool removed = GetKeepWarmManager(context)->Unkeep(BlockCollector::QualifyTableName(context, table_name));
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<bool>(result)[0] = removed;
+}
+
+//===--------------------------------------------------------------------===//
+// Function Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterPrewarmKeepFunctions(ExtensionLoader &loader) {
+	// prewarm_keep(table, [mode], [interval]): reload the table's evicted blocks in the background, returns the
+	// number of blocks kept warm
+	ScalarFunctionSet keep_set("prewarm_keep");
+	keep_set.AddFunction(ScalarFunction(/*arguments=*/ {/*table=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                    /*return_type=*/LogicalType {LogicalTypeId::BIGINT}, PrewarmKeepFunction));
+	keep_set.AddFunction(ScalarFunction(/*arguments=*/ {/*table=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                    /*mode=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                    /*return_type=*/LogicalType {LogicalTypeId::BIGINT}, PrewarmKeepFunction));
+	keep_set.AddFunction(ScalarFunction(/*arguments=*/ {/*table=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                    /*mode=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                    /*interval=*/LogicalType {LogicalTypeId::INTERVAL}},
+	                                    /*return_type=*/LogicalType {LogicalTypeId::BIGINT}, PrewarmKeepFunction));
+	loader.RegisterFunction(keep_set);
+
+	// prewarm_unkeep(table): stop keeping a table warm, returns whether it was kept warm
+	loader.RegisterFunction(ScalarFunction("prewarm_unkeep",
+	                                       /*arguments=*/ {/*table=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                       /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN}, PrewarmUnkeepFunction));
+}
+
+} // namespace duckdb
@@ -0,0 +1,319 @@
+#include "functions/prewarm_manifest_function.hpp"
+
+#include "cache_httpfs_instance_state.hpp"
+#include "cache_prewarm_extension.hpp"
+#include "core/block_access_trace.hpp"
+#include "core/block_collector.hpp"
+#include "core/prewarm_manifest.hpp"
+#include "core/prewarm_stats.hpp"
+#include "core/prewarm_strategy_factory.hpp"
+#include "core/query_block_collector.hpp"
+#include "core/remote_block_collector.hpp"
+#include "core/remote_prewarm_strategy.hpp"
+#include "utils/include/parse_size.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+
+namespace duckdb {
+
+namespace {
+
+string GetStringArgument(DataChunk &args, idx_t index, const char *function_name, const char *argument_name) {
+	auto value = args.GetValue(index, 0);
+	if (value.IsNull()) {
+		throw InvalidInputException("%s: %s cannot be NULL", function_name, argument_name);
+	}
+	return value.ToString();
+}
+
+//! Add the blocks of an attached database, stamped with its current file path, block size and checkpoint
+void AddDatabaseSection(PrewarmManifestWriter &writer, AttachedDatabase &database, const BlockIdSet &block_ids) {
+	auto &storage_manager = database.GetStorageManager();
+	auto &block_manager = storage_manager.GetBlockManager();
+	writer.AddDatabase(database.GetName(), storage_manager.GetDBPath(),
+	                   static_cast<uint64_t>(block_manager.GetMetaBlock()), block_manager.GetBlockAllocSize(),
+	                   block_ids.ToVector());
+}
+
+void ExportTable(ClientContext &context, const string &table_name, PrewarmManifestWriter &writer) {
+	auto resolved = BlockCollector::ResolveTable(context, table_name);
+	auto block_ids = BlockCollector::CollectTableBlocks(context, resolved.table.get());
+	AddDatabaseSection(writer, *resolved.database, block_ids);
+}
+
+void ExportQuery(ClientContext &context, const string &query, PrewarmManifestWriter &writer) {
+	auto &db = DatabaseInstance::GetDatabase(context);
+	// Plan on a separate connection, this context is busy executing the export statement
+	Connection planner(db);
+	planner.BeginTransaction();
+	auto plan = QueryBlockCollector::CollectQueryBlocks(planner, query);
+	for (auto &database : plan.databases) {
+		AddDatabaseSection(writer, database.database.get(), database.block_ids);
+	}
+	auto &fs = db.GetFileSystem();
+	for (auto &file : plan.files) {
+		auto file_handle =
+		    fs.OpenFile(file.file_path, FileOpenFlags::FILE_FLAGS_READ | FileOpenFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+		if (!file_handle) {
+			continue;
+		}
+		idx_t file_size = fs.GetFileSize(*file_handle);
+		if (file_size == 0) {
+			continue;
+		}
+		writer.AddRemoteFile(file.file_path, file_size,
+		                     QueryBlockCollector::GetFileRanges(*file_handle, file_size, file));
+	}
+	planner.Commit();
+}
+
+void ExportRemote(ClientContext &context, const string &pattern, PrewarmManifestWriter &writer) {
+	auto &fs = DatabaseInstance::GetDatabase(context).GetFileSystem();
+	auto block_size = GetInstanceStateOrThrow(context).config.cache_block_size;
+	auto plan = RemoteBlockCollector::CollectRemoteBlocks(fs, pattern, block_size);
+	for (const auto &file : plan.GetFiles()) {
+		writer.AddRemoteFile(file.file_path, file.file_size, {{0, file.file_size}});
+	}
+}
+
+void ExportTrace(ClientContext &context, const string &trace_path, PrewarmManifestWriter &writer) {
+	auto trace = BlockAccessTrace::Read(FileSystem::GetFileSystem(context), trace_path);
+	const auto &database_names = trace.GetDatabases();
+	vector<vector<block_id_t>> traced_blocks(database_names.size());
+	for (const auto &event : trace.GetEvents()) {
+		traced_blocks[event.database_index].push_back(event.block_id);
+	}
+	vector<BlockIdSet> database_blocks;
+	database_blocks.reserve(traced_blocks.size());
+	for (auto &blocks : traced_blocks) {
+		database_blocks.push_back(BlockIdSet::FromUnsorted(std::move(blocks)));
+	}
+	auto &db_manager = DatabaseManager::Get(DatabaseInstance::GetDatabase(context));
+	for (idx_t idx = 0; idx < database_names.size(); idx++) {
+		if (database_blocks[idx].empty()) {
+			continue;
+		}
+		auto database = db_manager.GetDatabase(database_names[idx]);
+		if (!database || database->GetStorageManager().InMemory()) {
+			DUCKDB_LOG_WARNING(context,
+			                   "prewarm_export_manifest: skipping %llu traced blocks of database '%s', it is not "
+			                   "attached",
+			                   database_blocks[idx].size(), database_names[idx]);
+			continue;
+		}
+		auto &block_manager = database->GetStorageManager().GetBlockManager();
+		if (trace.GetCheckpointStamps()[idx] != static_cast<uint64_t>(block_manager.GetMetaBlock())) {
+			DUCKDB_LOG_WARNING(context,
+			                   "prewarm_export_manifest: skipping %llu traced blocks of database '%s', it was "
+			                   "checkpointed since the trace was recorded",
+			                   database_blocks[idx].size(), database_names[idx]);
+			continue;
+		}
+		AddDatabaseSection(writer, *database, database_blocks[idx]);
+	}
+}
+
+//! Prewarm the blocks of a manifest database section, returns bytes prewarmed
+//! @param collection_us Time spent reading the manifest not yet recorded in the prewarm stats, reset once recorded
+idx_t PrewarmDatabaseSection(ClientContext &context, const PrewarmManifestDatabase &section, PrewarmMode mode,
+                             idx_t max_bytes, uint64_t &collection_us) {
+	auto &db_manager = DatabaseManager::Get(DatabaseInstance::GetDatabase(context));
+	auto database = db_manager.GetDatabase(section.database_name);
+	if (!database || database->GetStorageManager().InMemory()) {
+		DUCKDB_LOG_WARNING(context, "prewarm_manifest: skipping %llu blocks of database '%s', it is not attached",
+		                   section.block_count, section.database_name);
+		return 0;
+	}
+	auto &storage_manager = database->GetStorageManager();
+	auto &block_manager = storage_manager.GetBlockManager();
+	if (!section.database_path.empty() && section.database_path != storage_manager.GetDBPath()) {
+		DUCKDB_LOG_WARNING(context,
+		                   "prewarm_manifest: skipping database '%s', the manifest was exported from '%s' but it is "
+		                   "attached from '%s'",
+		                   section.database_name, section.database_path, storage_manager.GetDBPath());
+		return 0;
+	}
+	if (section.block_size != block_manager.GetBlockAllocSize()) {
+		DUCKDB_LOG_WARNING(context,
+		                   "prewarm_manifest: skipping database '%s', block size %llu does not match the manifest's "
+		                   "%llu",
+		                   section.database_name, block_manager.GetBlockAllocSize(), section.block_size);
+		return 0;
+	}
+	// Like replay: after a checkpoint the block ids may hold other data, warming them would load the wrong blocks
+	if (section.checkpoint_stamp != static_cast<uint64_t>(block_manager.GetMetaBlock())) {
+		DUCKDB_LOG_WARNING(context,
+		                   "prewarm_manifest: skipping database '%s', it was checkpointed since the manifest was "
+		                   "exported",
+		                   section.database_name);
+		return 0;
+	}
+
+	// Blocks past the end of the file cannot be loaded, drop them rather than trusting the manifest
+	auto decode_start = std::chrono::steady_clock::now();
+	const auto total_blocks = static_cast<block_id_t>(block_manager.TotalBlocks());
+	// Manifest sections store their blocks in ascending order
+	BlockIdSet block_ids;
+	for (auto block_id : section.DecodeBlockIds()) {
+		if (block_id >= total_blocks) {
+			break;
+		}
+		block_ids.Append(block_id);
+	}
+	if (block_ids.empty()) {
+		return 0;
+	}
+	collection_us += GetElapsedMicros(decode_start);
+	auto strategy = CreateLocalPrewarmStrategy(context, mode, block_manager, BufferManager::GetBufferManager(context));
+	auto bytes = strategy->Execute(*database, block_ids, max_bytes / section.block_size);
+	RecordPrewarmCall(context, database->GetName(), collection_us, *strategy);
+	collection_us = 0;
+	return bytes;
+}
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Manifest Scalar Function Implementation
+//===--------------------------------------------------------------------===//
+
+static void PrewarmExportManifestFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto path = GetStringArgument(args, 0, "prewarm_export_manifest", "manifest path");
+	auto source = GetStringArgument(args, 1, "prewarm_export_manifest", "source");
+	string source_type = "table";
+	if (args.ColumnCount() > 2) {
+		source_type = StringUtil::Lower(GetStringArgument(args, 2, "prewarm_export_manifest", "source type"));
+	}
+
+	PrewarmManifestWriter writer;
+	if (source_type == "table") {
+		ExportTable(context, source, writer);
+	} else if (source_type == "query") {
+		ExportQuery(context, source, writer);
+	} else if (source_type == "remote") {
+		ExportRemote(context, source, writer);
+	} else if (source_type == "trace") {
+		ExportTrace(context, source, writer);
+	} else {
+		throw InvalidInputException(
+		    "prewarm_export_manifest: unknown source type '%s', expected 'table', 'query', 'remote' or 'trace'",
+		    source_type);
+	}
+	writer.Write(FileSystem::GetFileSystem(context), path);
+	DUCKDB_LOG_INFO(context, "Exported %llu prewarm targets to manifest '%s'", writer.EntryCount(), path);
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<int64_t>(result)[0] = NumericCast<int64_t>(writer.EntryCount());
+}
+
+static void PrewarmManifestFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto path = GetStringArgument(args, 0, "prewarm_manifest", "manifest path");
+
+	// Parse prewarm mode (2nd argument), applies to database sections; remote files always go to cache_httpfs
+	PrewarmMode mode = PrewarmMode::BUFFER;
+	if (args.ColumnCount() > 1) {
+		mode = ParsePrewarmMode(args.GetValue(1, 0));
+	}
+	if (mode == PrewarmMode::PIN) {
+		throw InvalidInputException("prewarm_manifest: mode 'pin' is only supported by prewarm(), which pins a table "
+		                            "until prewarm_release()");
+	}
+
+	// Parse size limit (3rd argument), shared by database sections first and remote files after
+	idx_t remaining_bytes = NumericLimits<idx_t>::Maximum();
+	if (args.ColumnCount() > 2) {
+		auto size_val = args.GetValue(2, 0);
+		if (!size_val.IsNull()) {
+			remaining_bytes = ParseSizeLimit(size_val.ToString());
+		}
+	}
+
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto collection_start = std::chrono::steady_clock::now();
+	PrewarmManifestReader manifest(FileSystem::GetFileSystem(context), path);
+	// Reading the manifest is counted on the first section prewarmed
+	auto collection_us = GetElapsedMicros(collection_start);
+
+	idx_t bytes_prewarmed = 0;
+	for (const auto &section : manifest.GetDatabases()) {
+		auto bytes = PrewarmDatabaseSection(context, section, mode, remaining_bytes, collection_us);
+		bytes_prewarmed += bytes;
+		remaining_bytes -= MinValue(bytes, remaining_bytes);
+	}
+
+	if (!manifest.GetRemoteFiles().empty()) {
+		const idx_t block_size = GetInstanceStateOrThrow(context).config.cache_block_size;
+		RemoteBlockPlan plan(block_size);
+		for (const auto &remote_file : manifest.GetRemoteFiles()) {
+			plan.AddFileRanges(remote_file.file_path, remote_file.file_size, remote_file.DecodeRanges());
+		}
+		// OpenerFileSystem(fs) -> VirtualFileSystem -> CacheFileSystem
+		RemotePrewarmStrategy strategy(context, db.GetFileSystem());
+		auto remote_result = strategy.Execute(plan, remaining_bytes / block_size);
+		RecordPrewarmCall(context, /*database=*/"", collection_us, strategy);
+		bytes_prewarmed += remote_result.bytes_fetched;
+	}
+
+	DUCKDB_LOG_DEBUG(context, "prewarm_manifest: %llu databases, %llu remote files, %llu bytes prewarmed from '%s'",
+	                 manifest.GetDatabases().size(), manifest.GetRemoteFiles().size(), bytes_prewarmed, path);
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<int64_t>(result)[0] = NumericCast<int64_t>(bytes_prewarmed);
+}
+
+//===--------------------------------------------------------------------===//
+// Function Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterPrewarmManifestFunctions(ExtensionLoader &loader) {
+	// prewarm_export_manifest(path, source, [source_type]): write the targets of a table, query, remote glob or
+	// recorded trace to a manifest, returns the number of blocks and ranges written
+	ScalarFunctionSet export_set("prewarm_export_manifest");
+	export_set.AddFunction(ScalarFunction(/*arguments=*/ {/*path=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                      /*source=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                      /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                      PrewarmExportManifestFunction));
+	export_set.AddFunction(ScalarFunction(/*arguments=*/ {/*path=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                      /*source=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                      /*source_type=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                      /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                      PrewarmExportManifestFunction));
+	loader.RegisterFunction(export_set);
+
+	// prewarm_manifest(path, [mode], [max_size]): prewarm everything a manifest lists
+	ScalarFunctionSet manifest_set("prewarm_manifest");
+	manifest_set.AddFunction(ScalarFunction(/*arguments=*/ {/*path=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                        /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                        PrewarmManifestFunction));
+	manifest_set.AddFunction(ScalarFunction(/*arguments=*/ {/*path=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                        /*mode=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                        /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                        PrewarmManifestFunction));
+	// max_size as raw bytes (BIGINT)
+	manifest_set.AddFunction(ScalarFunction(/*arguments=*/ {/*path=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                        /*mode=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                        /*max_size=*/LogicalType {LogicalTypeId::BIGINT}},
+	                                        /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                        PrewarmManifestFunction));
+	// max_size as human-readable string like '1GB', '100MB'
+	manifest_set.AddFunction(ScalarFunction(/*arguments=*/ {/*path=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                        /*mode=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                        /*max_size=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                        /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                        PrewarmManifestFunction));
+	loader.RegisterFunction(manifest_set);
+}
+
+} // namespace duckdb
@@ -0,0 +1,55 @@
+#include "functions/prewarm_parquet_metadata_function.hpp"
+
+#include "core/parquet_metadata_prewarm_strategy.hpp"
+#include "core/prewarm_stats.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Prewarm Parquet Metadata Scalar Function Implementation
+//===--------------------------------------------------------------------===//
+namespace {
+
+void PrewarmParquetMetadataFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+
+	auto pattern_val = args.GetValue(0, 0);
+	if (pattern_val.IsNull()) {
+		throw InvalidInputException("Pattern cannot be NULL");
+	}
+	string pattern = pattern_val.ToString();
+
+	// Expanding the pattern is the collection phase
+	auto collection_start = std::chrono::steady_clock::now();
+	auto file_paths = ParquetMetadataPrewarmStrategy::ListFiles(context, pattern);
+	auto collection_us = GetElapsedMicros(collection_start);
+
+	ParquetMetadataPrewarmStrategy strategy(context);
+	idx_t files_cached = strategy.Execute(file_paths);
+	RecordPrewarmCall(context, /*database=*/"", collection_us, strategy);
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<int64_t>(result);
+	result_data[0] = NumericCast<int64_t>(files_cached);
+}
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Function Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterPrewarmParquetMetadataFunction(ExtensionLoader &loader) {
+	// Signature: prewarm_parquet_metadata(pattern), returns the number of files whose footer is cached
+	ScalarFunction prewarm_parquet_metadata("prewarm_parquet_metadata",
+	                                        /*arguments=*/ {/*pattern=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                        /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                        PrewarmParquetMetadataFunction);
+	loader.RegisterFunction(prewarm_parquet_metadata);
+}
+
+} // namespace duckdb
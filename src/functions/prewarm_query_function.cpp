@@ -0,0 +1,163 @@
+#include "functions/prewarm_query_function.hpp"
+
+#include "cache_httpfs_instance_state.hpp"
+#include "cache_prewarm_extension.hpp"
+#include "core/query_block_collector.hpp"
+#include "core/prewarm_stats.hpp"
+#include "core/prewarm_strategy_factory.hpp"
+#include "core/remote_block_collector.hpp"
+#include "core/remote_prewarm_strategy.hpp"
+#include "utils/include/parse_size.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+
+namespace duckdb {
+
+namespace {
+
+//! Build the remote block plan for the external files a query reads
+RemoteBlockPlan BuildRemoteBlockPlan(FileSystem &fs, const vector<QueryFileRanges> &files, idx_t block_size) {
+	RemoteBlockPlan plan(block_size);
+	for (const auto &file : files) {
+		auto file_handle =
+		    fs.OpenFile(file.file_path, FileOpenFlags::FILE_FLAGS_READ | FileOpenFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+		if (!file_handle) {
+			continue;
+		}
+		idx_t file_size = fs.GetFileSize(*file_handle);
+		if (file_size == 0) {
+			continue;
+		}
+		if (file.whole_file) {
+			plan.AddFile(file.file_path, file_size);
+			continue;
+		}
+		plan.AddFileRanges(file.file_path, file_size,
+		                   QueryBlockCollector::GetFileRanges(*file_handle, file_size, file));
+	}
+	return plan;
+}
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Prewarm Query Scalar Function Implementation
+//===--------------------------------------------------------------------===//
+
+static void PrewarmQueryFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+
+	auto query_val = args.GetValue(0, 0);
+	if (query_val.IsNull()) {
+		throw InvalidInputException("Query cannot be NULL");
+	}
+	string query = query_val.ToString();
+
+	// Parse prewarm mode (2nd argument), applies to DuckDB tables; remote files always go to cache_httpfs
+	PrewarmMode mode = PrewarmMode::BUFFER;
+	if (args.ColumnCount() > 1) {
+		mode = ParsePrewarmMode(args.GetValue(1, 0));
+	}
+	if (mode == PrewarmMode::PIN) {
+		throw InvalidInputException("prewarm_query: mode 'pin' is only supported by prewarm(), which pins a table "
+		                            "until prewarm_release()");
+	}
+
+	// Parse size limit (3rd argument), shared by DuckDB tables first and remote files after
+	idx_t remaining_bytes = NumericLimits<idx_t>::Maximum();
+	if (args.ColumnCount() > 2) {
+		auto size_val = args.GetValue(2, 0);
+		if (!size_val.IsNull()) {
+			remaining_bytes = ParseSizeLimit(size_val.ToString());
+		}
+	}
+
+	// Plan on a separate connection: this context is busy executing the statement that calls prewarm_query. The
+	// transaction keeps the scanned databases alive until prewarming is done.
+	auto &db = DatabaseInstance::GetDatabase(context);
+	Connection planner(db);
+	planner.BeginTransaction();
+	auto collection_start = std::chrono::steady_clock::now();
+	auto plan = QueryBlockCollector::CollectQueryBlocks(planner, query);
+	// Planning covers all databases and files of the query, it is counted on the first one prewarmed
+	auto collection_us = GetElapsedMicros(collection_start);
+
+	idx_t bytes_prewarmed = 0;
+	// One pass per attached database over the union of all blocks the query reads from it
+	for (auto &database : plan.databases) {
+		if (database.block_ids.empty()) {
+			continue;
+		}
+		auto &attached = database.database.get();
+		auto &block_manager = attached.GetStorageManager().GetBlockManager();
+		const idx_t block_size = block_manager.GetBlockAllocSize();
+		auto strategy =
+		    CreateLocalPrewarmStrategy(context, mode, block_manager, BufferManager::GetBufferManager(context));
+		auto bytes = strategy->Execute(attached, database.block_ids, remaining_bytes / block_size);
+		RecordPrewarmCall(context, attached.GetName(), collection_us, *strategy);
+		collection_us = 0;
+		bytes_prewarmed += bytes;
+		remaining_bytes -= MinValue(bytes, remaining_bytes);
+	}
+
+	if (!plan.files.empty()) {
+		auto &instance_state = GetInstanceStateOrThrow(context);
+		const idx_t block_size = instance_state.config.cache_block_size;
+		// OpenerFileSystem(fs) -> VirtualFileSystem -> CacheFileSystem
+		auto &fs = db.GetFileSystem();
+		auto remote_plan = BuildRemoteBlockPlan(fs, plan.files, block_size);
+		RemotePrewarmStrategy strategy(context, fs);
+		auto remote_result = strategy.Execute(remote_plan, remaining_bytes / block_size);
+		RecordPrewarmCall(context, /*database=*/"", collection_us, strategy);
+		bytes_prewarmed += remote_result.bytes_fetched;
+	}
+	planner.Commit();
+
+	DUCKDB_LOG_DEBUG(context, "prewarm_query: %llu databases, %llu remote files, %llu bytes prewarmed",
+	                 plan.databases.size(), plan.files.size(), bytes_prewarmed);
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	auto result_data = ConstantVector::GetData<int64_t>(result);
+	result_data[0] = NumericCast<int64_t>(bytes_prewarmed);
+}
+
+//===--------------------------------------------------------------------===//
+// Function Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterPrewarmQueryFunction(ExtensionLoader &loader) {
+	// Register prewarm_query scalar function
+	// Signature: prewarm_query(query, [mode], [max_size])
+	ScalarFunctionSet prewarm_query_set("prewarm_query");
+	// prewarm_query(query)
+	prewarm_query_set.AddFunction(ScalarFunction(/*arguments=*/ {/*query=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                             /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                             PrewarmQueryFunction));
+	// prewarm_query(query, mode)
+	prewarm_query_set.AddFunction(ScalarFunction(/*arguments=*/ {/*query=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                             /*mode=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                             /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                             PrewarmQueryFunction));
+	// prewarm_query(query, mode, max_size) - max_size as raw bytes (BIGINT)
+	prewarm_query_set.AddFunction(ScalarFunction(/*arguments=*/ {/*query=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                             /*mode=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                             /*max_size=*/LogicalType {LogicalTypeId::BIGINT}},
+	                                             /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                             PrewarmQueryFunction));
+	// prewarm_query(query, mode, max_size) - max_size as human-readable string like '1GB', '100MB'
+	prewarm_query_set.AddFunction(ScalarFunction(/*arguments=*/ {/*query=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                             /*mode=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                             /*max_size=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                             /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                             PrewarmQueryFunction));
+	loader.RegisterFunction(prewarm_query_set);
+}
+
+} // namespace duckdb
@@ -0,0 +1,178 @@
+#include "functions/prewarm_record_function.hpp"
+
+#include "cache_prewarm_extension.hpp"
+#include "core/block_access_recorder.hpp"
+#include "core/block_access_trace.hpp"
+#include "core/prewarm_stats.hpp"
+#include "core/replay_prewarm_strategy.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+namespace {
+
+shared_ptr<BlockAccessRecorder> GetRecorder(ClientContext &context) {
+	return context.registered_state->GetOrCreate<BlockAccessRecorder>(BlockAccessRecorder::STATE_KEY);
+}
+
+idx_t GetRecordIntervalMs(ClientContext &context) {
+	Value interval;
+	if (context.TryGetCurrentSetting(PREWARM_RECORD_INTERVAL_SETTING, interval) && !interval.IsNull()) {
+		return interval.GetValue<uint64_t>();
+	}
+	return DEFAULT_PREWARM_RECORD_INTERVAL_MS;
+}
+
+string GetPathArgument(DataChunk &args, const char *function_name) {
+	auto path_val = args.GetValue(0, 0);
+	if (path_val.IsNull()) {
+		throw InvalidInputException("%s: trace path cannot be NULL", function_name);
+	}
+	return path_val.ToString();
+}
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Record / Replay Scalar Function Implementation
+//===--------------------------------------------------------------------===//
+
+static void PrewarmRecordStartFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	GetRecorder(context)->Start(context, GetRecordIntervalMs(context));
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<bool>(result)[0] = true;
+}
+
+static void PrewarmRecordStopFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto path = GetPathArgument(args, "prewarm_record_stop");
+
+	auto trace = GetRecorder(context)->Stop();
+	auto &fs = FileSystem::GetFileSystem(context);
+	trace.Write(fs, path);
+	DUCKDB_LOG_INFO(context, "Recorded %llu block loads across %llu databases to '%s'", trace.GetEvents().size(),
+	                trace.GetDatabases().size(), path);
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<int64_t>(result)[0] = NumericCast<int64_t>(trace.GetEvents().size());
+}
+
+static void PrewarmReplayFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto path = GetPathArgument(args, "prewarm_replay");
+
+	// Optional time budget (2nd argument), no new blocks are scheduled once it is used up
+	idx_t time_budget_ms = 0;
+	if (args.ColumnCount() > 1) {
+		auto budget_val = args.GetValue(1, 0);
+		if (!budget_val.IsNull()) {
+			auto budget_us = Interval::GetMicro(budget_val.GetValue<interval_t>());
+			if (budget_us <= 0) {
+				throw InvalidInputException("prewarm_replay: time budget must be positive");
+			}
+			time_budget_ms = MaxValue<idx_t>(1, NumericCast<idx_t>(budget_us) / Interval::MICROS_PER_MSEC);
+		}
+	}
+
+	auto collection_start = std::chrono::steady_clock::now();
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto trace = BlockAccessTrace::Read(fs, path);
+
+	// Split per database, keeping first-access order within each of them
+	const auto &database_names = trace.GetDatabases();
+	vector<vector<block_id_t>> database_blocks(database_names.size());
+	vector<uint32_t> database_order;
+	for (const auto &event : trace.GetEvents()) {
+		auto &blocks = database_blocks[event.database_index];
+		if (blocks.empty()) {
+			database_order.push_back(event.database_index);
+		}
+		blocks.push_back(event.block_id);
+	}
+
+	// Reading and splitting the trace is counted on the first database replayed
+	auto collection_us = GetElapsedMicros(collection_start);
+	const auto start_time = std::chrono::steady_clock::now();
+	auto &db_manager = DatabaseManager::Get(DatabaseInstance::GetDatabase(context));
+	idx_t bytes_prewarmed = 0;
+	for (auto database_index : database_order) {
+		const auto &database_name = database_names[database_index];
+		idx_t remaining_ms = 0;
+		if (time_budget_ms > 0) {
+			auto elapsed_ms = static_cast<idx_t>(
+			    std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time)
+			        .count());
+			if (elapsed_ms >= time_budget_ms) {
+				break;
+			}
+			remaining_ms = time_budget_ms - elapsed_ms;
+		}
+		auto database = db_manager.GetDatabase(database_name);
+		if (!database || database->GetStorageManager().InMemory()) {
+			DUCKDB_LOG_WARNING(context, "prewarm_replay: skipping %llu blocks of database '%s', it is not attached",
+			                   database_blocks[database_index].size(), database_name);
+			continue;
+		}
+		auto &block_manager = database->GetStorageManager().GetBlockManager();
+		const auto checkpoint_stamp = static_cast<uint64_t>(block_manager.GetMetaBlock());
+		if (trace.GetCheckpointStamps()[database_index] != checkpoint_stamp) {
+			DUCKDB_LOG_WARNING(context,
+			                   "prewarm_replay: skipping %llu blocks of database '%s', it was checkpointed since the "
+			                   "trace was recorded",
+			                   database_blocks[database_index].size(), database_name);
+			continue;
+		}
+		ReplayPrewarmStrategy strategy(context, block_manager, BufferManager::GetBufferManager(context));
+		bytes_prewarmed +=
+		    strategy.Replay(database_blocks[database_index], NumericLimits<idx_t>::Maximum(), remaining_ms);
+		RecordPrewarmCall(context, database_name, collection_us, strategy);
+		collection_us = 0;
+	}
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<int64_t>(result)[0] = NumericCast<int64_t>(bytes_prewarmed);
+}
+
+//===--------------------------------------------------------------------===//
+// Function Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterPrewarmRecordFunctions(ExtensionLoader &loader) {
+	// prewarm_record_start(): start sampling block loads on this connection
+	loader.RegisterFunction(ScalarFunction("prewarm_record_start", /*arguments=*/ {},
+	                                       /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN},
+	                                       PrewarmRecordStartFunction));
+
+	// prewarm_record_stop(path): stop recording and write the trace, returns the number of recorded blocks
+	loader.RegisterFunction(ScalarFunction("prewarm_record_stop",
+	                                       /*arguments=*/ {/*path=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                       /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                       PrewarmRecordStopFunction));
+
+	// prewarm_replay(path, [time_budget]): load recorded blocks in first-access order
+	ScalarFunctionSet prewarm_replay_set("prewarm_replay");
+	prewarm_replay_set.AddFunction(ScalarFunction(/*arguments=*/ {/*path=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                              /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                              PrewarmReplayFunction));
+	prewarm_replay_set.AddFunction(ScalarFunction(/*arguments=*/ {/*path=*/LogicalType {LogicalTypeId::VARCHAR},
+	                                                              /*time_budget=*/LogicalType {LogicalTypeId::INTERVAL}},
+	                                              /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                              PrewarmReplayFunction));
+	loader.RegisterFunction(prewarm_replay_set);
+}
+
+} // namespace duckdb
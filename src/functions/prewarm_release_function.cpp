@@ -0,0 +1,52 @@
+#include "functions/prewarm_release_function.hpp"
+
+#include "core/block_collector.hpp"
+#include "core/pinned_blocks.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Prewarm Release Scalar Function Implementation
+//===--------------------------------------------------------------------===//
+
+static void PrewarmReleaseFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto registry = context.registered_state->GetOrCreate<PinnedBlockRegistry>(PinnedBlockRegistry::STATE_KEY);
+
+	idx_t bytes_released;
+	if (args.ColumnCount() == 0) {
+		bytes_released = registry->ReleaseAll();
+	} else {
+		auto table_val = args.GetValue(0, 0);
+		if (table_val.IsNull()) {
+			throw InvalidInputException("prewarm_release: table name cannot be NULL");
+		}
+		// The table may have been dropped since, so it is not looked up
+		bytes_released = registry->Release(BlockCollector::QualifyTableName(context, table_val.ToString()));
+	}
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<int64_t>(result)[0] = NumericCast<int64_t>(bytes_released);
+}
+
+//===--------------------------------------------------------------------===//
+// Function Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterPrewarmReleaseFunction(ExtensionLoader &loader) {
+	// prewarm_release([table]): unpin a table pinned by prewarm(table, 'pin'), or all pinned tables of the
+	// connection, returns the bytes unpinned
+	ScalarFunctionSet release_set("prewarm_release");
+	release_set.AddFunction(ScalarFunction(/*arguments=*/ {}, /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                       PrewarmReleaseFunction));
+	release_set.AddFunction(ScalarFunction(/*arguments=*/ {/*table=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                                       /*return_type=*/LogicalType {LogicalTypeId::BIGINT},
+	                                       PrewarmReleaseFunction));
+	loader.RegisterFunction(release_set);
+}
+
+} // namespace duckdb
@@ -1,7 +1,7 @@
 #include "functions/prewarm_remote_function.hpp"
 
 #include "cache_httpfs_instance_state.hpp"
-#include "core/remote_block_collector.hpp"
+#include "core/prewarm_stats.hpp"
 #include "core/remote_prewarm_strategy.hpp"
 #include "utils/include/parse_size.hpp"
 
@@ -49,15 +49,13 @@ void PrewarmRemoteFunction(DataChunk &args, ExpressionState &state, Vector &resu
 	// OpenerFileSystem(fs) -> VirtualFileSystem -> CacheFileSystem
 	auto &fs = db.GetFileSystem();
 
-	// Collect remote blocks
-	auto blocks = RemoteBlockCollector::CollectRemoteBlocks(fs, pattern, block_size);
-
-	// Execute prewarm strategy
-	idx_t bytes_prewarmed = 0;
-	if (!blocks.empty()) {
-		RemotePrewarmStrategy strategy(context, fs);
-		bytes_prewarmed = strategy.Execute(blocks, max_blocks);
-	}
+	// Stream listing, per-file block planning and fetching through a bounded pipeline
+	// Blocks that keep failing after retries are skipped and not counted in the result
+	RemotePrewarmStrategy strategy(context, fs);
+	auto prewarm_result = strategy.Execute(pattern, block_size, max_blocks);
+	// Listing and planning overlap with fetching, they are counted as I/O time
+	RecordPrewarmCall(context, /*database=*/"", /*collection_us=*/0, strategy);
+	idx_t bytes_prewarmed = prewarm_result.bytes_fetched;
 
 	result.SetVectorType(VectorType::CONSTANT_VECTOR);
 	auto result_data = ConstantVector::GetData<int64_t>(result);
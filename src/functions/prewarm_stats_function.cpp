@@ -0,0 +1,155 @@
+#include "functions/prewarm_stats_function.hpp"
+
+#include "cache_prewarm_extension.hpp"
+#include "core/prewarm_stats.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+namespace duckdb {
+
+namespace {
+
+//! Quantiles of the task latency histogram reported as columns
+constexpr double PREWARM_STATS_P50 = 0.5;
+constexpr double PREWARM_STATS_P99 = 0.99;
+
+struct PrewarmStatsGlobalState : public GlobalTableFunctionState {
+	vector<PrewarmStatsEntry> entries;
+	idx_t offset = 0;
+};
+
+unique_ptr<FunctionData> PrewarmStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                          vector<LogicalType> &return_types, vector<string> &names) {
+	names = {"strategy",
+	         "database",
+	         "calls",
+	         "blocks_planned",
+	         "blocks_resident",
+	         "blocks_loaded",
+	         "blocks_skipped",
+	         "blocks_throttled",
+	         "bytes_loaded",
+	         "bytes_failed",
+	         "collection_time_us",
+	         "register_time_us",
+	         "sort_time_us",
+	         "io_time_us",
+	         "first_load_time_us",
+	         "call_p50_us",
+	         "call_p99_us",
+	         "tasks",
+	         "task_p50_us",
+	         "task_p99_us",
+	         "task_max_us"};
+	return_types = {LogicalType {LogicalTypeId::VARCHAR}, LogicalType {LogicalTypeId::VARCHAR}};
+	while (return_types.size() < names.size()) {
+		return_types.emplace_back(LogicalTypeId::UBIGINT);
+	}
+	return make_uniq<TableFunctionData>();
+}
+
+unique_ptr<GlobalTableFunctionState> PrewarmStatsInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto state = make_uniq<PrewarmStatsGlobalState>();
+	state->entries = PrewarmStatsRegistry::Get().GetEntries();
+	return std::move(state);
+}
+
+void PrewarmStatsFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<PrewarmStatsGlobalState>();
+	idx_t count = 0;
+	while (state.offset < state.entries.size() && count < STANDARD_VECTOR_SIZE) {
+		const auto &entry = state.entries[state.offset++];
+		idx_t col = 0;
+		output.SetValue(col++, count, Value(entry.strategy));
+		output.SetValue(col++, count, entry.database.empty() ? Value() : Value(entry.database));
+		output.SetValue(col++, count, Value::UBIGINT(entry.calls));
+		output.SetValue(col++, count, Value::UBIGINT(entry.blocks_planned));
+		output.SetValue(col++, count, Value::UBIGINT(entry.blocks_resident));
+		output.SetValue(col++, count, Value::UBIGINT(entry.blocks_loaded));
+		output.SetValue(col++, count, Value::UBIGINT(entry.blocks_skipped));
+		output.SetValue(col++, count, Value::UBIGINT(entry.blocks_throttled));
+		output.SetValue(col++, count, Value::UBIGINT(entry.bytes_loaded));
+		output.SetValue(col++, count, Value::UBIGINT(entry.bytes_failed));
+		output.SetValue(col++, count, Value::UBIGINT(entry.collection_us));
+		output.SetValue(col++, count, Value::UBIGINT(entry.register_us));
+		output.SetValue(col++, count, Value::UBIGINT(entry.sort_us));
+		output.SetValue(col++, count, Value::UBIGINT(entry.io_us));
+		output.SetValue(col++, count, Value::UBIGINT(entry.first_load_us));
+		output.SetValue(col++, count, Value::UBIGINT(entry.call_latency.GetQuantile(PREWARM_STATS_P50)));
+		output.SetValue(col++, count, Value::UBIGINT(entry.call_latency.GetQuantile(PREWARM_STATS_P99)));
+		output.SetValue(col++, count, Value::UBIGINT(entry.task_latency.GetCount()));
+		output.SetValue(col++, count, Value::UBIGINT(entry.task_latency.GetQuantile(PREWARM_STATS_P50)));
+		output.SetValue(col++, count, Value::UBIGINT(entry.task_latency.GetQuantile(PREWARM_STATS_P99)));
+		output.SetValue(col++, count, Value::UBIGINT(entry.task_latency.GetMaxUs()));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+void PrewarmStatsResetFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	PrewarmStatsRegistry::Get().Reset();
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<bool>(result)[0] = true;
+}
+
+idx_t GetTextfileIntervalMs(ClientContext &context) {
+	Value interval;
+	if (context.TryGetCurrentSetting(PREWARM_STATS_TEXTFILE_INTERVAL_SETTING, interval) && !interval.IsNull()) {
+		return interval.GetValue<uint64_t>();
+	}
+	return DEFAULT_PREWARM_STATS_TEXTFILE_INTERVAL_MS;
+}
+
+string GetTextfilePath(ClientContext &context) {
+	Value path;
+	if (context.TryGetCurrentSetting(PREWARM_STATS_TEXTFILE_SETTING, path) && !path.IsNull()) {
+		return path.ToString();
+	}
+	return "";
+}
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Setting Callbacks
+//===--------------------------------------------------------------------===//
+
+void SetPrewarmStatsTextfile(ClientContext &context, SetScope scope, Value &parameter) {
+	auto path = parameter.IsNull() ? string() : parameter.ToString();
+	PrewarmStatsRegistry::Get().ConfigureTextfile(FileSystem::GetFileSystem(context), path,
+	                                              GetTextfileIntervalMs(context));
+}
+
+void SetPrewarmStatsTextfileInterval(ClientContext &context, SetScope scope, Value &parameter) {
+	auto interval_ms = parameter.IsNull() ? DEFAULT_PREWARM_STATS_TEXTFILE_INTERVAL_MS : parameter.GetValue<uint64_t>();
+	if (interval_ms == 0) {
+		throw InvalidInputException("%s must be positive", PREWARM_STATS_TEXTFILE_INTERVAL_SETTING);
+	}
+	auto path = GetTextfilePath(context);
+	if (!path.empty()) {
+		PrewarmStatsRegistry::Get().ConfigureTextfile(FileSystem::GetFileSystem(context), path, interval_ms);
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Function Registration
+//===--------------------------------------------------------------------===//
+
+void RegisterPrewarmStatsFunctions(ExtensionLoader &loader) {
+	// prewarm_stats(): cumulative counters and latency quantiles per strategy and database
+	TableFunction prewarm_stats("prewarm_stats", /*arguments=*/ {}, PrewarmStatsFunction, PrewarmStatsBind,
+	                            PrewarmStatsInit);
+	loader.RegisterFunction(prewarm_stats);
+
+	// prewarm_stats_reset(): drop all counters
+	loader.RegisterFunction(ScalarFunction("prewarm_stats_reset", /*arguments=*/ {},
+	                                       /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN},
+	                                       PrewarmStatsResetFunction));
+}
+
+} // namespace duckdb
@@ -7,11 +7,39 @@ namespace duckdb {
 // Load cache_httpfs extension if not already loaded.
 void LoadCacheHttpfsExtensionIfNeeded(ExtensionLoader &loader);
 
+//! Setting: maximum number of remote files prewarm_remote keeps open concurrently
+constexpr const char *PREWARM_REMOTE_MAX_OPEN_FILES_SETTING = "prewarm_remote_max_open_files";
+constexpr idx_t DEFAULT_PREWARM_REMOTE_MAX_OPEN_FILES = 64;
+
+//! Setting: bytes per local prewarm task (0 = each strategy's default batch size)
+constexpr const char *PREWARM_BATCH_BYTES_SETTING = "prewarm_batch_bytes";
+
+//! Setting: how often prewarm_record_start() samples block residency, in milliseconds
+constexpr const char *PREWARM_RECORD_INTERVAL_SETTING = "prewarm_record_interval_ms";
+constexpr idx_t DEFAULT_PREWARM_RECORD_INTERVAL_MS = 100;
+
+//! Setting: combined reload rate of all prewarm_keep() policies of a connection, in bytes per second (0 = unlimited)
+constexpr const char *PREWARM_KEEP_MAX_BYTES_PER_SEC_SETTING = "prewarm_keep_max_bytes_per_sec";
+constexpr idx_t DEFAULT_PREWARM_KEEP_MAX_BYTES_PER_SEC = 256ULL * 1024ULL * 1024ULL;
+//! How often prewarm_keep() checks a table when no interval is given, in milliseconds
+constexpr idx_t DEFAULT_PREWARM_KEEP_INTERVAL_MS = 30000;
+
+//! Setting: file the prewarm statistics are periodically written to in the Prometheus text format ('' = disabled)
+constexpr const char *PREWARM_STATS_TEXTFILE_SETTING = "prewarm_stats_textfile";
+//! Setting: how often the prewarm statistics textfile is rewritten, in milliseconds
+constexpr const char *PREWARM_STATS_TEXTFILE_INTERVAL_SETTING = "prewarm_stats_textfile_interval_ms";
+constexpr idx_t DEFAULT_PREWARM_STATS_TEXTFILE_INTERVAL_MS = 15000;
+
+//! Setting: cap on the bytes pinned by 'pin' mode across all connections, as a fraction of memory_limit
+constexpr const char *PREWARM_PIN_MAX_MEMORY_FRACTION_SETTING = "prewarm_pin_max_memory_fraction";
+constexpr double DEFAULT_PREWARM_PIN_MAX_MEMORY_FRACTION = 0.5;
+
 //! Prewarm operation modes (matching PostgreSQL pg_prewarm)
 enum class PrewarmMode {
 	PREFETCH, // Load into DuckDB buffer pool via batched reads (blocks not pinned, may be evicted)
 	READ,     // Synchronously read from disk into temporary process memory (not buffer pool, buffer freed immediately)
-	BUFFER    // Load into DuckDB buffer pool and pin/unpin (default, blocks stay longer)
+	BUFFER,   // Load into DuckDB buffer pool and pin/unpin (default, blocks stay longer)
+	PIN       // Load into DuckDB buffer pool and keep pinned until prewarm_release() or the connection closes
 };
 
 class CachePrewarmExtension : public Extension {
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "core/block_access_trace.hpp"
+
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/main/client_context_state.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+namespace duckdb {
+
+class AttachedDatabase;
+class BlockManager;
+
+//===--------------------------------------------------------------------===//
+// Block Access Recorder
+//===--------------------------------------------------------------------===//
+
+//! Records persistent blocks loaded into the buffer pool between prewarm_record_start() and prewarm_record_stop().
+//! DuckDB offers no hook on buffer-manager loads, so a background thread samples block residency of every attached
+//! database file at a fixed interval and logs each block the first time it shows up as newly loaded. Every sample
+//! checks at most RECORDER_BLOCKS_PER_SAMPLE blocks and picks up where the previous one stopped, so files larger than
+//! that are swept over several intervals. Blocks already resident when recording starts are only logged if they are
+//! evicted and loaded again. A block loaded and evicted within one sweep is missed, and access times are accurate to
+//! the sweep.
+//! The recorder belongs to the connection that started it; closing the connection stops it.
+class BlockAccessRecorder : public ClientContextState {
+public:
+	static constexpr const char *STATE_KEY = "cache_prewarm_block_access_recorder";
+	//! Blocks checked per periodic sample across all recorded databases, each check is a lookup in the block
+	//! manager's registry under its lock
+	static constexpr idx_t RECORDER_BLOCKS_PER_SAMPLE = 16384;
+
+	~BlockAccessRecorder() override;
+
+	//! Start recording all attached database files
+	//! @throws InvalidInputException if this connection is already recording
+	void Start(ClientContext &context, idx_t interval_ms);
+	//! Stop recording and return the trace
+	//! @throws InvalidInputException if this connection is not recording
+	BlockAccessTrace Stop();
+	bool IsRecording() const;
+
+private:
+	struct RecordedDatabase {
+		shared_ptr<AttachedDatabase> database;
+		uint32_t trace_index;
+		//! Blocks loaded at the previous sample
+		unordered_set<block_id_t> loaded_blocks;
+		//! Blocks already logged, only the first access is recorded
+		unordered_set<block_id_t> recorded_blocks;
+	};
+
+	void PollLoop();
+	//! Sample residency of every block of every recorded database
+	void SampleAll(bool baseline);
+	//! Sample the next RECORDER_BLOCKS_PER_SAMPLE blocks, continuing where the previous sample stopped
+	void SampleNext();
+	//! Check one block and log it if it was loaded since the previous check
+	void SampleBlock(RecordedDatabase &recorded, BlockManager &block_manager, block_id_t block_id, bool baseline,
+	                 uint64_t elapsed_us);
+	uint64_t GetElapsedUs() const;
+	void StopPoller();
+
+	mutable mutex mu;
+	std::condition_variable stop_cv;
+	bool stop_requested = false;
+	bool recording = false;
+	std::thread poller;
+	idx_t interval_ms = 0;
+	std::chrono::steady_clock::time_point start_time;
+	vector<RecordedDatabase> databases;
+	//! Database and block the next periodic sample starts at
+	idx_t next_database = 0;
+	block_id_t next_block = 0;
+	BlockAccessTrace trace;
+};
+
+} // namespace duckdb
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/storage/storage_info.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Block Access Trace
+//===--------------------------------------------------------------------===//
+
+//! First load of a persistent block observed while recording
+struct BlockAccessEvent {
+	//! Index into BlockAccessTrace::databases
+	uint32_t database_index;
+	block_id_t block_id;
+	//! Microseconds since recording started
+	uint64_t first_access_us;
+};
+
+//! Persistent blocks a workload loaded, in first-access order.
+//! On disk: magic "DPWTRACE", uint32 version, uint32 database count, per database a length-prefixed name and uint64
+//! checkpoint stamp, uint64 event count and fixed-size events, all little-endian.
+class BlockAccessTrace {
+public:
+	//! Add a database and return its index
+	//! @param checkpoint_stamp Meta block of the database when recording started, it moves with every checkpoint
+	uint32_t AddDatabase(string database_name, uint64_t checkpoint_stamp);
+	//! Append an event, first_access_us must not decrease
+	void AddEvent(uint32_t database_index, block_id_t block_id, uint64_t first_access_us);
+
+	const vector<string> &GetDatabases() const {
+		return databases;
+	}
+	const vector<uint64_t> &GetCheckpointStamps() const {
+		return checkpoint_stamps;
+	}
+	const vector<BlockAccessEvent> &GetEvents() const {
+		return events;
+	}
+
+	//! Write the trace, replacing an existing file
+	void Write(FileSystem &fs, const string &path) const;
+	//! Read a trace written by Write()
+	//! @throws InvalidInputException if the file is not a valid trace
+	static BlockAccessTrace Read(FileSystem &fs, const string &path);
+
+private:
+	vector<string> databases;
+	vector<uint64_t> checkpoint_stamps;
+	vector<BlockAccessEvent> events;
+};
+
+} // namespace duckdb
@@ -4,19 +4,76 @@
 #include "cache_prewarm_extension.hpp"
 #include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
 #include "duckdb/common/unordered_set.hpp"
+#include "duckdb/main/attached_database.hpp"
 #include "duckdb/storage/storage_info.hpp"
+#include "utils/include/block_id_set.hpp"
 
 namespace duckdb {
 
+class DataTable;
+class RowGroup;
+
 //===--------------------------------------------------------------------===//
 // Block Collector
 //===--------------------------------------------------------------------===//
 
+//! A DuckDB table resolved from a possibly qualified name
+struct ResolvedTable {
+	shared_ptr<AttachedDatabase> database;
+	reference<DuckTableEntry> table;
+	//! "database.schema.table"
+	string qualified_name;
+};
+
 //! Collects block IDs from a table's column segments
 class BlockCollector {
 public:
+	//! Resolve "table", "schema.table" or "database.schema.table" against the default database and "main" schema
+	//! @throws InvalidInputException if the database is not attached, CatalogException if the table does not exist
+	static ResolvedTable ResolveTable(ClientContext &context, const string &table_name);
+	//! Qualify a table name the way ResolveTable() does, without looking the table up
+	static string QualifyTableName(ClientContext &context, const string &table_name);
 	//! Collect block IDs from a table entry and return them
-	static unordered_set<block_id_t> CollectTableBlocks(ClientContext &context, DuckTableEntry &table_entry);
+	//! Ranges of row groups are collected in parallel on the TaskScheduler and merged.
+	static BlockIdSet CollectTableBlocks(ClientContext &context, DuckTableEntry &table_entry);
+	//! Row groups of a table in storage order, so that the position of a row group is the row_group_index its
+	//! ColumnSegmentInfo reports. Needs an active transaction.
+	static vector<reference<RowGroup>> GetRowGroups(ClientContext &context, DataTable &storage);
+	//! Collect the block IDs of the row groups [start, end) of GetRowGroups()
+	static BlockIdSet CollectRowGroupBlocks(ClientContext &context, const vector<reference<RowGroup>> &row_groups,
+	                                        idx_t start, idx_t end);
+};
+
+//! Blocks of a table, collected batch by batch of row groups on the calling thread so that a prewarm can load the
+//! first batches while later row groups are still collected. Only the segment infos of one row group are in memory at
+//! a time. Row groups may share blocks; every block is returned in one batch only.
+class TableBlockStream {
+public:
+	//! Needs an active transaction for as long as the stream is used
+	TableBlockStream(ClientContext &context, DuckTableEntry &table_entry);
+
+	//! Collect row groups until at least this many new blocks were found, 1 by default
+	void SetMinBatchBlocks(idx_t min_batch_blocks_p) {
+		min_batch_blocks = MaxValue<idx_t>(min_batch_blocks_p, 1);
+	}
+
+	//! Collect the next batch of blocks
+	//! @return false once all row groups have been collected
+	bool Next(BlockIdSet &batch);
+
+	//! Time spent in Next() so far, in microseconds
+	uint64_t GetCollectionMicros() const {
+		return collection_us;
+	}
+
+private:
+	ClientContext &context;
+	vector<reference<RowGroup>> row_groups;
+	idx_t next_row_group = 0;
+	idx_t min_batch_blocks = 1;
+	//! Blocks returned so far
+	BlockIdSet collected;
+	uint64_t collection_us = 0;
 };
 
 } // namespace duckdb
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "utils/include/block_id_set.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/storage/storage_info.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Block Evictor
+//===--------------------------------------------------------------------===//
+
+//! Where prewarm_evict() drops blocks from
+enum class EvictMode {
+	BUFFER, // Unload unpinned blocks from DuckDB's buffer pool
+	OS,     // Advise the OS to drop the blocks' extents of the database file from its page cache
+	ALL     // Both (default)
+};
+
+//! Parse an evict mode argument, NULL selects the default ALL mode
+EvictMode ParseEvictMode(const Value &mode_val);
+
+//! The inverse of the prewarm strategies: cools down the blocks of a database
+class BlockEvictor {
+public:
+	//! Drop the given blocks from the layers of `mode`, the buffer pool first: unloading does not write clean
+	//! persistent blocks back, so the page cache stays cold
+	//! @return Bytes of the blocks dropped from at least one layer, a block dropped from both counts once
+	static idx_t Evict(AttachedDatabase &database, const BlockIdSet &block_ids, EvictMode mode);
+	//! Unload the given blocks from the buffer pool. Pinned blocks and blocks that are not loaded are skipped.
+	//! @return The unloaded blocks, in ascending order
+	static vector<block_id_t> EvictFromBufferPool(AttachedDatabase &database, const BlockIdSet &block_ids);
+	//! Advise the OS to drop the given blocks from its page cache, dirty pages are kept by the kernel. Blocks without
+	//! pages in the page cache are skipped.
+	//! @return The advised blocks, in ascending order; empty outside Linux
+	static vector<block_id_t> EvictFromPageCache(AttachedDatabase &database, const BlockIdSet &block_ids);
+};
+
+} // namespace duckdb
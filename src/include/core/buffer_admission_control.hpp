@@ -0,0 +1,82 @@
+#pragma once
+
+#include "core/prewarm_strategy.hpp"
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/deque.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+class BlockHandle;
+class BufferManager;
+
+//===--------------------------------------------------------------------===//
+// Buffer Admission Control
+//===--------------------------------------------------------------------===//
+
+//! Why a buffer prewarm stopped loading before its budget ran out
+enum class AdmissionStopReason : uint8_t {
+	NONE,
+	//! Concurrent allocations used up the headroom the prewarm was planned with
+	MEMORY_PRESSURE,
+	//! The buffer manager evicted blocks loaded earlier by the same prewarm
+	EVICTION
+};
+
+//! Decides batch by batch whether a buffer prewarm may load more blocks. The budget computed before I/O is a
+//! snapshot; queries allocating while a long prewarm runs shrink the free memory, and loading on regardless makes the
+//! buffer manager evict, first other queries' blocks and then the prewarm's own earlier batches. A batch is refused
+//! once buffer pool usage would pass the level the prewarm was planned to reach, or once the buffer manager evicted
+//! more than a small share of the earlier batches. The first refusal stops admission for the rest of the prewarm.
+class BufferAdmissionControl {
+public:
+	//! @param capacity_info Buffer pool snapshot the budget was computed from; the usage limit is its used space plus
+	//! its max blocks
+	BufferAdmissionControl(BufferManager &buffer_manager_p, const BufferCapacityInfo &capacity_info);
+
+	//! Admit a batch of `blocks` blocks, thread-safe
+	//! Concurrent callers check usage before any of them loads, so usage can pass the limit by one batch per task,
+	//! well within the headroom left by the budget.
+	//! @return false if loading the batch would evict or admission stopped before
+	bool Admit(idx_t blocks);
+
+	//! Watch the first loaded block of a batch for eviction, thread-safe
+	//! Batches without a loaded block are not watched.
+	void Track(const vector<shared_ptr<BlockHandle>> &batch);
+
+	AdmissionStopReason GetStopReason() const {
+		return stop_reason.load();
+	}
+
+	//! Buffer pool usage at which batches are refused, in bytes
+	idx_t GetUsageLimit() const {
+		return usage_limit;
+	}
+
+	static string StopReasonToString(AdmissionStopReason reason);
+
+private:
+	//! Check a few watched blocks and whether the share of evicted batches passed the limit. Evicted blocks and blocks
+	//! nobody refers to anymore are dropped from the watch list, the others are checked again later.
+	bool EvictionStarted();
+
+	void Stop(AdmissionStopReason reason);
+
+	BufferManager &buffer_manager;
+	const idx_t block_size;
+	const idx_t usage_limit;
+	atomic<AdmissionStopReason> stop_reason {AdmissionStopReason::NONE};
+
+	//! First loaded block of every batch, in the order they are checked; watched_lock guards all three
+	mutex watched_lock;
+	deque<weak_ptr<BlockHandle>> watched;
+	//! Batches tracked and not dropped as stale, and the ones whose block was evicted
+	idx_t watched_batches = 0;
+	idx_t evicted_batches = 0;
+};
+
+} // namespace duckdb
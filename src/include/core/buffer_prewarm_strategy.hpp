@@ -4,6 +4,8 @@
 
 namespace duckdb {
 
+class TableBlockStream;
+
 //! Prewarm strategy: Load blocks into buffer pool
 class BufferPrewarmStrategy : public LocalPrewarmStrategy {
 public:
@@ -11,7 +13,29 @@ public:
 	    : LocalPrewarmStrategy(context_p, block_manager_p, buffer_manager_p) {
 	}
 
-	idx_t Execute(DuckTableEntry &table_entry, const unordered_set<block_id_t> &block_ids, idx_t max_blocks) override;
+	string GetName() const override {
+		return "buffer";
+	}
+
+	idx_t Execute(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) override;
+
+	//! Load the blocks of a table while they are collected: the calling thread collects batches of row groups into a
+	//! bounded queue and I/O tasks load them, so the first blocks load before the last row groups are collected. Once
+	//! the budget is used up or admission stops, the rest of the table is not collected; blocks_planned counts the
+	//! collected blocks.
+	idx_t ExecuteStream(AttachedDatabase &database, TableBlockStream &stream, idx_t max_blocks);
+
+private:
+	struct BufferLoad;
+
+	//! Register a run of consecutive blocks, filter out resident ones and load the rest within the budget
+	//! @return false once nothing more will be loaded, because the budget is used up or admission stopped
+	bool LoadChunk(block_id_t first_block, idx_t count, BufferLoad &load);
+
+	//! Log the limits hit and add the counts of a finished load to the execution stats
+	//! @param blocks_planned Blocks requested, including the ones never registered once loading stopped
+	//! @return Bytes loaded
+	idx_t FinishLoad(BufferLoad &load, idx_t blocks_planned);
 };
 
 } // namespace duckdb
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "core/work_queue.hpp"
+
+#include "duckdb/common/vector.hpp"
+#include "duckdb/storage/storage_info.hpp"
+#include "utils/include/block_id_set.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+class ClientContext;
+
+//===--------------------------------------------------------------------===//
+// Extent Scheduler
+//===--------------------------------------------------------------------===//
+
+//! Run of consecutive blocks claimed by one worker
+struct ExtentChunk {
+	//! Position of the first block in the plan
+	idx_t offset;
+	block_id_t first_block;
+	idx_t count;
+};
+
+//! Hands out the blocks of a prewarm plan to worker threads in chunks. The plan is split into extents of consecutive
+//! blocks and every extent into chunks of at most `chunk_blocks`, so a chunk is always one contiguous I/O. The chunks
+//! are handed out through a WorkQueue, in ascending block order.
+class ExtentScheduler {
+public:
+	//! @param block_ids Blocks of the plan in ascending order
+	//! @param chunk_blocks Maximum blocks per chunk, at least 1
+	ExtentScheduler(const vector<block_id_t> &block_ids, idx_t chunk_blocks);
+	//! Chunk the extents of a block set directly, without expanding it into single blocks
+	ExtentScheduler(const BlockIdSet &block_ids, idx_t chunk_blocks);
+
+	//! Claim the next chunk, thread-safe
+	//! @return false when all chunks have been claimed or the scheduler was cancelled
+	bool Next(ExtentChunk &chunk);
+
+	//! Stop handing out chunks, e.g. once the budget of a prewarm is used up; workers finish the chunk they hold
+	void Cancel() {
+		queue.Cancel();
+	}
+
+	idx_t ChunkCount() const {
+		return chunks.size();
+	}
+
+	//! Process every chunk on up to `max_workers` tasks of the TaskScheduler, including the calling thread
+	//! Exceptions thrown by `process` are rethrown once all workers have stopped.
+	void Run(ClientContext &context, idx_t max_workers, const std::function<void(const ExtentChunk &)> &process);
+
+private:
+	static vector<ExtentChunk> ChunkBlocks(const vector<block_id_t> &block_ids, idx_t chunk_blocks);
+	static vector<ExtentChunk> ChunkBlocks(const BlockIdSet &block_ids, idx_t chunk_blocks);
+
+	const vector<ExtentChunk> chunks;
+	WorkQueue queue;
+};
+
+} // namespace duckdb
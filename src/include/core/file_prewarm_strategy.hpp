@@ -0,0 +1,61 @@
+#pragma once
+
+#include "cache_prewarm_extension.hpp"
+#include "core/prewarm_strategy.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Local File Prewarm Strategy
+//===--------------------------------------------------------------------===//
+
+//! A local file matched by a prewarm_file() pattern
+struct LocalFileInfo {
+	string path;
+	idx_t size;
+};
+
+//! Byte range of a local file loaded by one I/O task
+struct LocalFileChunk {
+	//! Index of the file in the plan
+	idx_t file_idx;
+	idx_t offset;
+	idx_t length;
+};
+
+//! Strategy for warming the OS page cache with arbitrary local files (Parquet, CSV, JSON, ...) that are read outside
+//! the buffer pool. Files are split into chunks of the batch size, which tasks claim one at a time so that small and
+//! large files are loaded in parallel. Every chunk counts as one block in the execution stats.
+class FilePrewarmStrategy : public PrewarmStrategy {
+public:
+	//! @param mode PREFETCH to issue OS prefetch hints or READ to read the files synchronously; BUFFER is rejected
+	//! because the buffer pool only caches database blocks
+	FilePrewarmStrategy(ClientContext &context_p, PrewarmMode mode_p);
+
+	string GetName() const override;
+
+	//! Expand a glob pattern into the matching local files, ordered by path, through the client file system so that
+	//! enable_external_access and allowed_directories apply
+	//! @throws InvalidInputException for remote paths and patterns that match no file
+	static vector<LocalFileInfo> ListFiles(ClientContext &context, const string &pattern);
+
+	//! Load the given files in order, up to a byte budget
+	//! @param max_bytes Maximum bytes to load, lowered to the page cache budget; a file over the budget is loaded
+	//! partially
+	//! @return Bytes loaded
+	idx_t Execute(const vector<LocalFileInfo> &files, idx_t max_bytes);
+
+protected:
+	//! The page cache is not bounded by the buffer pool, Execute() applies the page cache budget instead
+	BufferCapacityInfo CalculateMaxAvailableBlocks() override;
+
+	//! Load one chunk
+	//! @return Bytes loaded, 0 if the hint or read failed
+	idx_t LoadChunk(const LocalFileInfo &file, const LocalFileChunk &chunk);
+
+	PrewarmMode mode;
+};
+
+} // namespace duckdb
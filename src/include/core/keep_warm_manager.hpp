@@ -0,0 +1,87 @@
+#pragma once
+
+#include "cache_prewarm_extension.hpp"
+
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include "duckdb/storage/storage_info.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+namespace duckdb {
+
+class AttachedDatabase;
+
+//===--------------------------------------------------------------------===//
+// Keep-Warm Manager
+//===--------------------------------------------------------------------===//
+
+//! A table to keep warm: its blocks are checked every interval and the evicted ones are loaded again
+struct KeepWarmPolicy {
+	//! Fully qualified table name, policies are keyed by it
+	string table_name;
+	//! Not owned, so that DETACH frees the database. The policy is dropped at the end of the DETACH query, or by the
+	//! worker once the database is gone.
+	weak_ptr<AttachedDatabase> database;
+	//! Blocks of the table as of checkpoint_stamp, sorted
+	vector<block_id_t> block_ids;
+	//! GetMetaBlock() of the database when block_ids were collected; the blocks are collected again when it changes
+	uint64_t checkpoint_stamp = 0;
+	PrewarmMode mode;
+	idx_t interval_ms;
+	std::chrono::steady_clock::time_point next_check;
+};
+
+//! Runs keep-warm policies registered with prewarm_keep() on a background thread.
+//! BUFFER policies reload the blocks that are no longer in the buffer pool; PREFETCH policies re-issue OS prefetch
+//! hints for all blocks, which the kernel ignores for pages still cached. Reloads of all policies share one byte rate
+//! limit and never use more than 80% of the free buffer pool memory, like the prewarm strategies.
+//! The block list is collected again after each checkpoint; the policy stops when its table is dropped.
+//! Every check is added to prewarm_stats() under the strategy "keep_warm".
+//! Policies belong to the connection that registered them and stop when it closes, or when their database is detached.
+class KeepWarmManager : public ClientContextState {
+public:
+	static constexpr const char *STATE_KEY = "cache_prewarm_keep_warm_manager";
+
+	~KeepWarmManager() override;
+
+	//! Drop the policies of databases that were detached
+	void QueryEnd(ClientContext &context) override;
+
+	//! Register a policy, replacing the one for the same table
+	//! @param max_bytes_per_sec Rate limit for reloads of all policies, 0 for no limit
+	void Keep(KeepWarmPolicy policy, idx_t max_bytes_per_sec);
+	//! Remove the policy for a table, returns whether there was one
+	bool Unkeep(const string &table_name);
+
+private:
+	void WorkerLoop();
+	//! Check one policy and reload its evicted blocks, returns whether the worker should keep running
+	bool CheckPolicy(KeepWarmPolicy &policy);
+	//! Collect the blocks of a policy's table again after a checkpoint, returns false if the table is gone
+	bool RefreshBlocks(KeepWarmPolicy &policy, AttachedDatabase &database);
+	//! Remove a policy the worker found to be stale
+	void DropPolicy(KeepWarmPolicy &policy);
+	//! Wait until `bytes` more fit the rate limit, returns false if the worker is stopping
+	bool Throttle(idx_t bytes);
+	//! Wait for the given duration or until stopped, returns false if the worker is stopping
+	bool WaitFor(std::chrono::steady_clock::duration duration);
+	void StopWorker();
+
+	mutable mutex mu;
+	std::condition_variable cv;
+	bool stop_requested = false;
+	std::thread worker;
+	vector<shared_ptr<KeepWarmPolicy>> policies;
+	idx_t max_bytes_per_sec = 0;
+	//! Rate limit window: bytes reloaded since window_start
+	std::chrono::steady_clock::time_point window_start;
+	idx_t window_bytes = 0;
+};
+
+} // namespace duckdb
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/string.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// OS Memory
+//===--------------------------------------------------------------------===//
+
+//! Value of an OSMemoryInfo field that is not set or could not be read
+constexpr idx_t OS_MEMORY_UNKNOWN = NumericLimits<idx_t>::Maximum();
+
+//! Memory figures the OS reports for this process, in bytes
+struct OSMemoryInfo {
+	//! MemAvailable of /proc/meminfo: free memory plus the page cache the kernel can drop without swapping
+	idx_t mem_available = OS_MEMORY_UNKNOWN;
+	//! memory.max of the process' cgroup v2, unknown when the cgroup has no limit
+	idx_t cgroup_max = OS_MEMORY_UNKNOWN;
+	//! memory.current of the cgroup, including the page cache charged to it
+	idx_t cgroup_current = OS_MEMORY_UNKNOWN;
+	//! inactive_file of the cgroup's memory.stat: cold page cache, the first memory the kernel reclaims
+	idx_t cgroup_inactive_file = OS_MEMORY_UNKNOWN;
+};
+
+//! Bytes of page cache a prewarm may fill, and what limits it
+struct PageCacheBudget {
+	//! Memory the page cache can grow into without reclaim: MemAvailable, or the cgroup's headroom if lower
+	idx_t available_bytes = OS_MEMORY_UNKNOWN;
+	//! Bytes to prewarm at most, a share of the available bytes
+	idx_t budget_bytes = OS_MEMORY_UNKNOWN;
+	//! "MemAvailable", "cgroup memory.max" or empty if neither could be read
+	string source;
+};
+
+//! Read the memory figures of this process; everything is unknown outside Linux
+OSMemoryInfo ReadOSMemoryInfo();
+
+//! Page cache budget of the given memory figures. The cgroup can take max - current + inactive_file more before the
+//! kernel reclaims anything warmer than cold cache, the same working set estimate container runtimes use; the host
+//! can take MemAvailable. The budget is `usage_ratio` of the lower of both, so prewarm neither stops at the free
+//! memory only nor pushes the cgroup into reclaim, which would drop the blocks it just loaded or OOM the process.
+PageCacheBudget CalculatePageCacheBudget(const OSMemoryInfo &info, double usage_ratio);
+
+//! MemAvailable of /proc/meminfo content, in bytes
+//! @return OS_MEMORY_UNKNOWN if the field is missing
+idx_t ParseMemAvailable(const string &meminfo);
+
+//! Value of a cgroup v2 memory.max or memory.current file
+//! @return OS_MEMORY_UNKNOWN for "max" or content that is not a number
+idx_t ParseCgroupMemoryValue(const string &content);
+
+//! Value of a field of a cgroup v2 memory.stat file, in bytes
+//! @return OS_MEMORY_UNKNOWN if the field is missing
+idx_t ParseCgroupMemoryStat(const string &memory_stat, const string &field);
+
+//! Path of the process' cgroup v2 below the cgroup mount, from /proc/self/cgroup content ("0::/path")
+//! @return Empty if the process is not in a cgroup v2 hierarchy
+string ParseCgroupV2Path(const string &proc_self_cgroup);
+
+} // namespace duckdb
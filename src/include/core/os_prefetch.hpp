@@ -1,17 +1,45 @@
 #pragma once
 
+#include "duckdb/common/limits.hpp"
 #include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
 #include "duckdb/storage/storage_info.hpp"
 #include "utils/include/span.hpp"
 
 namespace duckdb {
 
+//! File size of OSGetFileSize() when it cannot be determined, every block counts as lying within such a file
+constexpr idx_t OS_FILE_SIZE_UNKNOWN = NumericLimits<idx_t>::Maximum();
+
 //! Issue OS-level prefetch hints for a range of database blocks using Span
 //! Uses platform-specific APIs: posix_fadvise (Linux) or fcntl with F_RDADVISE (macOS/BSD)
 //! @param db_path Path to the database file
 //! @param block_ids Span of block IDs to prefetch
 //! @param block_size Size of each block in bytes
+//! @param bytes_prefetched If set, incremented by the bytes of the successfully prefetched blocks, which is less than
+//! the block size for a block cut off by EOF
 //! @return Number of blocks successfully prefetched (0 if prefetch failed or not supported)
-idx_t OSPrefetchBlocks(const string &db_path, Span<const block_id_t> block_ids, idx_t block_size);
+idx_t OSPrefetchBlocks(const string &db_path, Span<const block_id_t> block_ids, idx_t block_size,
+                       idx_t *bytes_prefetched = nullptr);
+
+//! Issue an OS-level prefetch hint for a byte range of any local file, with the same platform APIs as OSPrefetchBlocks
+//! @param path Path to the file
+//! @param offset First byte of the range
+//! @param length Bytes in the range, clipped at EOF
+//! @return Bytes hinted (0 if the hint failed, the range lies past EOF or prefetch is not supported)
+idx_t OSPrefetchFileRange(const string &path, idx_t offset, idx_t length);
+
+//! Ask the OS to drop database blocks from its page cache, the inverse of OSPrefetchBlocks
+//! Only blocks with pages in the page cache are advised, found with mincore() over a mapping of the file, which does
+//! not read anything in. Uses posix_fadvise with POSIX_FADV_DONTNEED; dirty pages are left alone by the kernel
+//! @param db_path Path to the database file
+//! @param block_ids Span of block IDs to drop
+//! @param block_size Size of each block in bytes
+//! @return The blocks that had pages in the page cache and were advised, in input order (empty outside Linux)
+vector<block_id_t> OSEvictBlocks(const string &db_path, Span<const block_id_t> block_ids, idx_t block_size);
+
+//! Size of a local file in bytes
+//! @return OS_FILE_SIZE_UNKNOWN if the file cannot be stat()ed or on Windows
+idx_t OSGetFileSize(const string &path);
 
 } // namespace duckdb
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "core/prewarm_strategy.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+class PreparedStatement;
+
+//===--------------------------------------------------------------------===//
+// Parquet Metadata Prewarm Strategy
+//===--------------------------------------------------------------------===//
+
+//! Strategy for filling DuckDB's Parquet metadata cache (the object cache consulted when `parquet_metadata_cache` is
+//! enabled), so that the first query over many files does not spend its planning time reading and parsing footers.
+//! Footers are parsed by the parquet extension's own reader through one prepared parquet_file_metadata() query with
+//! the file list bound as a parameter, which inserts them into the database instance's object cache. The query runs on
+//! a connection of its own, as the calling context is busy executing the statement that called the prewarm. Every
+//! file counts as one block in the execution stats; footer sizes are not known, so no bytes are reported.
+class ParquetMetadataPrewarmStrategy : public PrewarmStrategy {
+public:
+	explicit ParquetMetadataPrewarmStrategy(ClientContext &context_p) : PrewarmStrategy(context_p) {
+	}
+
+	string GetName() const override {
+		return "parquet_metadata";
+	}
+
+	//! Expand a glob pattern over local or remote paths, ordered by path
+	//! @throws InvalidInputException if the pattern matches no file
+	static vector<string> ListFiles(ClientContext &context, const string &pattern);
+
+	//! Parse the footers of the given files and cache them
+	//! @return Number of files whose footer is cached; files that cannot be read as Parquet are skipped
+	idx_t Execute(const vector<string> &file_paths);
+
+protected:
+	//! The object cache is not bounded by the buffer pool, every footer is cached
+	BufferCapacityInfo CalculateMaxAvailableBlocks() override;
+
+	//! Parse the footers of the files in [start, end). A failing range is split in halves until the unreadable files
+	//! are isolated, so one of them only skips itself.
+	//! @return Number of files whose footer was parsed
+	idx_t CacheFooters(PreparedStatement &statement, const vector<string> &file_paths, idx_t start, idx_t end);
+};
+
+} // namespace duckdb
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "core/pinned_blocks.hpp"
+#include "core/prewarm_strategy.hpp"
+
+namespace duckdb {
+
+//! Prewarm strategy: Load blocks into the buffer pool and keep them pinned. Unlike BUFFER, which leaves blocks
+//! evictable, pinned blocks stay until the PinnedBlocks taken from the strategy are destroyed. Blocks that are
+//! resident already are pinned as well. All pins of a database instance are capped at
+//! prewarm_pin_max_memory_fraction of memory_limit; loading is capped like BUFFER.
+class PinPrewarmStrategy : public LocalPrewarmStrategy {
+public:
+	PinPrewarmStrategy(ClientContext &context_p, BlockManager &block_manager_p, BufferManager &buffer_manager_p)
+	    : LocalPrewarmStrategy(context_p, block_manager_p, buffer_manager_p) {
+	}
+
+	string GetName() const override {
+		return "pin";
+	}
+
+	//! Pin the blocks, loading the ones not in the buffer pool
+	//! @return Bytes loaded; blocks that were resident already are pinned without counting towards it
+	idx_t Execute(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) override;
+
+	//! The pins taken by Execute(), empty if it did not run. Dropping them unpins the blocks.
+	unique_ptr<PinnedBlocks> TakePinnedBlocks() {
+		return std::move(pinned);
+	}
+
+	//! Bytes all connections of the database instance may pin: prewarm_pin_max_memory_fraction of memory_limit
+	idx_t GetPinCap() const;
+
+protected:
+	//! The free memory limit of BUFFER, further capped by the pin budget left on the instance. Pinning resident blocks
+	//! uses the pin budget as well, so dry runs of tables that are partly resident overestimate what can be pinned.
+	BufferCapacityInfo CalculateMaxAvailableBlocks() override;
+
+	unique_ptr<PinnedBlocks> pinned;
+};
+
+} // namespace duckdb
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include "duckdb/storage/buffer/buffer_handle.hpp"
+
+namespace duckdb {
+
+class AttachedDatabase;
+class DatabaseInstance;
+
+//===--------------------------------------------------------------------===//
+// Pinned Blocks
+//===--------------------------------------------------------------------===//
+
+//! Bytes pinned by 'pin' mode on a database instance, shared by all its connections so that the cap on pinned memory
+//! holds across them
+class PinnedMemoryBudget {
+public:
+	//! Reserve up to `wanted` bytes without exceeding `cap` bytes pinned in total on the instance
+	//! @return Bytes reserved, fewer than wanted once the cap is reached
+	static idx_t Reserve(const DatabaseInstance &db, idx_t wanted, idx_t cap);
+	//! Return reserved bytes
+	static void Release(const DatabaseInstance &db, idx_t bytes);
+	//! Bytes reserved on the instance
+	static idx_t GetReserved(const DatabaseInstance &db);
+};
+
+//! Bytes reserved in the PinnedMemoryBudget by a pin prewarm in progress. Bytes not yet transferred to PinnedBlocks
+//! go back to the budget when the reservation is destroyed, also when the prewarm throws.
+class PinnedMemoryReservation {
+public:
+	//! Reserve up to `wanted` bytes, see PinnedMemoryBudget::Reserve()
+	PinnedMemoryReservation(const DatabaseInstance &db_p, idx_t wanted, idx_t cap);
+	~PinnedMemoryReservation();
+
+	PinnedMemoryReservation(const PinnedMemoryReservation &) = delete;
+	PinnedMemoryReservation &operator=(const PinnedMemoryReservation &) = delete;
+
+	//! Hand over bytes of blocks just added to a PinnedBlocks, which returns them when unpinning; not thread-safe
+	void Transfer(idx_t transferred);
+
+	//! Bytes reserved and not transferred
+	idx_t GetBytes() const {
+		return bytes;
+	}
+
+private:
+	const DatabaseInstance &db;
+	idx_t bytes;
+};
+
+//! Buffer handles of the blocks of one table pinned by 'pin' mode. The blocks stay in the buffer pool until this
+//! object is destroyed, which unpins them and returns their bytes to the PinnedMemoryBudget.
+class PinnedBlocks {
+public:
+	PinnedBlocks(shared_ptr<AttachedDatabase> database_p, idx_t block_size_p);
+	~PinnedBlocks();
+
+	//! Take over a pinned block, whose bytes must have been reserved in the PinnedMemoryBudget
+	void Add(BufferHandle handle);
+
+	AttachedDatabase &GetDatabase() const {
+		return *database;
+	}
+	idx_t GetBlockCount() const {
+		return handles.size();
+	}
+	idx_t GetBytes() const {
+		return handles.size() * block_size;
+	}
+
+private:
+	//! Keeps the database, and thereby its buffer pool, alive while blocks are pinned
+	shared_ptr<AttachedDatabase> database;
+	idx_t block_size;
+	vector<BufferHandle> handles;
+};
+
+//! Pins of a connection by table, released by prewarm_release(), when the connection closes, or at the end of the
+//! connection's next query once their database is detached. DuckDB has no detach hook; holding the pins any longer
+//! would keep the detached database file open.
+class PinnedBlockRegistry : public ClientContextState {
+public:
+	static constexpr const char *STATE_KEY = "cache_prewarm_pinned_blocks";
+
+	void QueryEnd(ClientContext &context) override;
+
+	//! Keep the pins of a table, replacing the ones it held
+	void Pin(const string &table_name, unique_ptr<PinnedBlocks> pinned);
+	//! Unpin the blocks of a table
+	//! @return Bytes unpinned, 0 if the table has no pins
+	idx_t Release(const string &table_name);
+	//! Unpin the blocks of all tables
+	//! @return Bytes unpinned
+	idx_t ReleaseAll();
+	//! Unpin the blocks of tables whose database is no longer attached
+	//! @return Bytes unpinned
+	idx_t ReleaseDetached(ClientContext &context);
+	//! Bytes pinned for a table, 0 if it has no pins
+	idx_t GetPinnedBytes(const string &table_name) const;
+
+private:
+	mutable mutex lock;
+	//! Keyed by fully qualified table name
+	map<string, unique_ptr<PinnedBlocks>> pins;
+};
+
+} // namespace duckdb
@@ -11,7 +11,20 @@ public:
 	    : LocalPrewarmStrategy(context_p, block_manager_p, buffer_manager_p) {
 	}
 
-	idx_t Execute(DuckTableEntry &table_entry, const unordered_set<block_id_t> &block_ids, idx_t max_blocks) override;
+	string GetName() const override {
+		return "prefetch";
+	}
+
+	idx_t Execute(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) override;
+
+	//! Blocks in the buffer pool are left out like in READ, the page cache residency of the others is unknown
+	PrewarmPlanSummary Plan(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) override;
+
+protected:
+	//! The blocks go to the OS page cache, the buffer pool has no say in how many fit
+	BufferCapacityInfo CalculateMaxAvailableBlocks() override {
+		return CalculatePageCacheCapacity();
+	}
 };
 
 } // namespace duckdb
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/storage/storage_info.hpp"
+#include "utils/include/mapped_file.hpp"
+
+#include <utility>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Prewarm Manifest
+//===--------------------------------------------------------------------===//
+//
+// A manifest is a portable list of prewarm targets. On disk, all integers little-endian:
+//   header:  magic "DPWMANIF", uint32 version, uint32 section count, uint64 payload size, uint64 payload checksum,
+//            uint64 reserved
+//   payload: sections, each a uint32 kind, a uint64 body size and the body
+//   database body:    varint-prefixed database name and file path, uint64 checkpoint stamp, uint64 block size,
+//                     varint block count, sorted block IDs as varint deltas
+//   remote file body: varint-prefixed file path, varint file size, varint range count, sorted non-overlapping
+//                     ranges as varint (gap since the previous range end, length) pairs
+// Readers map the file and decode a section's entries only when asked to, so opening a manifest costs one checksum
+// pass regardless of how many blocks it lists.
+
+enum class PrewarmManifestSectionKind : uint32_t { DATABASE = 1, REMOTE_FILE = 2 };
+
+//! Blocks of one attached DuckDB database
+struct PrewarmManifestDatabase {
+	string database_name;
+	//! Database file path at export time
+	string database_path;
+	//! Meta block of the database when the block IDs were collected, it moves with every checkpoint
+	uint64_t checkpoint_stamp = 0;
+	idx_t block_size = 0;
+	idx_t block_count = 0;
+	//! Varint-encoded block ID deltas, pointing into the mapped manifest
+	const_data_ptr_t encoded_blocks = nullptr;
+	idx_t encoded_size = 0;
+
+	//! Decode the block IDs in ascending order
+	vector<block_id_t> DecodeBlockIds() const;
+};
+
+//! Byte ranges of one remote file
+struct PrewarmManifestRemoteFile {
+	string file_path;
+	idx_t file_size = 0;
+	idx_t range_count = 0;
+	//! Varint-encoded (gap, length) pairs, pointing into the mapped manifest
+	const_data_ptr_t encoded_ranges = nullptr;
+	idx_t encoded_size = 0;
+
+	//! Decode the (offset, length) ranges in ascending order
+	vector<std::pair<idx_t, idx_t>> DecodeRanges() const;
+};
+
+//! Builds a manifest in memory and writes it out
+class PrewarmManifestWriter {
+public:
+	//! @param block_ids Block IDs in any order, duplicates are dropped
+	void AddDatabase(const string &database_name, const string &database_path, uint64_t checkpoint_stamp,
+	                 idx_t block_size, vector<block_id_t> block_ids);
+	//! @param ranges (offset, length) pairs in any order, overlapping and adjacent ranges are merged
+	void AddRemoteFile(const string &file_path, idx_t file_size, vector<std::pair<idx_t, idx_t>> ranges);
+
+	//! Number of blocks and ranges added so far
+	idx_t EntryCount() const {
+		return entry_count;
+	}
+
+	//! Write the manifest, replacing an existing file
+	void Write(FileSystem &fs, const string &path) const;
+
+private:
+	void AddSection(PrewarmManifestSectionKind kind, const vector<data_t> &body);
+
+	uint32_t section_count = 0;
+	idx_t entry_count = 0;
+	vector<data_t> payload;
+};
+
+//! Read-only view of a manifest file
+class PrewarmManifestReader {
+public:
+	//! Map the manifest and validate its header, checksum and section layout
+	//! @throws InvalidInputException if the file is not a valid manifest
+	PrewarmManifestReader(FileSystem &fs, const string &path);
+
+	const vector<PrewarmManifestDatabase> &GetDatabases() const {
+		return databases;
+	}
+	const vector<PrewarmManifestRemoteFile> &GetRemoteFiles() const {
+		return remote_files;
+	}
+
+private:
+	//! Keeps the memory the section views point into alive
+	unique_ptr<MappedFile> file;
+	vector<PrewarmManifestDatabase> databases;
+	vector<PrewarmManifestRemoteFile> remote_files;
+};
+
+} // namespace duckdb
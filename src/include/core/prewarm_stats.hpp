@@ -0,0 +1,123 @@
+#pragma once
+
+#include "utils/include/latency_histogram.hpp"
+
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <condition_variable>
+#include <thread>
+
+namespace duckdb {
+
+class ClientContext;
+class FileSystem;
+class PrewarmStrategy;
+struct PrewarmExecutionStats;
+
+//===--------------------------------------------------------------------===//
+// Prewarm Statistics
+//===--------------------------------------------------------------------===//
+
+//! Cumulative counters of all prewarm calls of one strategy on one database
+struct PrewarmStatsEntry {
+	string strategy;
+	//! Attached database name, empty for remote files
+	string database;
+	idx_t calls = 0;
+	idx_t blocks_planned = 0;
+	idx_t blocks_resident = 0;
+	idx_t blocks_loaded = 0;
+	idx_t blocks_skipped = 0;
+	//! Skipped blocks held back to avoid buffer pool eviction
+	idx_t blocks_throttled = 0;
+	idx_t bytes_loaded = 0;
+	//! Bytes of blocks whose read failed
+	idx_t bytes_failed = 0;
+	//! Phase timings in microseconds: finding the blocks to prewarm, registering handles and filtering out resident
+	//! blocks, sorting them into I/O order and loading them
+	uint64_t collection_us = 0;
+	uint64_t register_us = 0;
+	uint64_t sort_us = 0;
+	uint64_t io_us = 0;
+	//! Time from the start of I/O until the first batch was loaded, summed over calls
+	uint64_t first_load_us = 0;
+	//! Latency of whole calls, all phases
+	LatencyHistogram call_latency;
+	//! Latency of single I/O tasks (one batch of blocks, or one remote block)
+	LatencyHistogram task_latency;
+};
+
+//! Process-wide prewarm statistics, shared by all connections and database instances like the OS page cache they
+//! describe. Optionally written periodically to a file in the Prometheus text format, for the node_exporter textfile
+//! collector.
+class PrewarmStatsRegistry {
+public:
+	static PrewarmStatsRegistry &Get();
+
+	~PrewarmStatsRegistry();
+
+	//! Add one prewarm call
+	//! @param database Attached database name, empty for remote files
+	//! @param collection_us Time spent collecting the blocks to prewarm, in microseconds
+	//! @param strategy Strategy that executed the call; its execution stats and task timings are added, so it must not
+	//! have been used for another recorded call
+	void Record(const string &database, uint64_t collection_us, const PrewarmStrategy &strategy);
+	//! Add one call that did not go through a PrewarmStrategy, such as a keep-warm check
+	//! @param task_durations_us Latency of each I/O task of the call
+	void Record(const string &strategy, const string &database, uint64_t collection_us,
+	            const PrewarmExecutionStats &stats, const vector<uint64_t> &task_durations_us);
+
+	//! Snapshot of all entries, ordered by strategy and database
+	vector<PrewarmStatsEntry> GetEntries() const;
+
+	//! Drop all counters
+	void Reset();
+
+	//! Bytes per second a strategy loaded over all recorded calls, 0 if it has not loaded anything yet
+	double GetThroughput(const string &strategy) const;
+
+	//! All entries in the Prometheus text exposition format
+	string ToPrometheusText() const;
+
+	//! Write ToPrometheusText() to a file. The text goes to a temporary file that is renamed over the target, so the
+	//! collector never reads a partial file.
+	void WriteTextfile(FileSystem &fs, const string &path) const;
+
+	//! Write the textfile every interval on a background thread, an empty path stops writing
+	//! @param fs File system of the client configuring the file; the first write goes through it, so that
+	//! enable_external_access and allowed_directories of that client decide whether the path may be written at all.
+	//! The background thread outlives the client and writes through the local file system.
+	void ConfigureTextfile(FileSystem &fs, const string &path, idx_t interval_ms);
+
+private:
+	PrewarmStatsRegistry() = default;
+
+	void TextfileLoop();
+	void StopTextfileWriter();
+
+	mutable mutex stats_lock;
+	//! Keyed by (strategy, database)
+	map<std::pair<string, string>, PrewarmStatsEntry> entries;
+
+	//! Held by ConfigureTextfile() from stopping the old worker until the new one runs
+	mutex textfile_config_lock;
+	//! Textfile writer, guarded by textfile_lock
+	mutex textfile_lock;
+	std::condition_variable textfile_cv;
+	std::thread textfile_worker;
+	bool textfile_stop = false;
+	string textfile_path;
+	idx_t textfile_interval_ms = 0;
+};
+
+//! Log the phase timings of a prewarm call and add it to the process-wide statistics
+//! @param database Attached database name, empty for remote files
+//! @param collection_us Time spent collecting the blocks to prewarm, in microseconds
+//! @param strategy Strategy that executed the call, see PrewarmStatsRegistry::Record()
+void RecordPrewarmCall(ClientContext &context, const string &database, uint64_t collection_us,
+                       const PrewarmStrategy &strategy);
+
+} // namespace duckdb
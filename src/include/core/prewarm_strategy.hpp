@@ -1,10 +1,18 @@
 #pragma once
 
 #include "cache_prewarm_extension.hpp"
+#include "core/os_memory.hpp"
 #include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/helper.hpp"
 #include "duckdb/common/limits.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/unordered_set.hpp"
 #include "duckdb/storage/storage_info.hpp"
+#include "utils/include/block_id_set.hpp"
+
+#include <chrono>
 
 namespace duckdb {
 
@@ -12,6 +20,11 @@ namespace duckdb {
 // Prewarm Strategy Interface
 //===--------------------------------------------------------------------===//
 
+//! Maximum fraction of available (unused) buffer pool memory to use for prewarming.
+//! Applied to remaining memory after subtracting current buffer pool usage (max_memory - used_memory).
+//! The 0.8 ratio leaves 20% headroom for concurrent operations and prevents buffer pool overload.
+constexpr double PREWARM_BUFFER_USAGE_RATIO = 0.8;
+
 //! Information about buffer pool capacity for prewarming
 struct BufferCapacityInfo {
 	//! Size of each block in bytes
@@ -24,6 +37,68 @@ struct BufferCapacityInfo {
 	idx_t available_space;
 	//! Maximum blocks that can be loaded
 	idx_t max_blocks;
+	//! What bounds the available memory, for warnings
+	string limited_by = "memory_limit";
+};
+
+//! Block counts and I/O time of all Execute calls of a strategy
+struct PrewarmExecutionStats {
+	//! Blocks requested
+	idx_t blocks_planned = 0;
+	//! Requested blocks that were resident already and not loaded again
+	idx_t blocks_resident = 0;
+	//! Blocks not loaded because of the memory or size limit, or because loading them failed
+	idx_t blocks_skipped = 0;
+	//! Skipped blocks that admission control held back because loading them would have made the buffer pool evict
+	idx_t blocks_throttled = 0;
+	idx_t blocks_loaded = 0;
+	idx_t bytes_loaded = 0;
+	//! Bytes of skipped blocks whose read failed, after retries for remote files
+	idx_t bytes_failed = 0;
+	//! Time spent registering block handles and filtering out resident blocks before any I/O, in microseconds
+	//! Strategies that register the blocks of a batch right before loading it count this as I/O time.
+	uint64_t register_us = 0;
+	//! Time spent sorting blocks into I/O order, in microseconds
+	uint64_t sort_us = 0;
+	//! Wall time from scheduling the first I/O task until the last one finished, in microseconds
+	uint64_t io_us = 0;
+	//! Wall time from scheduling the first I/O task until the first batch was loaded, in microseconds
+	uint64_t first_load_us = 0;
+};
+
+//! What a prewarm would do, computed without issuing I/O
+struct PrewarmPlanSummary {
+	//! Blocks requested
+	idx_t planned_blocks = 0;
+	//! Blocks that would be loaded
+	idx_t blocks = 0;
+	//! Runs of consecutive blocks among them, each one a sequential read
+	idx_t extents = 0;
+	//! Bytes that would be loaded
+	idx_t bytes = 0;
+	//! Requested bytes that are resident already
+	idx_t resident_bytes = 0;
+	//! Requested bytes over the memory or size limit
+	idx_t skipped_bytes = 0;
+};
+
+//! Microseconds elapsed since `start`
+inline uint64_t GetElapsedMicros(std::chrono::steady_clock::time_point start) {
+	return static_cast<uint64_t>(
+	    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+//! Wall time of every I/O task a strategy ran, for benchmarks and diagnostics
+class PrewarmTaskTimings {
+public:
+	//! Record a task that started at `start` and finished now, safe to call from executor threads
+	void Record(std::chrono::steady_clock::time_point start);
+	//! Durations in microseconds, in completion order
+	vector<uint64_t> GetDurationsUs() const;
+
+private:
+	mutable mutex lock;
+	vector<uint64_t> durations_us;
 };
 
 //! Base interface for prewarm strategies
@@ -34,6 +109,25 @@ public:
 	explicit PrewarmStrategy(ClientContext &context_p) : context(context_p) {
 	}
 
+	//! Name of the strategy, as reported by prewarm_stats()
+	virtual string GetName() const = 0;
+
+	//! Timings of all tasks run by this strategy so far
+	const PrewarmTaskTimings &GetTaskTimings() const {
+		return task_timings;
+	}
+
+	//! Block counts and I/O time of all Execute calls so far
+	const PrewarmExecutionStats &GetExecutionStats() const {
+		return execution_stats;
+	}
+
+	template <class TARGET>
+	TARGET &Cast() {
+		DynamicCastCheck<TARGET>(this);
+		return reinterpret_cast<TARGET &>(*this);
+	}
+
 protected:
 	//! Calculate maximum number of blocks that can be loaded based on available buffer pool memory
 	//! Uses 80% of available memory to avoid eviction churn
@@ -48,7 +142,24 @@ protected:
 	//! @return Number of blocks per task (0 if no blocks available)
 	static idx_t CalculateBlocksPerTask(idx_t block_size, idx_t max_blocks, idx_t max_threads, idx_t target_bytes);
 
+	//! Target bytes per task: the prewarm_batch_bytes setting if set, otherwise the strategy's default
+	idx_t GetTargetBatchBytes(idx_t default_bytes) const;
+
+	//! Take up to `wanted` blocks from a budget shared by concurrent I/O tasks
+	//! @return Blocks granted, fewer than wanted once the budget runs out
+	static idx_t ClaimBlocks(atomic<idx_t> &budget, idx_t wanted);
+
+	//! Store the time since `io_start` in `first_load_us` unless a batch finished loading before, thread-safe
+	static void RecordFirstLoad(atomic<uint64_t> &first_load_us, std::chrono::steady_clock::time_point io_start);
+
+	//! Bytes of OS page cache a prewarm may fill: the same share of the memory available to the page cache as of the
+	//! buffer pool for BUFFER, bounded by MemAvailable and the cgroup v2 memory.max of the process
+	//! The budget is unknown (OS_MEMORY_UNKNOWN) where neither can be read, e.g. outside Linux.
+	PageCacheBudget GetPageCacheBudget() const;
+
 	ClientContext &context;
+	PrewarmTaskTimings task_timings;
+	PrewarmExecutionStats execution_stats;
 };
 
 class LocalPrewarmStrategy : public PrewarmStrategy {
@@ -57,13 +168,16 @@ public:
 	    : PrewarmStrategy(context_p), block_manager(block_manager_p), buffer_manager(buffer_manager_p) {
 	}
 
-	//! Execute prewarm operation on the given table and blocks
+	//! Execute prewarm operation on the given blocks of a database
 	//! Returns number of bytes successfully prewarmed
 	//! If a provided block_id doesn't exist, it is silently skipped and not counted
 	//! in the return value. The method does not throw errors for non-existent blocks.
 	//! @param max_blocks Maximum number of blocks to prewarm
-	virtual idx_t Execute(DuckTableEntry &table_entry, const unordered_set<block_id_t> &block_ids,
-	                      idx_t max_blocks) = 0;
+	virtual idx_t Execute(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) = 0;
+
+	//! Plan a prewarm of the given blocks like Execute() would, without loading anything
+	//! Blocks in the buffer pool are filtered out by registering their handles, the budget is applied to the rest.
+	virtual PrewarmPlanSummary Plan(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks);
 
 protected:
 	//! Check if direct I/O is enabled and throw an exception if OS page cache strategies won't work
@@ -72,13 +186,47 @@ protected:
 
 	//! Register blocks and filter to unloaded ones
 	//! @param block_ids The set of block IDs to register
-	vector<shared_ptr<BlockHandle>> GetUnloadedBlockHandles(const unordered_set<block_id_t> &block_ids);
+	//! @return Handles of the unloaded blocks, in ascending block order
+	vector<shared_ptr<BlockHandle>> GetUnloadedBlockHandles(const BlockIdSet &block_ids);
+
+	//! Register a run of consecutive blocks and filter to unloaded ones, so that I/O tasks can filter the batch they
+	//! are about to load instead of registering the whole plan up front
+	//! @return Handles of the unloaded blocks, in ascending block order
+	vector<shared_ptr<BlockHandle>> GetUnloadedBlockHandles(block_id_t first_block, idx_t count);
+
+	//! Number of the handles whose block is in the buffer pool, to count what a prefetch actually loaded
+	static idx_t CountLoadedBlocks(const vector<shared_ptr<BlockHandle>> &handles);
+
+	//! Size of the database file, stat()ed once per call and passed to the helpers below
+	//! @return OS_FILE_SIZE_UNKNOWN if it cannot be determined, every block then counts in full
+	static idx_t GetDatabaseFileSize(AttachedDatabase &database);
+
+	//! Bytes of a block that lie within the database file, 0 past EOF
+	idx_t GetBlockFileBytes(block_id_t block_id, idx_t file_size) const;
+
+	//! Drop blocks past the end of the database file, which cannot be loaded
+	//! @param file_size Size of the database file, see GetDatabaseFileSize()
+	//! @param block_ids Blocks to load in ascending order, trimmed in place
+	//! @return Bytes of each remaining block within the file
+	vector<idx_t> ClipToDatabaseFile(idx_t file_size, vector<block_id_t> &block_ids) const;
+
+	//! Apply the memory and size limit to the blocks that need loading and summarize the result
+	//! @param planned_blocks Number of requested blocks
+	//! @param resident_bytes Bytes of the requested blocks that are not in `candidates` because they are resident
+	//! @param candidates Blocks that need loading, in ascending order
+	//! @param candidate_bytes Bytes of each candidate, see ClipToDatabaseFile()
+	PrewarmPlanSummary SummarizePlan(idx_t planned_blocks, idx_t resident_bytes, const vector<block_id_t> &candidates,
+	                                 const vector<idx_t> &candidate_bytes, idx_t max_blocks);
 
 	//! Calculate maximum number of blocks that can be loaded based on available buffer pool memory
 	//! Uses 80% of available memory to avoid eviction churn
 	//! Returns comprehensive buffer capacity information
 	BufferCapacityInfo CalculateMaxAvailableBlocks() override;
 
+	//! Capacity of the OS page cache for the READ and PREFETCH strategies, see GetPageCacheBudget()
+	//! Falls back to the buffer pool capacity where the page cache budget is unknown.
+	BufferCapacityInfo CalculatePageCacheCapacity();
+
 	BlockManager &block_manager;
 	BufferManager &buffer_manager;
 };
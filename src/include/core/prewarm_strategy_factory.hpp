@@ -8,6 +8,9 @@ namespace duckdb {
 // Strategy Factory
 //===--------------------------------------------------------------------===//
 
+//! Parse a prewarm mode argument, NULL selects the default BUFFER mode
+PrewarmMode ParsePrewarmMode(const Value &mode_val);
+
 //! Create a local prewarm strategy based on mode
 unique_ptr<LocalPrewarmStrategy> CreateLocalPrewarmStrategy(ClientContext &context, PrewarmMode mode,
                                                             BlockManager &block_manager, BufferManager &buffer_manager);
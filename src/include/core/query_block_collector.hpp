@@ -0,0 +1,80 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/storage/storage_info.hpp"
+#include "utils/include/block_id_set.hpp"
+
+namespace duckdb {
+
+class FileHandle;
+class LogicalGet;
+class LogicalOperator;
+
+//===--------------------------------------------------------------------===//
+// Query Block Collector
+//===--------------------------------------------------------------------===//
+
+//! Blocks a query reads from the DuckDB tables of one attached database
+struct QueryDatabaseBlocks {
+	reference<AttachedDatabase> database;
+	//! Blocks of the projected columns in the row groups surviving filter pruning, across all scanned tables
+	BlockIdSet block_ids;
+
+	explicit QueryDatabaseBlocks(AttachedDatabase &database_p) : database(database_p) {
+	}
+};
+
+//! Byte ranges a query reads from an external file
+struct QueryFileRanges {
+	string file_path;
+	//! Read the whole file, `ranges` is ignored
+	bool whole_file = false;
+	//! (offset, length) pairs
+	vector<std::pair<idx_t, idx_t>> ranges;
+	//! Also read the end of the file, where the Parquet footer lives
+	bool include_footer = false;
+};
+
+//! Everything a query will read, grouped by where it lives
+struct QueryPrewarmPlan {
+	vector<QueryDatabaseBlocks> databases;
+	vector<QueryFileRanges> files;
+
+	bool empty() const {
+		return databases.empty() && files.empty();
+	}
+};
+
+//! Plans a query without executing it and collects what its scans will read:
+//! - DuckDB table scans: blocks of the projected and filtered columns, skipping row groups whose zonemaps cannot
+//!   satisfy the pushed-down filters
+//! - Parquet scans: column chunk ranges of the projected columns in row groups that survive the same pruning, plus
+//!   the footer
+//! - CSV scans: whole files
+class QueryBlockCollector {
+public:
+	//! @param planner Idle connection used to plan the query and read Parquet metadata. It has to stay alive (ideally
+	//! inside a transaction) while the returned database references are used.
+	//! @param query A single SQL statement, planned and optimized but not executed
+	static QueryPrewarmPlan CollectQueryBlocks(Connection &planner, const string &query);
+
+	//! Byte ranges to read of a planned file: the whole file, or its ranges plus the Parquet footer if requested. The
+	//! footer length is read from the 8-byte trailer at the end of the file; files without a Parquet trailer get the
+	//! last byte instead.
+	//! @param file_handle Open handle of the file, read only for the footer length
+	static vector<std::pair<idx_t, idx_t>> GetFileRanges(FileHandle &file_handle, idx_t file_size,
+	                                                     const QueryFileRanges &file);
+
+private:
+	static void CollectOperator(Connection &planner, LogicalOperator &op, QueryPrewarmPlan &plan);
+	static void CollectTableScan(ClientContext &context, LogicalGet &get, DuckTableEntry &table,
+	                             QueryPrewarmPlan &plan);
+	static void CollectFileScan(Connection &planner, LogicalGet &get, bool is_parquet, QueryPrewarmPlan &plan);
+	static void CollectParquetRanges(Connection &planner, LogicalGet &get, const vector<string> &file_paths,
+	                                 QueryPrewarmPlan &plan);
+};
+
+} // namespace duckdb
@@ -1,38 +1,123 @@
 #pragma once
 
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/helper.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/common/types.hpp"
-#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/vector.hpp"
+#include "utils/include/span.hpp"
 
 namespace duckdb {
 
 //===--------------------------------------------------------------------===//
-// Remote Block Info Structure
+// Remote Block Plan Structures
 //===--------------------------------------------------------------------===//
 
-//! Information about a remote block to prewarm
-struct RemoteBlockInfo {
+//! Per-file descriptor shared by all blocks of a remote file
+struct RemoteFileDescriptor {
 	//! Remote file path (e.g., s3://bucket/file.parquet)
 	string file_path;
-	//! Byte offset in file
-	idx_t offset;
-	//! Block size in bytes
-	int64_t size;
 	//! Total file size
 	idx_t file_size;
 
-	RemoteBlockInfo() : offset(0), size(0), file_size(0) {
+	RemoteFileDescriptor() : file_size(0) {
 	}
 
-	RemoteBlockInfo(string file_path_p, idx_t offset_p, int64_t size_p, idx_t file_size_p)
-	    : file_path(std::move(file_path_p)), offset(offset_p), size(size_p), file_size(file_size_p) {
+	RemoteFileDescriptor(string file_path_p, idx_t file_size_p)
+	    : file_path(std::move(file_path_p)), file_size(file_size_p) {
 	}
+
+	//! Number of blocks the file is divided into, the last one may be partial
+	idx_t GetBlockCount(idx_t block_size) const {
+		return (file_size + block_size - 1) / block_size;
+	}
+	//! Byte offset of the given block in file
+	idx_t GetBlockOffset(idx_t block_index, idx_t block_size) const {
+		return block_index * block_size;
+	}
+	//! Size in bytes of the given block, accounting for the partial last block
+	idx_t GetBlockBytes(idx_t block_index, idx_t block_size) const {
+		const idx_t offset = GetBlockOffset(block_index, block_size);
+		return offset >= file_size ? 0 : MinValue<idx_t>(block_size, file_size - offset);
+	}
+};
+
+//! Compact reference to a remote block: index into the plan's file table and index of the block within the file
+struct RemoteBlockRef {
+	uint32_t file_index;
+	uint32_t block_index;
+
+	RemoteBlockRef() : file_index(0), block_index(0) {
+	}
+
+	RemoteBlockRef(uint32_t file_index_p, uint32_t block_index_p)
+	    : file_index(file_index_p), block_index(block_index_p) {
+	}
+
+	//! Reference to a block of a file, checking that both indexes fit
+	//! @throws InvalidInputException if the file has more blocks than a reference can address
+	static RemoteBlockRef Create(const string &file_path, idx_t file_index, idx_t block_index);
 };
 
-// Map from file path to vector of remote blocks to prewarm
-using RemoteFileBlockMap = unordered_map<string, vector<RemoteBlockInfo>>;
+//! Blocks of remote files to prewarm, stored as a per-file descriptor table plus compact (file_index, block_index)
+//! entries. Offsets and sizes are derived from the block size instead of being stored in every block, so a plan costs
+//! one descriptor per file and 8 bytes per block. Blocks of the same file are kept contiguous and in ascending order.
+class RemoteBlockPlan {
+public:
+	explicit RemoteBlockPlan(idx_t block_size_p) : block_size(block_size_p) {
+	}
+
+	//! Add a file with every one of its blocks
+	//! @return Index of the file in the descriptor table
+	idx_t AddFile(string file_path, idx_t file_size);
+	//! Add a file without blocks, blocks are added with AddBlock
+	//! @return Index of the file in the descriptor table
+	idx_t AddFileDescriptor(string file_path, idx_t file_size);
+	//! Add a single block of the most recently added file
+	void AddBlock(idx_t file_index, idx_t block_index);
+	//! Add a file with the blocks covering the given byte ranges, each block once and in ascending order
+	//! @param ranges (offset, length) pairs, may overlap and be unordered; parts beyond the file size are ignored
+	//! @return Index of the file in the descriptor table
+	idx_t AddFileRanges(string file_path, idx_t file_size, vector<std::pair<idx_t, idx_t>> ranges);
+
+	idx_t GetBlockSize() const {
+		return block_size;
+	}
+	const vector<RemoteFileDescriptor> &GetFiles() const {
+		return files;
+	}
+	const RemoteFileDescriptor &GetFile(const RemoteBlockRef &block) const {
+		return files[block.file_index];
+	}
+	const vector<RemoteBlockRef> &GetBlocks() const {
+		return blocks;
+	}
+	//! Contiguous blocks of the file at the given index
+	Span<const RemoteBlockRef> GetFileBlocks(idx_t file_index) const;
+
+	//! Byte offset of a block in its file
+	idx_t GetBlockOffset(const RemoteBlockRef &block) const {
+		return GetFile(block).GetBlockOffset(block.block_index, block_size);
+	}
+	//! Size of a block in bytes, accounting for the partial last block of a file
+	idx_t GetBlockBytes(const RemoteBlockRef &block) const {
+		return GetFile(block).GetBlockBytes(block.block_index, block_size);
+	}
+
+	bool empty() const {
+		return blocks.empty();
+	}
+	idx_t BlockCount() const {
+		return blocks.size();
+	}
+
+private:
+	idx_t block_size;
+	vector<RemoteFileDescriptor> files;
+	vector<RemoteBlockRef> blocks;
+	//! Start of each file's run of blocks in `blocks`, one past the last entry is blocks.size()
+	vector<idx_t> file_block_starts;
+};
 
 //===--------------------------------------------------------------------===//
 // Remote Block Collector
@@ -45,8 +130,8 @@ public:
 	//! @param fs File system to use for file operations
 	//! @param pattern Glob pattern of file path
 	//! @param block_size Size of each block (from cache_httpfs config)
-	//! @return Map of file paths to vector of remote blocks to prewarm
-	static RemoteFileBlockMap CollectRemoteBlocks(FileSystem &fs, const string &pattern, idx_t block_size);
+	//! @return Plan covering every block of every non-empty matching file
+	static RemoteBlockPlan CollectRemoteBlocks(FileSystem &fs, const string &pattern, idx_t block_size);
 };
 
 } // namespace duckdb
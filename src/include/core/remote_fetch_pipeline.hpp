@@ -0,0 +1,155 @@
+#pragma once
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "utils/include/bounded_queue.hpp"
+
+#include <condition_variable>
+#include <future>
+
+namespace duckdb {
+
+class ErrorData;
+class PrewarmTaskTimings;
+class ThreadPool;
+
+//===--------------------------------------------------------------------===//
+// Remote Fetch Pipeline
+//===--------------------------------------------------------------------===//
+
+//! Outcome of a remote prewarm, in bytes and blocks
+struct RemotePrewarmResult {
+	//! Blocks read through the cache by this call; cache_httpfs cannot tell which blocks it holds already, so blocks
+	//! served from its cache count as fetched too
+	idx_t bytes_fetched = 0;
+	idx_t blocks_fetched = 0;
+	//! Blocks that could not be fetched, after retries
+	idx_t bytes_failed = 0;
+	idx_t blocks_failed = 0;
+	//! Number of retried reads
+	idx_t retries = 0;
+};
+
+//! Retry behavior for failed block reads
+struct RemoteRetryPolicy {
+	//! Total attempts per block, including the first one
+	idx_t max_attempts = 3;
+	//! Backoff before the first retry, doubled for each further retry
+	idx_t initial_backoff_ms = 100;
+	//! Upper bound of the backoff between two attempts
+	idx_t max_backoff_ms = 2000;
+};
+
+//! How a failed block read is handled
+enum class RemoteFetchErrorKind {
+	//! Worth retrying: I/O and connection errors, HTTP 408/425/429 and 5xx
+	TRANSIENT,
+	//! Retrying will not help (e.g. missing object, permission denied); the block is counted as failed
+	PERMANENT,
+	//! The whole prewarm has to stop (e.g. interrupted query, internal error)
+	FATAL
+};
+
+//! Classify a block read error
+RemoteFetchErrorKind ClassifyRemoteFetchError(const ErrorData &error);
+
+//! A remote file opened for prewarm, shared by all of its in-flight blocks
+struct RemoteOpenFile {
+	unique_ptr<FileHandle> handle;
+	//! Outstanding references: submitted blocks that have not completed yet, plus one held by the planner while it is
+	//! still scheduling the file. The handle is closed when this drops to zero.
+	atomic<idx_t> pending_blocks {0};
+};
+
+//! A single remote block read handed from the planner to the fetch workers
+struct RemoteFetchWork {
+	//! File to read from
+	shared_ptr<RemoteOpenFile> file;
+	//! Byte offset in file
+	idx_t offset = 0;
+	//! Number of bytes to read
+	idx_t size = 0;
+};
+
+//! Bounded producer/consumer pipeline fetching remote blocks through the cache filesystem.
+//! The planner submits blocks on the calling thread while a fixed set of workers reads them concurrently. Submit()
+//! blocks while the queue is full, so memory stays constant no matter how many blocks are planned and the first read
+//! is issued as soon as the first block is submitted.
+//! Files are opened lazily right before their first block is scheduled and closed as soon as their last block
+//! completes. OpenFile() blocks while `max_open_files` handles are open, which bounds descriptors and per-handle
+//! HTTP state regardless of how many files match.
+class RemoteFetchPipeline {
+public:
+	//! @param worker_count Number of concurrent fetch workers
+	//! @param queue_capacity Maximum number of blocks waiting to be fetched
+	//! @param max_open_files Maximum number of concurrently open file handles
+	//! @param retry_policy Retry behavior for failed block reads
+	//! @param timings If set, the time to fetch each block including retries is recorded there
+	RemoteFetchPipeline(idx_t worker_count, idx_t queue_capacity, idx_t max_open_files,
+	                    RemoteRetryPolicy retry_policy = RemoteRetryPolicy(), PrewarmTaskTimings *timings = nullptr);
+	~RemoteFetchPipeline();
+
+	//! Open a file once a slot in the handle pool is free. The returned file holds the planner's reference, which has
+	//! to be dropped with FinishFile() once all of its blocks have been submitted.
+	//! @return nullptr if the file does not exist or the pipeline has been aborted
+	shared_ptr<RemoteOpenFile> OpenFile(FileSystem &fs, const string &file_path);
+
+	//! Hand a block to the fetch workers, blocking while the queue is full
+	//! @return false if the pipeline has been aborted by a failing worker and accepts no more work
+	bool Submit(RemoteFetchWork work);
+
+	//! Drop the planner's reference on a file, closing it if none of its blocks are in flight
+	void FinishFile(RemoteOpenFile &file);
+
+	//! Close the queue and wait for the workers to drain it. Blocks failing with transient errors are retried with
+	//! exponential backoff, blocks that still fail are counted as failed and do not stop the pipeline. Only fatal
+	//! errors are rethrown.
+	//! @return Fetched, failed and retried blocks; cached blocks are accounted by the planner
+	RemotePrewarmResult Finish();
+
+	//! Message of the first block that failed permanently, empty if none did
+	string GetFirstFailure() const;
+
+	//! Number of currently open file handles
+	idx_t GetOpenFileCount() const;
+
+	//! Whether a failing worker stopped the pipeline
+	bool IsAborted() const;
+
+private:
+	void WorkerLoop();
+	//! Read a block, retrying transient errors. Returns false if the block failed permanently.
+	bool FetchWithRetry(RemoteFetchWork &work, char *buffer);
+	//! Release `count` references on a file, closing it and freeing its pool slot when none remain
+	void ReleaseFile(RemoteOpenFile &file, idx_t count);
+	//! Stop accepting work and wake up a planner waiting for a file slot
+	void Abort();
+
+	BoundedQueue<RemoteFetchWork> queue;
+	unique_ptr<ThreadPool> thread_pool;
+	vector<std::future<void>> worker_futures;
+	const RemoteRetryPolicy retry_policy;
+	PrewarmTaskTimings *timings;
+	atomic<idx_t> bytes_fetched;
+	atomic<idx_t> blocks_fetched;
+	atomic<idx_t> bytes_failed;
+	atomic<idx_t> blocks_failed;
+	atomic<idx_t> retries;
+	bool finished;
+
+	//! Handle pool accounting
+	const idx_t max_open_files;
+	mutable mutex file_slot_mu;
+	std::condition_variable file_slot_cv;
+	idx_t open_files;
+	bool aborted;
+	string first_failure;
+};
+
+} // namespace duckdb
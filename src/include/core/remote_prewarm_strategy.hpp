@@ -3,6 +3,7 @@
 #include "core/prewarm_strategy.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "core/remote_block_collector.hpp"
+#include "core/remote_fetch_pipeline.hpp"
 #include "duckdb/common/shared_ptr.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/common/types.hpp"
@@ -16,26 +17,80 @@ namespace duckdb {
 // Remote Prewarm Strategy
 //===--------------------------------------------------------------------===//
 
+//! Planning progress of a remote prewarm, used for budgeting and logging
+struct RemotePrewarmProgress {
+	//! Blocks planned across all files
+	idx_t total_blocks = 0;
+	//! Planned blocks not found in the cache
+	idx_t uncached_blocks = 0;
+	//! Blocks handed to the fetch workers
+	idx_t scheduled_blocks = 0;
+	//! When planning and fetching started
+	std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+};
+
 //! Strategy for prewarming remote file blocks into cache
 class RemotePrewarmStrategy : public PrewarmStrategy {
 public:
 	RemotePrewarmStrategy(ClientContext &context_p, FileSystem &fs_p);
 
+	string GetName() const override {
+		return "remote";
+	}
+
 	//! Execute prewarm on remote blocks
-	//! @param blocks Vector of blocks to prewarm
+	//! @param plan Blocks to prewarm
 	//! @param max_blocks Maximum blocks to prewarm (use UINT64_MAX / max idx_t value for no limit)
-	//! @return Number of bytes successfully prewarmed
-	virtual idx_t Execute(const RemoteFileBlockMap &file_blocks, idx_t max_blocks);
+	//! @return Bytes fetched, already cached and failed
+	virtual RemotePrewarmResult Execute(const RemoteBlockPlan &plan, idx_t max_blocks);
+
+	//! Execute prewarm on all files matching the glob pattern
+	//! Files are planned one at a time and their blocks are streamed into a bounded fetch queue, so I/O starts as soon
+	//! as the first file is planned and memory use does not grow with the number of blocks.
+	//! @param pattern Glob pattern of file path
+	//! @param block_size Size of each block (from cache_httpfs config)
+	//! @param max_blocks Maximum blocks to prewarm (use UINT64_MAX / max idx_t value for no limit)
+	//! @return Bytes fetched, already cached and failed
+	virtual RemotePrewarmResult Execute(const string &pattern, idx_t block_size, idx_t max_blocks);
+
+	//! Plan a prewarm of all files matching the glob pattern like Execute() would, without fetching any block. Files
+	//! are still listed and opened to learn their sizes.
+	PrewarmPlanSummary Plan(const string &pattern, idx_t block_size, idx_t max_blocks);
 
-	//! Filter out cached blocks from the given file path and blocks
-	virtual vector<RemoteBlockInfo> FilterCachedBlocks(const string &file_path, const vector<RemoteBlockInfo> &blocks);
+	//! Override retry behavior for failed block reads
+	void SetRetryPolicy(RemoteRetryPolicy retry_policy_p) {
+		retry_policy = retry_policy_p;
+	}
+
+	//! Filter out cached blocks from the given blocks of one file
+	virtual vector<RemoteBlockRef> FilterCachedBlocks(const RemoteFileDescriptor &file, idx_t block_size,
+	                                                  Span<const RemoteBlockRef> blocks);
 
 	//! Calculate maximum number of blocks that can be loaded based on available cache filesystem's capacity
 	BufferCapacityInfo CalculateMaxAvailableBlocks() override;
 
 protected:
+	//! Number of concurrent fetch workers for the given number of blocks
+	idx_t GetFetchWorkerCount(idx_t block_count) const;
+
+	//! Maximum number of concurrently open remote files, from the prewarm_remote_max_open_files setting
+	virtual idx_t GetMaxOpenFiles() const;
+
+	//! Filter the blocks of one file and submit the uncached ones to the pipeline, up to the remaining block budget
+	//! @param open_file The already opened file, or nullptr to open it lazily once a block needs fetching. The
+	//! planner's reference on it is released before returning.
+	//! @return false if the pipeline no longer accepts work
+	bool SubmitFileBlocks(RemoteFetchPipeline &pipeline, shared_ptr<RemoteOpenFile> open_file,
+	                      const RemoteFileDescriptor &file, idx_t block_size, Span<const RemoteBlockRef> blocks,
+	                      idx_t block_budget, RemotePrewarmProgress &progress);
+
+	//! Wait for the pipeline, add planner-side accounting and log the outcome
+	RemotePrewarmResult FinishPipeline(RemoteFetchPipeline &pipeline, const RemotePrewarmProgress &progress,
+	                                   idx_t block_budget);
+
 	ClientContext &context;
 	FileSystem &fs;
+	RemoteRetryPolicy retry_policy;
 };
 
 } // namespace duckdb
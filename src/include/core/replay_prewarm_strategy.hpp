@@ -0,0 +1,32 @@
+#pragma once
+
+#include "core/prewarm_strategy.hpp"
+
+namespace duckdb {
+
+//! Prewarm strategy: Load blocks into the buffer pool in a given order, e.g. the first-access order of a recorded
+//! trace, optionally within a time budget
+class ReplayPrewarmStrategy : public LocalPrewarmStrategy {
+public:
+	ReplayPrewarmStrategy(ClientContext &context_p, BlockManager &block_manager_p, BufferManager &buffer_manager_p)
+	    : LocalPrewarmStrategy(context_p, block_manager_p, buffer_manager_p) {
+	}
+
+	string GetName() const override {
+		return "replay";
+	}
+
+	//! Load blocks in ascending block order
+	idx_t Execute(AttachedDatabase &database, const BlockIdSet &block_ids, idx_t max_blocks) override;
+
+	//! Load blocks in the given order. Consecutive batches are loaded in parallel waves, so earlier blocks are loaded
+	//! no later than the wave that follows them.
+	//! @param ordered_block_ids Blocks in the order to load them, duplicates and blocks past the end of the file are
+	//! skipped
+	//! @param max_blocks Maximum number of blocks to load
+	//! @param time_budget_ms Stop starting new waves after this many milliseconds, 0 for no limit
+	//! @return Number of bytes loaded
+	idx_t Replay(const vector<block_id_t> &ordered_block_ids, idx_t max_blocks, idx_t time_budget_ms);
+};
+
+} // namespace duckdb
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/typedefs.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+class ClientContext;
+
+//===--------------------------------------------------------------------===//
+// Work Queue
+//===--------------------------------------------------------------------===//
+
+//! Hands out the items of a work list, by index, to worker tasks of the TaskScheduler. Workers claim the next item
+//! when done with the previous one, in list order, so a few slow items hold up only the workers processing them
+//! instead of a statically assigned share of the list.
+class WorkQueue {
+public:
+	explicit WorkQueue(idx_t item_count_p) : item_count(item_count_p) {
+	}
+
+	//! Claim the next item, thread-safe
+	//! @return false when all items have been claimed or the queue was cancelled
+	bool Next(idx_t &item);
+
+	//! Stop handing out items; workers finish the item they hold
+	void Cancel() {
+		cancelled = true;
+	}
+
+	idx_t Size() const {
+		return item_count;
+	}
+
+	//! Process every item on up to `max_workers` tasks of the TaskScheduler, including the calling thread
+	//! Exceptions thrown by `process` are rethrown once all workers have stopped.
+	void Run(ClientContext &context, idx_t max_workers, const std::function<void(idx_t)> &process);
+
+private:
+	const idx_t item_count;
+	atomic<idx_t> next_item {0};
+	atomic<bool> cancelled {false};
+};
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+class ExtensionLoader;
+
+namespace duckdb {
+
+//! Register the prewarm_dry_run and prewarm_remote_dry_run table functions
+void RegisterPrewarmDryRunFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
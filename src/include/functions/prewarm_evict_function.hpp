@@ -0,0 +1,10 @@
+#pragma once
+
+class ExtensionLoader;
+
+namespace duckdb {
+
+//! Register the prewarm_evict scalar function
+void RegisterPrewarmEvictFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "cache_prewarm_extension.hpp"
+
+namespace duckdb {
+
+//! Register the prewarm_file scalar function, which warms the OS page cache with local files
+void RegisterPrewarmFileFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+class ExtensionLoader;
+
+namespace duckdb {
+
+//! Register prewarm_keep and prewarm_unkeep scalar functions
+void RegisterPrewarmKeepFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+class ExtensionLoader;
+
+namespace duckdb {
+
+//! Register prewarm_export_manifest and prewarm_manifest scalar functions
+void RegisterPrewarmManifestFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
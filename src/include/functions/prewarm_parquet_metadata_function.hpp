@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "cache_prewarm_extension.hpp"
+
+namespace duckdb {
+
+//! Register the prewarm_parquet_metadata scalar function, which fills the Parquet metadata cache
+void RegisterPrewarmParquetMetadataFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
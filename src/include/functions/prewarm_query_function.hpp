@@ -0,0 +1,10 @@
+#pragma once
+
+class ExtensionLoader;
+
+namespace duckdb {
+
+//! Register the prewarm_query scalar function
+void RegisterPrewarmQueryFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+class ExtensionLoader;
+
+namespace duckdb {
+
+//! Register prewarm_record_start, prewarm_record_stop and prewarm_replay scalar functions
+void RegisterPrewarmRecordFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "cache_prewarm_extension.hpp"
+
+namespace duckdb {
+
+//! Register the prewarm_release scalar function, which unpins tables pinned by prewarm(table, 'pin')
+void RegisterPrewarmReleaseFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
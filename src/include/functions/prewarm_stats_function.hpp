@@ -0,0 +1,21 @@
+#pragma once
+
+#include "duckdb/common/enums/set_scope.hpp"
+
+class ExtensionLoader;
+
+namespace duckdb {
+
+class ClientContext;
+class Value;
+
+//! Register the prewarm_stats table function and the prewarm_stats_reset scalar function
+void RegisterPrewarmStatsFunctions(ExtensionLoader &loader);
+
+//! Set callback of the prewarm_stats_textfile setting: start, move or stop the periodic Prometheus textfile
+void SetPrewarmStatsTextfile(ClientContext &context, SetScope scope, Value &parameter);
+
+//! Set callback of the prewarm_stats_textfile_interval_ms setting: restart the textfile writer with the new interval
+void SetPrewarmStatsTextfileInterval(ClientContext &context, SetScope scope, Value &parameter);
+
+} // namespace duckdb
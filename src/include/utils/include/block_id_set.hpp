@@ -0,0 +1,123 @@
+#pragma once
+
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/storage/storage_info.hpp"
+
+#include <iterator>
+
+namespace duckdb {
+
+//! Run of consecutive block IDs
+struct BlockExtent {
+	block_id_t start;
+	idx_t count;
+
+	//! One past the last block of the extent
+	block_id_t End() const {
+		return start + static_cast<block_id_t>(count);
+	}
+	bool operator==(const BlockExtent &other) const {
+		return start == other.start && count == other.count;
+	}
+};
+
+//! Set of block IDs stored as ascending, non-overlapping and non-adjacent extents. Blocks of a table are mostly
+//! allocated in runs, so this takes a fraction of the memory of a hash set, iterates in file offset order, and
+//! supports union and difference in a single merge pass.
+class BlockIdSet {
+public:
+	//! Forward iterator over the block IDs in ascending order
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = block_id_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const block_id_t *;
+		using reference = block_id_t;
+
+		Iterator(const vector<BlockExtent> *extents_p, idx_t extent_idx_p)
+		    : extents(extents_p), extent_idx(extent_idx_p), offset(0) {
+		}
+
+		block_id_t operator*() const {
+			return (*extents)[extent_idx].start + static_cast<block_id_t>(offset);
+		}
+		Iterator &operator++() {
+			if (++offset == (*extents)[extent_idx].count) {
+				extent_idx++;
+				offset = 0;
+			}
+			return *this;
+		}
+		Iterator operator++(int) {
+			auto previous = *this;
+			++(*this);
+			return previous;
+		}
+		bool operator==(const Iterator &other) const {
+			return extent_idx == other.extent_idx && offset == other.offset;
+		}
+		bool operator!=(const Iterator &other) const {
+			return !(*this == other);
+		}
+
+	private:
+		const vector<BlockExtent> *extents;
+		idx_t extent_idx;
+		idx_t offset;
+	};
+
+	BlockIdSet() = default;
+
+	//! Build a set from block IDs in any order, duplicates are dropped
+	static BlockIdSet FromUnsorted(vector<block_id_t> block_ids);
+
+	//! Add a block not smaller than any block in the set, a duplicate of the last block is ignored
+	//! @throws InternalException if the block is smaller than the last block
+	void Append(block_id_t block_id);
+	//! Add an extent starting at or after the last block in the set, overlap with the last extent is merged
+	//! @throws InternalException if the extent starts before the last extent
+	void AppendExtent(block_id_t start, idx_t count);
+
+	//! Blocks in either set
+	BlockIdSet Union(const BlockIdSet &other) const;
+	//! Blocks in this set but not in the other
+	BlockIdSet Difference(const BlockIdSet &other) const;
+	//! The first (lowest) `max_blocks` blocks
+	BlockIdSet Prefix(idx_t max_blocks) const;
+	bool Contains(block_id_t block_id) const;
+
+	//! Number of blocks
+	idx_t size() const {
+		return block_count;
+	}
+	bool empty() const {
+		return block_count == 0;
+	}
+	const vector<BlockExtent> &GetExtents() const {
+		return extents;
+	}
+	//! All blocks in ascending order
+	vector<block_id_t> ToVector() const;
+
+	Iterator begin() const {
+		return Iterator(&extents, 0);
+	}
+	Iterator end() const {
+		return Iterator(&extents, extents.size());
+	}
+
+	bool operator==(const BlockIdSet &other) const {
+		return extents == other.extents;
+	}
+	bool operator!=(const BlockIdSet &other) const {
+		return !(*this == other);
+	}
+
+private:
+	vector<BlockExtent> extents;
+	idx_t block_count = 0;
+};
+
+} // namespace duckdb
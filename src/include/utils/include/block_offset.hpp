@@ -1,5 +1,6 @@
 #pragma once
 
+#include "duckdb/common/helper.hpp"
 #include "duckdb/storage/storage_info.hpp"
 
 namespace duckdb {
@@ -12,4 +13,14 @@ inline uint64_t GetBlockFileOffset(block_id_t block_id, idx_t block_size) {
 	return BLOCK_START + (static_cast<uint64_t>(block_id) * block_size);
 }
 
+//! Returns the bytes of a block that lie within a database file of `file_size` bytes: the block size, less for a
+//! block cut off by EOF, and 0 for a block past EOF (e.g. a partial block that was never flushed).
+inline idx_t GetBlockFileBytes(block_id_t block_id, idx_t block_size, idx_t file_size) {
+	const uint64_t offset = GetBlockFileOffset(block_id, block_size);
+	if (offset >= file_size) {
+		return 0;
+	}
+	return static_cast<idx_t>(MinValue<uint64_t>(block_size, file_size - offset));
+}
+
 } // namespace duckdb
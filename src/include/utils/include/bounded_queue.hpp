@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace duckdb {
+
+//! A blocking multi-producer multi-consumer queue with a fixed capacity.
+//! Push() blocks while the queue is full, which gives producers backpressure: a fast planner can never run more than
+//! `capacity` items ahead of the consumers. Close() stops accepting new items; consumers drain what is left.
+template <typename T>
+class BoundedQueue {
+public:
+	explicit BoundedQueue(size_t capacity_p) : capacity(std::max<size_t>(capacity_p, 1)), closed(false) {
+	}
+
+	BoundedQueue(const BoundedQueue &) = delete;
+	BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+	//! Enqueue an item, blocking while the queue is full
+	//! @return false if the queue has been closed, in which case the item is dropped
+	bool Push(T item) {
+		std::unique_lock<std::mutex> lock(mu);
+		not_full.wait(lock, [this]() { return closed || items.size() < capacity; });
+		if (closed) {
+			return false;
+		}
+		items.emplace_back(std::move(item));
+		not_empty.notify_one();
+		return true;
+	}
+
+	//! Dequeue an item, blocking while the queue is empty
+	//! @return false once the queue has been closed and fully drained
+	bool Pop(T &item) {
+		std::unique_lock<std::mutex> lock(mu);
+		not_empty.wait(lock, [this]() { return closed || !items.empty(); });
+		if (items.empty()) {
+			return false;
+		}
+		item = std::move(items.front());
+		items.pop_front();
+		not_full.notify_one();
+		return true;
+	}
+
+	//! Dequeue an item if one is queued, without blocking
+	//! @return false if the queue is empty
+	bool TryPop(T &item) {
+		std::lock_guard<std::mutex> lock(mu);
+		if (items.empty()) {
+			return false;
+		}
+		item = std::move(items.front());
+		items.pop_front();
+		not_full.notify_one();
+		return true;
+	}
+
+	//! Stop accepting new items and wake up all blocked producers and consumers
+	void Close() {
+		std::lock_guard<std::mutex> lock(mu);
+		closed = true;
+		not_full.notify_all();
+		not_empty.notify_all();
+	}
+
+	bool IsClosed() const {
+		std::lock_guard<std::mutex> lock(mu);
+		return closed;
+	}
+
+	size_t Size() const {
+		std::lock_guard<std::mutex> lock(mu);
+		return items.size();
+	}
+
+	size_t Capacity() const {
+		return capacity;
+	}
+
+private:
+	const size_t capacity;
+	mutable std::mutex mu;
+	std::condition_variable not_full;
+	std::condition_variable not_empty;
+	std::deque<T> items;
+	bool closed;
+};
+
+} // namespace duckdb
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/typedefs.hpp"
+
+namespace duckdb {
+
+//! Latency histogram with power-of-two microsecond buckets. Bucket i counts values up to 2^i us (about 67 seconds for
+//! the last bounded bucket), the overflow bucket everything above. Not thread-safe.
+class LatencyHistogram {
+public:
+	//! Bounded buckets plus the overflow bucket
+	static constexpr idx_t BUCKET_COUNT = 28;
+
+	void Add(uint64_t value_us) {
+		buckets[GetBucketIndex(value_us)]++;
+		count++;
+		sum_us += value_us;
+		max_us = MaxValue(max_us, value_us);
+	}
+
+	void Merge(const LatencyHistogram &other) {
+		for (idx_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+			buckets[bucket] += other.buckets[bucket];
+		}
+		count += other.count;
+		sum_us += other.sum_us;
+		max_us = MaxValue(max_us, other.max_us);
+	}
+
+	idx_t GetCount() const {
+		return count;
+	}
+	uint64_t GetSumUs() const {
+		return sum_us;
+	}
+	uint64_t GetMaxUs() const {
+		return max_us;
+	}
+	//! Number of values in the given bucket, not cumulative
+	idx_t GetBucketCount(idx_t bucket) const {
+		return buckets[bucket];
+	}
+
+	//! Inclusive upper bound of a bucket in microseconds, the maximum uint64_t for the overflow bucket
+	static uint64_t GetBucketUpperBound(idx_t bucket) {
+		if (bucket + 1 >= BUCKET_COUNT) {
+			return NumericLimits<uint64_t>::Maximum();
+		}
+		return 1ULL << bucket;
+	}
+
+	//! Approximate quantile: the upper bound of the bucket holding it, capped at the largest value seen
+	//! @param quantile Between 0 and 1
+	//! @return 0 if the histogram is empty
+	uint64_t GetQuantile(double quantile) const {
+		if (count == 0) {
+			return 0;
+		}
+		auto rank = static_cast<idx_t>(quantile * static_cast<double>(count));
+		rank = MinValue<idx_t>(MaxValue<idx_t>(rank, 1), count);
+		idx_t seen = 0;
+		for (idx_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+			seen += buckets[bucket];
+			if (seen >= rank) {
+				return MinValue(GetBucketUpperBound(bucket), max_us);
+			}
+		}
+		return max_us;
+	}
+
+private:
+	static idx_t GetBucketIndex(uint64_t value_us) {
+		idx_t bucket = 0;
+		while (bucket + 1 < BUCKET_COUNT && (1ULL << bucket) < value_us) {
+			bucket++;
+		}
+		return bucket;
+	}
+
+	array<idx_t, BUCKET_COUNT> buckets {};
+	idx_t count = 0;
+	uint64_t sum_us = 0;
+	uint64_t max_us = 0;
+};
+
+} // namespace duckdb
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+//! Read-only view of a whole file. Local files are memory-mapped so pages are only read when touched; remote files
+//! and platforms without mmap fall back to reading the file into memory through the given file system. Every file is
+//! opened through the file system first, pass the client's file system so its access settings apply. Local files are
+//! mapped through the path the file system resolved (`~` expanded, `file:` prefix dropped).
+class MappedFile {
+public:
+	//! @throws IOException if the file cannot be opened or mapped
+	//! @throws PermissionException if the file system does not allow access to the path
+	MappedFile(FileSystem &fs, const string &path);
+	~MappedFile();
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	const_data_ptr_t data() const {
+		return mapped_data ? mapped_data : buffer.data();
+	}
+	idx_t size() const {
+		return file_size;
+	}
+	//! Whether the contents are memory-mapped rather than copied
+	bool IsMapped() const {
+		return mapped_data != nullptr;
+	}
+
+private:
+	idx_t file_size;
+	//! Mapping of the file, nullptr when the contents live in `buffer`
+	const_data_ptr_t mapped_data;
+	vector<data_t> buffer;
+};
+
+} // namespace duckdb
@@ -0,0 +1,124 @@
+#include "utils/include/block_id_set.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/helper.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+BlockIdSet BlockIdSet::FromUnsorted(vector<block_id_t> block_ids) {
+	std::sort(block_ids.begin(), block_ids.end());
+	BlockIdSet result;
+	for (auto block_id : block_ids) {
+		result.Append(block_id);
+	}
+	return result;
+}
+
+void BlockIdSet::Append(block_id_t block_id) {
+	AppendExtent(block_id, 1);
+}
+
+void BlockIdSet::AppendExtent(block_id_t start, idx_t count) {
+	if (count == 0) {
+		return;
+	}
+	const block_id_t end = start + static_cast<block_id_t>(count);
+	if (!extents.empty()) {
+		auto &last = extents.back();
+		if (start < last.start) {
+			throw InternalException("BlockIdSet: extent starting at block %lld appended after block %lld",
+			                        static_cast<int64_t>(start), static_cast<int64_t>(last.start));
+		}
+		// Overlapping or adjacent: extend the last extent
+		if (start <= last.End()) {
+			if (end > last.End()) {
+				block_count += static_cast<idx_t>(end - last.End());
+				last.count = static_cast<idx_t>(end - last.start);
+			}
+			return;
+		}
+	}
+	extents.push_back(BlockExtent {start, count});
+	block_count += count;
+}
+
+BlockIdSet BlockIdSet::Union(const BlockIdSet &other) const {
+	BlockIdSet result;
+	result.extents.reserve(extents.size() + other.extents.size());
+	idx_t left = 0;
+	idx_t right = 0;
+	while (left < extents.size() || right < other.extents.size()) {
+		const bool take_left = right == other.extents.size() ||
+		                       (left < extents.size() && extents[left].start <= other.extents[right].start);
+		const auto &extent = take_left ? extents[left++] : other.extents[right++];
+		result.AppendExtent(extent.start, extent.count);
+	}
+	return result;
+}
+
+BlockIdSet BlockIdSet::Difference(const BlockIdSet &other) const {
+	BlockIdSet result;
+	idx_t other_idx = 0;
+	for (const auto &extent : extents) {
+		block_id_t current = extent.start;
+		const block_id_t end = extent.End();
+		while (other_idx < other.extents.size() && other.extents[other_idx].End() <= current) {
+			other_idx++;
+		}
+		// Cut every overlapping extent of the other set out of this one; the last may also overlap the next extent
+		for (idx_t idx = other_idx; idx < other.extents.size() && other.extents[idx].start < end; idx++) {
+			const auto &removed = other.extents[idx];
+			if (removed.start > current) {
+				result.AppendExtent(current, static_cast<idx_t>(removed.start - current));
+			}
+			current = MaxValue(current, removed.End());
+			if (current >= end) {
+				break;
+			}
+		}
+		if (current < end) {
+			result.AppendExtent(current, static_cast<idx_t>(end - current));
+		}
+	}
+	return result;
+}
+
+BlockIdSet BlockIdSet::Prefix(idx_t max_blocks) const {
+	if (max_blocks >= block_count) {
+		return *this;
+	}
+	BlockIdSet result;
+	for (const auto &extent : extents) {
+		if (result.block_count == max_blocks) {
+			break;
+		}
+		result.AppendExtent(extent.start, MinValue(extent.count, max_blocks - result.block_count));
+	}
+	return result;
+}
+
+bool BlockIdSet::Contains(block_id_t block_id) const {
+	// First extent starting after the block; the one before it is the only candidate
+	auto it = std::upper_bound(extents.begin(), extents.end(), block_id,
+	                           [](block_id_t value, const BlockExtent &extent) { return value < extent.start; });
+	if (it == extents.begin()) {
+		return false;
+	}
+	--it;
+	return block_id < it->End();
+}
+
+vector<block_id_t> BlockIdSet::ToVector() const {
+	vector<block_id_t> result;
+	result.reserve(block_count);
+	for (const auto &extent : extents) {
+		for (idx_t offset = 0; offset < extent.count; offset++) {
+			result.push_back(extent.start + static_cast<block_id_t>(offset));
+		}
+	}
+	return result;
+}
+
+} // namespace duckdb
@@ -0,0 +1,82 @@
+#include "utils/include/mapped_file.hpp"
+
+#include "scope_guard.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+#ifndef _WIN32
+//! Path of an opened local file for open(): the file system expanded `~` already, only a file: URI prefix is left
+string GetLocalPath(const FileHandle &handle) {
+	auto path = handle.GetPath();
+	if (StringUtil::StartsWith(path, "file://")) {
+		return path.substr(7);
+	}
+	if (StringUtil::StartsWith(path, "file:")) {
+		return path.substr(5);
+	}
+	return path;
+}
+#endif
+
+} // namespace
+
+MappedFile::MappedFile(FileSystem &fs, const string &path) : file_size(0), mapped_data(nullptr) {
+	// Open through the file system first, so its access checks (enable_external_access, allowed_directories) apply to
+	// local paths as well before they are mapped
+	auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_READ);
+#ifndef _WIN32
+	// Map the path the file system resolved, not the one given. If it cannot be opened directly (a path only the file
+	// system understands), the file is read through the handle instead.
+	int fd = FileSystem::IsRemoteFile(path) ? -1 : open(GetLocalPath(*handle).c_str(), O_RDONLY);
+	if (fd >= 0) {
+		SCOPE_EXIT {
+			close(fd);
+		};
+		struct stat st;
+		if (fstat(fd, &st) != 0) {
+			throw IOException("Cannot stat file '%s': %s", path, strerror(errno));
+		}
+		file_size = static_cast<idx_t>(st.st_size);
+		// mmap rejects empty mappings, an empty file is served from the (empty) buffer
+		if (file_size == 0) {
+			return;
+		}
+		void *mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED) {
+			throw IOException("Cannot map file '%s': %s", path, strerror(errno));
+		}
+		mapped_data = static_cast<const_data_ptr_t>(mapping);
+		return;
+	}
+#endif
+
+	file_size = NumericCast<idx_t>(fs.GetFileSize(*handle));
+	buffer.resize(file_size);
+	if (file_size > 0) {
+		handle->Read(buffer.data(), file_size, 0);
+	}
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+	if (mapped_data) {
+		munmap(const_cast<data_ptr_t>(mapped_data), file_size);
+	}
+#endif
+}
+
+} // namespace duckdb
@@ -4,6 +4,7 @@
 #include "duckdb/common/mutex.hpp"
 #include "duckdb/common/optional_ptr.hpp"
 #include "duckdb/common/string.hpp"
+#include "duckdb/common/unordered_set.hpp"
 #include "duckdb/common/vector.hpp"
 
 namespace duckdb {
@@ -16,6 +17,7 @@ namespace duckdb {
 class MockFileHandle : public FileHandle {
 public:
 	MockFileHandle(FileSystem &fs, const string &path_p, idx_t file_size_p);
+	~MockFileHandle() override;
 
 	void Close() override;
 
@@ -69,6 +71,10 @@ public:
 
 	void ConfigureGlobResults(const string &pattern, const vector<string> &results);
 	void ConfigureFileSize(const string &path, idx_t size);
+	//! Fail the next `count` reads of a file with a transient IO error
+	void ConfigureTransientReadFailures(const string &path, idx_t count);
+	//! Fail every read of a file with a permission error, which is not retried
+	void ConfigurePermanentReadFailure(const string &path);
 
 	idx_t GetOpenFileCallCount() const;
 	vector<OpenFileCall> GetOpenFileCalls() const;
@@ -80,6 +86,12 @@ public:
 	vector<ReadCall> GetReadCalls(const string &path) const;
 	idx_t GetTotalReadCallCount() const;
 
+	//! Number of handles currently open, and the highest number open at the same time
+	idx_t GetOpenHandleCount() const;
+	idx_t GetMaxConcurrentOpenHandleCount() const;
+	//! Invoked by MockFileHandle on destruction
+	void OnHandleClosed();
+
 	void Reset();
 
 	//===--------------------------------------------------------------------===//
@@ -96,6 +108,10 @@ private:
 	vector<ReadCall> read_calls;
 	unordered_map<string, vector<string>> configured_glob_results;
 	unordered_map<string, idx_t> configured_file_sizes;
+	unordered_map<string, idx_t> transient_read_failures;
+	unordered_set<string> permanent_read_failures;
+	idx_t open_handle_count = 0;
+	idx_t max_open_handle_count = 0;
 };
 
 } // namespace duckdb
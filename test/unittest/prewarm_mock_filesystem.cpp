@@ -1,5 +1,7 @@
 #include "prewarm_mock_filesystem.hpp"
 
+#include "duckdb/common/exception.hpp"
+
 #include <cstring>
 
 namespace duckdb {
@@ -12,6 +14,10 @@ MockFileHandle::MockFileHandle(FileSystem &fs, const string &path_p, idx_t file_
     : FileHandle(fs, path_p, FileOpenFlags::FILE_FLAGS_READ), file_size(file_size_p), should_fail(false) {
 }
 
+MockFileHandle::~MockFileHandle() {
+	file_system.Cast<MockFileSystem>().OnHandleClosed();
+}
+
 void MockFileHandle::Close() {
 }
 
@@ -66,6 +72,8 @@ unique_ptr<FileHandle> MockFileSystem::OpenFile(const string &path, FileOpenFlag
 	if (configured_file_sizes.find(path) != configured_file_sizes.end()) {
 		file_size = configured_file_sizes[path];
 	}
+	open_handle_count++;
+	max_open_handle_count = MaxValue(max_open_handle_count, open_handle_count);
 
 	return make_uniq<MockFileHandle>(*this, path, file_size);
 }
@@ -98,6 +106,14 @@ void MockFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, id
 	{
 		lock_guard<mutex> lock(mu);
 		read_calls.emplace_back(handle.path, static_cast<idx_t>(nr_bytes), location);
+		if (permanent_read_failures.count(handle.path)) {
+			throw PermissionException("Mock permission denied: %s", handle.path);
+		}
+		auto transient_entry = transient_read_failures.find(handle.path);
+		if (transient_entry != transient_read_failures.end() && transient_entry->second > 0) {
+			transient_entry->second--;
+			throw IOException("Mock transient read failure: %s", handle.path);
+		}
 	}
 
 	if (mock_handle.ShouldFail()) {
@@ -119,6 +135,16 @@ void MockFileSystem::ConfigureFileSize(const string &path, idx_t size) {
 	configured_file_sizes[path] = size;
 }
 
+void MockFileSystem::ConfigureTransientReadFailures(const string &path, idx_t count) {
+	lock_guard<mutex> lock(mu);
+	transient_read_failures[path] = count;
+}
+
+void MockFileSystem::ConfigurePermanentReadFailure(const string &path) {
+	lock_guard<mutex> lock(mu);
+	permanent_read_failures.insert(path);
+}
+
 idx_t MockFileSystem::GetOpenFileCallCount() const {
 	lock_guard<mutex> lock(mu);
 	return open_file_calls.size();
@@ -166,11 +192,27 @@ idx_t MockFileSystem::GetTotalReadCallCount() const {
 	return read_calls.size();
 }
 
+idx_t MockFileSystem::GetOpenHandleCount() const {
+	lock_guard<mutex> lock(mu);
+	return open_handle_count;
+}
+
+idx_t MockFileSystem::GetMaxConcurrentOpenHandleCount() const {
+	lock_guard<mutex> lock(mu);
+	return max_open_handle_count;
+}
+
+void MockFileSystem::OnHandleClosed() {
+	lock_guard<mutex> lock(mu);
+	open_handle_count--;
+}
+
 void MockFileSystem::Reset() {
 	lock_guard<mutex> lock(mu);
 	open_file_calls.clear();
 	glob_calls.clear();
 	read_calls.clear();
+	max_open_handle_count = open_handle_count;
 }
 
 string MockFileSystem::GetName() const {
@@ -0,0 +1,86 @@
+#include "catch/catch.hpp"
+
+#include "core/block_access_trace.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("BlockAccessTrace - Round Trip", "[block_access_trace]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &fs = FileSystem::GetFileSystem(*con.context);
+
+	BlockAccessTrace trace;
+	auto first_db = trace.AddDatabase("main_db", 17);
+	auto second_db = trace.AddDatabase("analytics", 0);
+	trace.AddEvent(first_db, 42, 0);
+	trace.AddEvent(second_db, 7, 150);
+	trace.AddEvent(first_db, 3, 150);
+	trace.AddEvent(first_db, 1000000, 9000);
+
+	auto trace_path = TestCreatePath("round_trip.trace");
+	trace.Write(fs, trace_path);
+	// Writing again replaces the file
+	trace.Write(fs, trace_path);
+
+	auto read_trace = BlockAccessTrace::Read(fs, trace_path);
+	REQUIRE(read_trace.GetDatabases() == vector<string> {"main_db", "analytics"});
+	REQUIRE(read_trace.GetCheckpointStamps() == vector<uint64_t> {17, 0});
+	auto &events = read_trace.GetEvents();
+	REQUIRE(events.size() == 4);
+	REQUIRE(events[0].database_index == first_db);
+	REQUIRE(events[0].block_id == 42);
+	REQUIRE(events[1].database_index == second_db);
+	REQUIRE(events[1].block_id == 7);
+	REQUIRE(events[1].first_access_us == 150);
+	REQUIRE(events[3].block_id == 1000000);
+	REQUIRE(events[3].first_access_us == 9000);
+}
+
+TEST_CASE("BlockAccessTrace - Empty Trace", "[block_access_trace]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &fs = FileSystem::GetFileSystem(*con.context);
+
+	auto trace_path = TestCreatePath("empty.trace");
+	BlockAccessTrace().Write(fs, trace_path);
+	auto read_trace = BlockAccessTrace::Read(fs, trace_path);
+	REQUIRE(read_trace.GetDatabases().empty());
+	REQUIRE(read_trace.GetEvents().empty());
+}
+
+TEST_CASE("BlockAccessTrace - Invalid Files", "[block_access_trace]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &fs = FileSystem::GetFileSystem(*con.context);
+
+	auto write_file = [&](const string &path, const string &content) {
+		auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_WRITE | FileOpenFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(const_cast<char *>(content.data()), content.size());
+	};
+
+	auto not_a_trace = TestCreatePath("not_a_trace.bin");
+	write_file(not_a_trace, "definitely not a trace file");
+	REQUIRE_THROWS_AS(BlockAccessTrace::Read(fs, not_a_trace), InvalidInputException);
+
+	// A valid header followed by a cut-off event list
+	BlockAccessTrace trace;
+	auto db_index = trace.AddDatabase("main_db", 3);
+	trace.AddEvent(db_index, 1, 0);
+	trace.AddEvent(db_index, 2, 10);
+	auto full_path = TestCreatePath("full.trace");
+	trace.Write(fs, full_path);
+	auto handle = fs.OpenFile(full_path, FileOpenFlags::FILE_FLAGS_READ);
+	auto size = NumericCast<idx_t>(fs.GetFileSize(*handle));
+	string content(size, '\0');
+	handle->Read(&content[0], size, 0);
+	handle.reset();
+
+	auto truncated = TestCreatePath("truncated.trace");
+	write_file(truncated, content.substr(0, size - 5));
+	REQUIRE_THROWS_AS(BlockAccessTrace::Read(fs, truncated), InvalidInputException);
+}
@@ -0,0 +1,92 @@
+#include "catch/catch.hpp"
+
+#include "utils/include/block_id_set.hpp"
+
+#include <vector>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+
+vector<BlockExtent> Extents(std::initializer_list<BlockExtent> extents) {
+	return vector<BlockExtent>(extents);
+}
+
+TEST_CASE("BlockIdSet - unsorted input is sorted, deduplicated and coalesced", "[block_id_set]") {
+	auto set = BlockIdSet::FromUnsorted({7, 3, 4, 5, 3, 10, 8, 12, 11});
+	REQUIRE(set.size() == 8);
+	REQUIRE(set.GetExtents() == Extents({{3, 3}, {7, 2}, {10, 3}}));
+	REQUIRE(set.ToVector() == vector<block_id_t> {3, 4, 5, 7, 8, 10, 11, 12});
+
+	vector<block_id_t> iterated(set.begin(), set.end());
+	REQUIRE(iterated == set.ToVector());
+}
+
+TEST_CASE("BlockIdSet - empty set", "[block_id_set]") {
+	BlockIdSet set;
+	REQUIRE(set.empty());
+	REQUIRE(set.size() == 0);
+	REQUIRE(set.begin() == set.end());
+	REQUIRE_FALSE(set.Contains(0));
+	REQUIRE(set.Union(set).empty());
+	REQUIRE(set.Difference(set).empty());
+}
+
+TEST_CASE("BlockIdSet - append merges overlapping and adjacent extents", "[block_id_set]") {
+	BlockIdSet set;
+	set.AppendExtent(0, 4);
+	set.AppendExtent(2, 4);
+	set.AppendExtent(6, 1);
+	set.Append(6);
+	set.AppendExtent(10, 0);
+	set.Append(20);
+	REQUIRE(set.GetExtents() == Extents({{0, 7}, {20, 1}}));
+	REQUIRE(set.size() == 8);
+
+	REQUIRE_THROWS(set.Append(5));
+}
+
+TEST_CASE("BlockIdSet - union", "[block_id_set]") {
+	auto left = BlockIdSet::FromUnsorted({1, 2, 3, 10, 11, 30});
+	auto right = BlockIdSet::FromUnsorted({4, 5, 11, 12, 20});
+	auto both = left.Union(right);
+	REQUIRE(both.GetExtents() == Extents({{1, 5}, {10, 3}, {20, 1}, {30, 1}}));
+	REQUIRE(both.size() == 10);
+	REQUIRE(both == right.Union(left));
+}
+
+TEST_CASE("BlockIdSet - difference", "[block_id_set]") {
+	BlockIdSet set;
+	set.AppendExtent(0, 10);
+	set.AppendExtent(20, 10);
+
+	BlockIdSet removed;
+	removed.AppendExtent(2, 2);
+	removed.AppendExtent(8, 14);
+	removed.Append(25);
+	removed.Append(40);
+
+	auto rest = set.Difference(removed);
+	REQUIRE(rest.GetExtents() == Extents({{0, 2}, {4, 4}, {22, 3}, {26, 4}}));
+	REQUIRE(rest.size() == 13);
+
+	REQUIRE(set.Difference(set).empty());
+	REQUIRE(set.Difference(BlockIdSet()) == set);
+	REQUIRE(removed.Difference(set).ToVector() == vector<block_id_t> {40});
+}
+
+TEST_CASE("BlockIdSet - prefix and contains", "[block_id_set]") {
+	auto set = BlockIdSet::FromUnsorted({1, 2, 3, 7, 8, 9});
+	REQUIRE(set.Prefix(4).ToVector() == vector<block_id_t> {1, 2, 3, 7});
+	REQUIRE(set.Prefix(0).empty());
+	REQUIRE(set.Prefix(100) == set);
+
+	REQUIRE(set.Contains(1));
+	REQUIRE(set.Contains(3));
+	REQUIRE_FALSE(set.Contains(4));
+	REQUIRE(set.Contains(9));
+	REQUIRE_FALSE(set.Contains(10));
+	REQUIRE_FALSE(set.Contains(0));
+}
+
+} // namespace
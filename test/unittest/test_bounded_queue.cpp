@@ -0,0 +1,131 @@
+#include "catch/catch.hpp"
+
+#include "utils/include/bounded_queue.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+
+TEST_CASE("BoundedQueue - push and pop in FIFO order", "[bounded_queue]") {
+	BoundedQueue<int> queue(4);
+	REQUIRE(queue.Capacity() == 4);
+	REQUIRE(queue.Push(1));
+	REQUIRE(queue.Push(2));
+	REQUIRE(queue.Push(3));
+	REQUIRE(queue.Size() == 3);
+
+	int item = 0;
+	REQUIRE(queue.Pop(item));
+	REQUIRE(item == 1);
+	REQUIRE(queue.Pop(item));
+	REQUIRE(item == 2);
+	REQUIRE(queue.Pop(item));
+	REQUIRE(item == 3);
+	REQUIRE(queue.Size() == 0);
+}
+
+TEST_CASE("BoundedQueue - zero capacity is clamped to one", "[bounded_queue]") {
+	BoundedQueue<int> queue(0);
+	REQUIRE(queue.Capacity() == 1);
+}
+
+TEST_CASE("BoundedQueue - close drains remaining items", "[bounded_queue]") {
+	BoundedQueue<int> queue(4);
+	REQUIRE(queue.Push(1));
+	REQUIRE(queue.Push(2));
+	queue.Close();
+	REQUIRE(queue.IsClosed());
+
+	// No new items are accepted after close
+	REQUIRE_FALSE(queue.Push(3));
+
+	// Existing items are still delivered
+	int item = 0;
+	REQUIRE(queue.Pop(item));
+	REQUIRE(item == 1);
+	REQUIRE(queue.Pop(item));
+	REQUIRE(item == 2);
+	REQUIRE_FALSE(queue.Pop(item));
+}
+
+TEST_CASE("BoundedQueue - close wakes up blocked consumers", "[bounded_queue]") {
+	BoundedQueue<int> queue(1);
+	std::atomic<bool> popped {true};
+	std::thread consumer([&]() {
+		int item = 0;
+		popped = queue.Pop(item);
+	});
+	queue.Close();
+	consumer.join();
+	REQUIRE_FALSE(popped.load());
+}
+
+TEST_CASE("BoundedQueue - producer is throttled by capacity", "[bounded_queue]") {
+	constexpr size_t CAPACITY = 2;
+	constexpr int ITEM_COUNT = 1000;
+	BoundedQueue<int> queue(CAPACITY);
+	std::atomic<size_t> max_observed_size {0};
+	std::atomic<bool> all_pushed {true};
+
+	std::thread producer([&]() {
+		for (int idx = 0; idx < ITEM_COUNT; idx++) {
+			if (!queue.Push(idx)) {
+				all_pushed = false;
+			}
+			auto size = queue.Size();
+			auto current_max = max_observed_size.load();
+			while (size > current_max && !max_observed_size.compare_exchange_weak(current_max, size)) {
+			}
+		}
+		queue.Close();
+	});
+
+	std::vector<int> consumed;
+	int item = 0;
+	while (queue.Pop(item)) {
+		consumed.push_back(item);
+	}
+	producer.join();
+
+	REQUIRE(all_pushed.load());
+	REQUIRE(consumed.size() == ITEM_COUNT);
+	for (int idx = 0; idx < ITEM_COUNT; idx++) {
+		REQUIRE(consumed[idx] == idx);
+	}
+	REQUIRE(max_observed_size.load() <= CAPACITY);
+}
+
+TEST_CASE("BoundedQueue - multiple consumers see every item once", "[bounded_queue]") {
+	constexpr int ITEM_COUNT = 10000;
+	constexpr int CONSUMER_COUNT = 4;
+	BoundedQueue<int> queue(8);
+	std::atomic<long long> sum {0};
+	std::atomic<int> count {0};
+
+	std::vector<std::thread> consumers;
+	for (int idx = 0; idx < CONSUMER_COUNT; idx++) {
+		consumers.emplace_back([&]() {
+			int item = 0;
+			while (queue.Pop(item)) {
+				sum += item;
+				count++;
+			}
+		});
+	}
+	for (int idx = 0; idx < ITEM_COUNT; idx++) {
+		REQUIRE(queue.Push(idx));
+	}
+	queue.Close();
+	for (auto &consumer : consumers) {
+		consumer.join();
+	}
+
+	REQUIRE(count.load() == ITEM_COUNT);
+	REQUIRE(sum.load() == static_cast<long long>(ITEM_COUNT) * (ITEM_COUNT - 1) / 2);
+}
+
+} // namespace
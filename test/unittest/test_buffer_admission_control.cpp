@@ -0,0 +1,157 @@
+#include "catch/catch.hpp"
+
+#include "core/block_collector.hpp"
+#include "core/block_evictor.hpp"
+#include "core/buffer_admission_control.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/storage/buffer/block_handle.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+
+constexpr idx_t TEST_BLOCK_SIZE = 256ULL * 1024ULL;
+
+BufferCapacityInfo MakeCapacityInfo(BufferManager &buffer_manager, idx_t max_blocks) {
+	BufferCapacityInfo info;
+	info.block_size = TEST_BLOCK_SIZE;
+	info.max_capacity = buffer_manager.GetMaxMemory();
+	info.used_space = buffer_manager.GetUsedMemory();
+	info.available_space = info.max_capacity - info.used_space;
+	info.max_blocks = max_blocks;
+	return info;
+}
+
+string CreateDatabasePath(const string &name) {
+	auto path = TestCreatePath(name + ".db");
+	DeleteDatabase(path);
+	return path;
+}
+
+//! A checkpointed table of a persistent database, with none of its blocks in the buffer pool
+struct PersistentTable {
+	explicit PersistentTable(const string &name) : path(CreateDatabasePath(name)), db(path), con(db) {
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE t AS SELECT (random() * 1e9)::BIGINT AS v FROM range(1000000)"));
+		REQUIRE_NO_FAIL(con.Query("CHECKPOINT"));
+		database = DatabaseManager::Get(*db.instance).GetDatabase(name);
+		con.BeginTransaction();
+		auto resolved = BlockCollector::ResolveTable(*con.context, "t");
+		block_ids = BlockCollector::CollectTableBlocks(*con.context, resolved.table);
+		con.Commit();
+		BlockEvictor::EvictFromBufferPool(*database, block_ids);
+	}
+
+	//! Register the table's blocks and load them, one batch per block
+	vector<shared_ptr<BlockHandle>> Load(BufferManager &buffer_manager) {
+		auto &block_manager = StorageManager::Get(*database).GetBlockManager();
+		vector<shared_ptr<BlockHandle>> handles;
+		for (block_id_t block_id : block_ids) {
+			handles.push_back(block_manager.RegisterBlock(block_id));
+		}
+		buffer_manager.Prefetch(handles);
+		return handles;
+	}
+
+	string path;
+	DuckDB db;
+	Connection con;
+	shared_ptr<AttachedDatabase> database;
+	BlockIdSet block_ids;
+};
+
+TEST_CASE("BufferAdmissionControl - batches within the planned usage are admitted", "[buffer_admission_control]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &buffer_manager = BufferManager::GetBufferManager(*con.context);
+
+	BufferAdmissionControl admission(buffer_manager, MakeCapacityInfo(buffer_manager, 64));
+	REQUIRE(admission.GetUsageLimit() >= 64 * TEST_BLOCK_SIZE);
+	REQUIRE(admission.Admit(16));
+	REQUIRE(admission.Admit(16));
+	REQUIRE(admission.GetStopReason() == AdmissionStopReason::NONE);
+}
+
+TEST_CASE("BufferAdmissionControl - a batch past the limit stops admission", "[buffer_admission_control]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &buffer_manager = BufferManager::GetBufferManager(*con.context);
+
+	BufferAdmissionControl admission(buffer_manager, MakeCapacityInfo(buffer_manager, 8));
+	REQUIRE_FALSE(admission.Admit(9));
+	REQUIRE(admission.GetStopReason() == AdmissionStopReason::MEMORY_PRESSURE);
+
+	// The first refusal is final, even for batches that would fit
+	REQUIRE_FALSE(admission.Admit(1));
+	REQUIRE(admission.GetStopReason() == AdmissionStopReason::MEMORY_PRESSURE);
+}
+
+TEST_CASE("BufferAdmissionControl - a zero budget admits nothing", "[buffer_admission_control]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &buffer_manager = BufferManager::GetBufferManager(*con.context);
+
+	BufferAdmissionControl admission(buffer_manager, MakeCapacityInfo(buffer_manager, 0));
+	REQUIRE_FALSE(admission.Admit(1));
+	REQUIRE(BufferAdmissionControl::StopReasonToString(admission.GetStopReason()).find("headroom") != string::npos);
+}
+
+TEST_CASE("BufferAdmissionControl - eviction of tracked batches stops admission", "[buffer_admission_control]") {
+	PersistentTable table("admission_eviction");
+	auto &buffer_manager = BufferManager::GetBufferManager(*table.con.context);
+	auto handles = table.Load(buffer_manager);
+	REQUIRE(handles.size() >= 8);
+
+	BufferAdmissionControl admission(buffer_manager, MakeCapacityInfo(buffer_manager, 1024));
+	for (const auto &handle : handles) {
+		admission.Track({handle});
+	}
+	REQUIRE(admission.Admit(1));
+
+	BlockEvictor::EvictFromBufferPool(*table.database, table.block_ids);
+	REQUIRE_FALSE(admission.Admit(1));
+	REQUIRE(admission.GetStopReason() == AdmissionStopReason::EVICTION);
+}
+
+TEST_CASE("BufferAdmissionControl - a few evicted batches are tolerated", "[buffer_admission_control]") {
+	PersistentTable table("admission_tolerance");
+	auto &buffer_manager = BufferManager::GetBufferManager(*table.con.context);
+	auto handles = table.Load(buffer_manager);
+	REQUIRE(handles.size() >= 10);
+
+	BufferAdmissionControl admission(buffer_manager, MakeCapacityInfo(buffer_manager, 1024));
+	for (const auto &handle : handles) {
+		admission.Track({handle});
+	}
+
+	// One evicted batch out of ten or more is within the share concurrent queries may evict, and once seen it is no
+	// longer watched: a full sweep over the watched batches keeps admitting
+	auto first_block = BlockIdSet::FromUnsorted({handles[0]->BlockId()});
+	BlockEvictor::EvictFromBufferPool(*table.database, first_block);
+	for (idx_t idx = 0; idx < handles.size(); idx++) {
+		REQUIRE(admission.Admit(1));
+	}
+	REQUIRE(admission.GetStopReason() == AdmissionStopReason::NONE);
+}
+
+TEST_CASE("BufferAdmissionControl - batches without loaded blocks are not tracked", "[buffer_admission_control]") {
+	PersistentTable table("admission_unloaded");
+	auto &buffer_manager = BufferManager::GetBufferManager(*table.con.context);
+	auto &block_manager = StorageManager::Get(*table.database).GetBlockManager();
+	vector<shared_ptr<BlockHandle>> unloaded;
+	for (block_id_t block_id : table.block_ids) {
+		unloaded.push_back(block_manager.RegisterBlock(block_id));
+	}
+
+	// None of the blocks is loaded, so none of them can count as evicted
+	BufferAdmissionControl admission(buffer_manager, MakeCapacityInfo(buffer_manager, 1024));
+	admission.Track(unloaded);
+	REQUIRE(admission.Admit(1));
+	REQUIRE(admission.GetStopReason() == AdmissionStopReason::NONE);
+}
+
+} // namespace
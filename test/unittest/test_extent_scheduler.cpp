@@ -0,0 +1,121 @@
+#include "catch/catch.hpp"
+
+#include "core/extent_scheduler.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "test_helpers.hpp"
+
+#include <mutex>
+#include <tuple>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+
+vector<ExtentChunk> DrainChunks(ExtentScheduler &scheduler) {
+	vector<ExtentChunk> chunks;
+	ExtentChunk chunk;
+	while (scheduler.Next(chunk)) {
+		chunks.push_back(chunk);
+	}
+	return chunks;
+}
+
+TEST_CASE("ExtentScheduler - chunks split at gaps and at the chunk size", "[extent_scheduler]") {
+	ExtentScheduler scheduler({1, 2, 3, 4, 5, 10, 11, 20}, 2);
+	REQUIRE(scheduler.ChunkCount() == 5);
+
+	auto chunks = DrainChunks(scheduler);
+	REQUIRE(chunks.size() == 5);
+	const vector<std::tuple<idx_t, block_id_t, idx_t>> expected {
+	    {0, 1, 2}, {2, 3, 2}, {4, 5, 1}, {5, 10, 2}, {7, 20, 1}};
+	for (idx_t idx = 0; idx < chunks.size(); idx++) {
+		REQUIRE(chunks[idx].offset == std::get<0>(expected[idx]));
+		REQUIRE(chunks[idx].first_block == std::get<1>(expected[idx]));
+		REQUIRE(chunks[idx].count == std::get<2>(expected[idx]));
+	}
+
+	// Exhausted for good
+	ExtentChunk chunk;
+	REQUIRE_FALSE(scheduler.Next(chunk));
+}
+
+TEST_CASE("ExtentScheduler - block sets are chunked by extent", "[extent_scheduler]") {
+	auto block_ids = BlockIdSet::FromUnsorted({20, 1, 2, 3, 4, 5, 10, 11});
+	ExtentScheduler from_set(block_ids, 2);
+	ExtentScheduler from_vector(block_ids.ToVector(), 2);
+	REQUIRE(from_set.ChunkCount() == from_vector.ChunkCount());
+
+	auto set_chunks = DrainChunks(from_set);
+	auto vector_chunks = DrainChunks(from_vector);
+	for (idx_t idx = 0; idx < set_chunks.size(); idx++) {
+		REQUIRE(set_chunks[idx].offset == vector_chunks[idx].offset);
+		REQUIRE(set_chunks[idx].first_block == vector_chunks[idx].first_block);
+		REQUIRE(set_chunks[idx].count == vector_chunks[idx].count);
+	}
+}
+
+TEST_CASE("ExtentScheduler - empty plan and zero chunk size", "[extent_scheduler]") {
+	ExtentScheduler empty({}, 4);
+	REQUIRE(empty.ChunkCount() == 0);
+	ExtentChunk chunk;
+	REQUIRE_FALSE(empty.Next(chunk));
+
+	// A chunk size of 0 is raised to one block per chunk
+	ExtentScheduler single({7, 8}, 0);
+	REQUIRE(single.ChunkCount() == 2);
+}
+
+TEST_CASE("ExtentScheduler - cancelled schedulers hand out no more chunks", "[extent_scheduler]") {
+	ExtentScheduler scheduler({1, 2, 3, 4, 5, 6}, 1);
+	ExtentChunk chunk;
+	REQUIRE(scheduler.Next(chunk));
+	REQUIRE(chunk.first_block == 1);
+	scheduler.Cancel();
+	REQUIRE_FALSE(scheduler.Next(chunk));
+}
+
+TEST_CASE("ExtentScheduler - Run processes every block once", "[extent_scheduler]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	vector<block_id_t> block_ids;
+	for (block_id_t block_id = 0; block_id < 1000; block_id++) {
+		if (block_id % 7 != 0) {
+			block_ids.push_back(block_id);
+		}
+	}
+	ExtentScheduler scheduler(block_ids, 5);
+
+	std::mutex lock;
+	vector<idx_t> seen(block_ids.size(), 0);
+	idx_t mismatches = 0;
+	scheduler.Run(*con.context, 4, [&](const ExtentChunk &chunk) {
+		std::lock_guard<std::mutex> guard(lock);
+		for (idx_t idx = 0; idx < chunk.count; idx++) {
+			if (block_ids[chunk.offset + idx] != chunk.first_block + static_cast<block_id_t>(idx)) {
+				mismatches++;
+			}
+			seen[chunk.offset + idx]++;
+		}
+	});
+	REQUIRE(mismatches == 0);
+	for (auto count : seen) {
+		REQUIRE(count == 1);
+	}
+}
+
+TEST_CASE("ExtentScheduler - Run rethrows worker errors", "[extent_scheduler]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	ExtentScheduler scheduler({1, 2, 3}, 1);
+	REQUIRE_THROWS(scheduler.Run(*con.context, 2, [](const ExtentChunk &chunk) {
+		if (chunk.first_block == 2) {
+			throw IOException("injected failure");
+		}
+	}));
+}
+
+} // namespace
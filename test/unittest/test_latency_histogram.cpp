@@ -0,0 +1,72 @@
+#include "catch/catch.hpp"
+
+#include "utils/include/latency_histogram.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+
+TEST_CASE("LatencyHistogram - empty histogram", "[latency_histogram]") {
+	LatencyHistogram histogram;
+	REQUIRE(histogram.GetCount() == 0);
+	REQUIRE(histogram.GetSumUs() == 0);
+	REQUIRE(histogram.GetMaxUs() == 0);
+	REQUIRE(histogram.GetQuantile(0.5) == 0);
+}
+
+TEST_CASE("LatencyHistogram - values land in power-of-two buckets", "[latency_histogram]") {
+	LatencyHistogram histogram;
+	histogram.Add(0);
+	histogram.Add(1);
+	histogram.Add(2);
+	histogram.Add(3);
+	histogram.Add(1024);
+	histogram.Add(1025);
+
+	REQUIRE(histogram.GetBucketCount(0) == 2);
+	REQUIRE(histogram.GetBucketCount(1) == 1);
+	REQUIRE(histogram.GetBucketCount(2) == 1);
+	REQUIRE(histogram.GetBucketCount(10) == 1);
+	REQUIRE(histogram.GetBucketCount(11) == 1);
+	REQUIRE(histogram.GetCount() == 6);
+	REQUIRE(histogram.GetSumUs() == 2055);
+	REQUIRE(histogram.GetMaxUs() == 1025);
+}
+
+TEST_CASE("LatencyHistogram - overflow bucket", "[latency_histogram]") {
+	LatencyHistogram histogram;
+	const idx_t overflow_bucket = LatencyHistogram::BUCKET_COUNT - 1;
+	histogram.Add(LatencyHistogram::GetBucketUpperBound(overflow_bucket - 1) + 1);
+	REQUIRE(histogram.GetBucketCount(overflow_bucket) == 1);
+	REQUIRE(LatencyHistogram::GetBucketUpperBound(overflow_bucket) == NumericLimits<uint64_t>::Maximum());
+}
+
+TEST_CASE("LatencyHistogram - quantiles are bucket upper bounds capped at the max", "[latency_histogram]") {
+	LatencyHistogram histogram;
+	for (idx_t idx = 0; idx < 99; idx++) {
+		histogram.Add(100);
+	}
+	histogram.Add(5000);
+
+	// 100us falls into the (64, 128] bucket
+	REQUIRE(histogram.GetQuantile(0.5) == 128);
+	REQUIRE(histogram.GetQuantile(0.99) == 128);
+	REQUIRE(histogram.GetQuantile(1.0) == 5000);
+}
+
+TEST_CASE("LatencyHistogram - merge adds counts", "[latency_histogram]") {
+	LatencyHistogram first;
+	LatencyHistogram second;
+	first.Add(10);
+	second.Add(10);
+	second.Add(300);
+	first.Merge(second);
+
+	REQUIRE(first.GetCount() == 3);
+	REQUIRE(first.GetSumUs() == 320);
+	REQUIRE(first.GetMaxUs() == 300);
+	REQUIRE(first.GetBucketCount(4) == 2);
+	REQUIRE(first.GetBucketCount(9) == 1);
+}
+
+} // namespace
@@ -0,0 +1,86 @@
+#include "catch/catch.hpp"
+
+#include "core/os_memory.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+
+constexpr idx_t MIB = 1024ULL * 1024ULL;
+
+TEST_CASE("ParseMemAvailable - reads the kB value", "[os_memory]") {
+	const string meminfo = "MemTotal:       16384000 kB\n"
+	                       "MemFree:         1024000 kB\n"
+	                       "MemAvailable:    8192000 kB\n"
+	                       "Buffers:          102400 kB\n";
+	REQUIRE(ParseMemAvailable(meminfo) == 8192000ULL * 1024ULL);
+	REQUIRE(ParseMemAvailable("MemTotal: 16384000 kB\n") == OS_MEMORY_UNKNOWN);
+	REQUIRE(ParseMemAvailable("MemAvailable: lots kB\n") == OS_MEMORY_UNKNOWN);
+	REQUIRE(ParseMemAvailable("") == OS_MEMORY_UNKNOWN);
+}
+
+TEST_CASE("ParseCgroupMemoryValue - numbers and max", "[os_memory]") {
+	REQUIRE(ParseCgroupMemoryValue("536870912\n") == 536870912ULL);
+	REQUIRE(ParseCgroupMemoryValue("max\n") == OS_MEMORY_UNKNOWN);
+	REQUIRE(ParseCgroupMemoryValue("") == OS_MEMORY_UNKNOWN);
+	REQUIRE(ParseCgroupMemoryValue("99999999999999999999999") == OS_MEMORY_UNKNOWN);
+}
+
+TEST_CASE("ParseCgroupMemoryStat - finds the field", "[os_memory]") {
+	const string memory_stat = "anon 104857600\n"
+	                           "file 209715200\n"
+	                           "active_file 52428800\n"
+	                           "inactive_file 157286400\n";
+	REQUIRE(ParseCgroupMemoryStat(memory_stat, "inactive_file") == 157286400ULL);
+	REQUIRE(ParseCgroupMemoryStat(memory_stat, "file") == 209715200ULL);
+	REQUIRE(ParseCgroupMemoryStat(memory_stat, "shmem") == OS_MEMORY_UNKNOWN);
+}
+
+TEST_CASE("ParseCgroupV2Path - unified hierarchy line", "[os_memory]") {
+	REQUIRE(ParseCgroupV2Path("0::/system.slice/duckdb.service\n") == "/system.slice/duckdb.service");
+	REQUIRE(ParseCgroupV2Path("0::/\n") == "/");
+	// Hybrid hierarchy: v1 controllers plus the v2 line
+	REQUIRE(ParseCgroupV2Path("12:memory:/docker/abc\n0::/docker/abc\n") == "/docker/abc");
+	// Pure cgroup v1
+	REQUIRE(ParseCgroupV2Path("12:memory:/docker/abc\n11:cpu:/docker/abc\n").empty());
+}
+
+TEST_CASE("CalculatePageCacheBudget - the lower of host and cgroup headroom", "[os_memory]") {
+	OSMemoryInfo info;
+	info.mem_available = 1000 * MIB;
+
+	// Host only
+	auto budget = CalculatePageCacheBudget(info, 0.8);
+	REQUIRE(budget.available_bytes == 1000 * MIB);
+	REQUIRE(budget.budget_bytes == 800 * MIB);
+	REQUIRE(budget.source == "MemAvailable");
+
+	// The cgroup can take max - current plus its cold page cache
+	info.cgroup_max = 512 * MIB;
+	info.cgroup_current = 400 * MIB;
+	info.cgroup_inactive_file = 100 * MIB;
+	budget = CalculatePageCacheBudget(info, 0.5);
+	REQUIRE(budget.available_bytes == 212 * MIB);
+	REQUIRE(budget.budget_bytes == 106 * MIB);
+	REQUIRE(budget.source == "cgroup memory.max");
+
+	// A cgroup over its limit has no room left
+	info.cgroup_current = 700 * MIB;
+	info.cgroup_inactive_file = 0;
+	budget = CalculatePageCacheBudget(info, 0.8);
+	REQUIRE(budget.budget_bytes == 0);
+
+	// A cgroup limit above MemAvailable does not raise the budget
+	info.cgroup_max = 64ULL * 1024ULL * MIB;
+	info.cgroup_current = 0;
+	budget = CalculatePageCacheBudget(info, 0.8);
+	REQUIRE(budget.available_bytes == 1000 * MIB);
+}
+
+TEST_CASE("CalculatePageCacheBudget - unknown without any figure", "[os_memory]") {
+	auto budget = CalculatePageCacheBudget(OSMemoryInfo(), 0.8);
+	REQUIRE(budget.source.empty());
+	REQUIRE(budget.budget_bytes == OS_MEMORY_UNKNOWN);
+}
+
+} // namespace
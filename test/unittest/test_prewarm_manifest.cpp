@@ -0,0 +1,122 @@
+#include "catch/catch.hpp"
+
+#include "core/prewarm_manifest.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+
+string ReadFileContent(FileSystem &fs, const string &path) {
+	auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_READ);
+	auto size = NumericCast<idx_t>(fs.GetFileSize(*handle));
+	string content(size, '\0');
+	handle->Read(&content[0], size, 0);
+	return content;
+}
+
+void WriteFileContent(FileSystem &fs, const string &path, const string &content) {
+	auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_WRITE | FileOpenFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	handle->Write(const_cast<char *>(content.data()), content.size());
+}
+
+} // namespace
+
+TEST_CASE("PrewarmManifest - Round Trip", "[prewarm_manifest]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &fs = FileSystem::GetFileSystem(*con.context);
+
+	PrewarmManifestWriter writer;
+	writer.AddDatabase("main_db", "/data/main.db", 17, 262144, {1000000, 3, 42, 3, 0, -1});
+	writer.AddRemoteFile("s3://bucket/a.parquet", 10000, {{9000, 1000}, {0, 100}, {50, 100}, {150, 10}, {500, 0}});
+	writer.AddDatabase("empty_db", "", 0, 262144, {});
+	// Duplicate and negative block IDs are dropped, the adjacent ranges merged into one
+	REQUIRE(writer.EntryCount() == 6);
+
+	auto manifest_path = TestCreatePath("round_trip.manifest");
+	writer.Write(fs, manifest_path);
+	// Writing again replaces the file
+	writer.Write(fs, manifest_path);
+
+	PrewarmManifestReader reader(fs, manifest_path);
+	auto &databases = reader.GetDatabases();
+	REQUIRE(databases.size() == 2);
+	REQUIRE(databases[0].database_name == "main_db");
+	REQUIRE(databases[0].database_path == "/data/main.db");
+	REQUIRE(databases[0].checkpoint_stamp == 17);
+	REQUIRE(databases[0].block_size == 262144);
+	REQUIRE(databases[0].block_count == 4);
+	REQUIRE(databases[0].DecodeBlockIds() == vector<block_id_t> {0, 3, 42, 1000000});
+	REQUIRE(databases[1].database_name == "empty_db");
+	REQUIRE(databases[1].DecodeBlockIds().empty());
+
+	auto &remote_files = reader.GetRemoteFiles();
+	REQUIRE(remote_files.size() == 1);
+	REQUIRE(remote_files[0].file_path == "s3://bucket/a.parquet");
+	REQUIRE(remote_files[0].file_size == 10000);
+	auto ranges = remote_files[0].DecodeRanges();
+	REQUIRE(ranges.size() == 2);
+	REQUIRE(ranges[0] == std::make_pair<idx_t, idx_t>(0, 160));
+	REQUIRE(ranges[1] == std::make_pair<idx_t, idx_t>(9000, 1000));
+}
+
+TEST_CASE("PrewarmManifest - Large Block List", "[prewarm_manifest]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &fs = FileSystem::GetFileSystem(*con.context);
+
+	vector<block_id_t> block_ids;
+	for (block_id_t block_id = 0; block_id < 1000000; block_id += 2) {
+		block_ids.push_back(block_id);
+	}
+	PrewarmManifestWriter writer;
+	writer.AddDatabase("main_db", "/data/main.db", 1, 262144, block_ids);
+	auto manifest_path = TestCreatePath("large.manifest");
+	writer.Write(fs, manifest_path);
+
+	// Delta encoding stores each of these IDs in a single byte
+	auto handle = fs.OpenFile(manifest_path, FileOpenFlags::FILE_FLAGS_READ);
+	REQUIRE(NumericCast<idx_t>(fs.GetFileSize(*handle)) < block_ids.size() + 128);
+	handle.reset();
+
+	PrewarmManifestReader reader(fs, manifest_path);
+	REQUIRE(reader.GetDatabases().size() == 1);
+	REQUIRE(reader.GetDatabases()[0].DecodeBlockIds() == block_ids);
+}
+
+TEST_CASE("PrewarmManifest - Invalid Files", "[prewarm_manifest]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &fs = FileSystem::GetFileSystem(*con.context);
+
+	auto not_a_manifest = TestCreatePath("not_a_manifest.bin");
+	WriteFileContent(fs, not_a_manifest, "definitely not a manifest file");
+	REQUIRE_THROWS_AS(PrewarmManifestReader(fs, not_a_manifest), InvalidInputException);
+
+	auto empty_file = TestCreatePath("empty.manifest");
+	WriteFileContent(fs, empty_file, "");
+	REQUIRE_THROWS_AS(PrewarmManifestReader(fs, empty_file), InvalidInputException);
+
+	PrewarmManifestWriter writer;
+	writer.AddDatabase("main_db", "/data/main.db", 1, 262144, {1, 2, 3});
+	writer.AddRemoteFile("s3://bucket/a.parquet", 1000, {{0, 1000}});
+	auto full_path = TestCreatePath("full.manifest");
+	writer.Write(fs, full_path);
+	auto content = ReadFileContent(fs, full_path);
+
+	auto truncated = TestCreatePath("truncated.manifest");
+	WriteFileContent(fs, truncated, content.substr(0, content.size() - 3));
+	REQUIRE_THROWS_AS(PrewarmManifestReader(fs, truncated), InvalidInputException);
+
+	// Flip a bit in the middle of the payload, the checksum catches it
+	auto corrupted_content = content;
+	corrupted_content[corrupted_content.size() / 2] ^= 0x01;
+	auto corrupted = TestCreatePath("corrupted.manifest");
+	WriteFileContent(fs, corrupted, corrupted_content);
+	REQUIRE_THROWS_WITH(PrewarmManifestReader(fs, corrupted), Catch::Contains("checksum mismatch"));
+}
@@ -1,7 +1,9 @@
 #include "catch/catch.hpp"
 
 #include "core/remote_block_collector.hpp"
+#include "duckdb/common/exception.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/limits.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/database.hpp"
 #include "prewarm_mock_filesystem.hpp"
@@ -43,15 +45,15 @@ TEST_CASE("CollectRemoteBlocks - Single File (Mock)", "[remote_block_collector]"
 	auto result = RemoteBlockCollector::CollectRemoteBlocks(mock_fs, file_path, 1024ULL * 1024ULL);
 
 	// Verify result
-	REQUIRE(result.size() == 1);
-	REQUIRE(result.find(file_path) != result.end());
+	REQUIRE(result.GetFiles().size() == 1);
+	REQUIRE(result.GetFiles()[0].file_path == file_path);
+	REQUIRE(result.GetFiles()[0].file_size == file_size);
 
-	auto &blocks = result[file_path];
+	auto &blocks = result.GetBlocks();
 	REQUIRE(blocks.size() == 1);
-	REQUIRE(blocks[0].file_path == file_path);
-	REQUIRE(blocks[0].offset == 0);
-	REQUIRE(blocks[0].size == static_cast<int64_t>(file_size));
-	REQUIRE(blocks[0].file_size == file_size);
+	REQUIRE(result.GetFile(blocks[0]).file_path == file_path);
+	REQUIRE(result.GetBlockOffset(blocks[0]) == 0);
+	REQUIRE(result.GetBlockBytes(blocks[0]) == file_size);
 
 	// Verify Glob was called
 	REQUIRE(mock_fs.GetGlobCallCount() == 1);
@@ -81,16 +83,19 @@ TEST_CASE("CollectRemoteBlocks - Multiple Files (Mock)", "[remote_block_collecto
 	auto result = RemoteBlockCollector::CollectRemoteBlocks(mock_fs, pattern, 1024ULL * 1024ULL);
 
 	// Verify results
-	REQUIRE(result.size() == 2);
-	REQUIRE(result.find(file1) != result.end());
-	REQUIRE(result.find(file2) != result.end());
+	auto &files = result.GetFiles();
+	REQUIRE(files.size() == 2);
+	REQUIRE(files[0].file_path == file1);
+	REQUIRE(files[1].file_path == file2);
 
 	// Verify each file has blocks with correct sizes
-	REQUIRE(result[file1].size() == 1);
-	REQUIRE(result[file1][0].file_size == file1_size);
+	REQUIRE(result.GetFileBlocks(0).size() == 1);
+	REQUIRE(files[0].file_size == file1_size);
+	REQUIRE(result.GetBlockBytes(result.GetFileBlocks(0)[0]) == file1_size);
 
-	REQUIRE(result[file2].size() == 1);
-	REQUIRE(result[file2][0].file_size == file2_size);
+	REQUIRE(result.GetFileBlocks(1).size() == 1);
+	REQUIRE(files[1].file_size == file2_size);
+	REQUIRE(result.GetBlockBytes(result.GetFileBlocks(1)[0]) == file2_size);
 
 	// Verify Glob was called once
 	REQUIRE(mock_fs.GetGlobCallCount() == 1);
@@ -116,19 +121,43 @@ TEST_CASE("CollectRemoteBlocks - Block Size Parameter (Mock)", "[remote_block_co
 
 	auto result = RemoteBlockCollector::CollectRemoteBlocks(mock_fs, file_path, block_size);
 
-	// Verify result
-	REQUIRE(result.size() == 1);
-	auto &blocks = result[file_path];
-	// Currently implementation returns single block for entire file
-	// This test verifies the current behavior
-	REQUIRE(blocks.size() >= 1);
-	REQUIRE(blocks[0].file_size == file_size);
+	// Verify result: 5MiB file divided into 1MiB blocks
+	REQUIRE(result.GetFiles().size() == 1);
+	REQUIRE(result.GetFiles()[0].file_size == file_size);
+	auto &blocks = result.GetBlocks();
+	REQUIRE(blocks.size() == 5);
+	for (idx_t i = 0; i < blocks.size(); i++) {
+		REQUIRE(blocks[i].file_index == 0);
+		REQUIRE(blocks[i].block_index == i);
+		REQUIRE(result.GetBlockOffset(blocks[i]) == i * block_size);
+		REQUIRE(result.GetBlockBytes(blocks[i]) == block_size);
+	}
 
 	// Verify filesystem interactions
 	REQUIRE(mock_fs.GetGlobCallCount() == 1);
 	REQUIRE(mock_fs.GetOpenFileCallCount() == 1);
 }
 
+TEST_CASE("CollectRemoteBlocks - Partial Last Block (Mock)", "[remote_block_collector]") {
+	MockFileSystem mock_fs;
+
+	const string file_path = "/tmp/partial_file.parquet";
+	const idx_t block_size = 1000;
+	const idx_t file_size = 2500;
+
+	mock_fs.ConfigureGlobResults(file_path, {file_path});
+	mock_fs.ConfigureFileSize(file_path, file_size);
+
+	auto result = RemoteBlockCollector::CollectRemoteBlocks(mock_fs, file_path, block_size);
+
+	auto &blocks = result.GetBlocks();
+	REQUIRE(blocks.size() == 3);
+	REQUIRE(result.GetBlockOffset(blocks[2]) == 2000);
+	REQUIRE(result.GetBlockBytes(blocks[0]) == 1000);
+	REQUIRE(result.GetBlockBytes(blocks[1]) == 1000);
+	REQUIRE(result.GetBlockBytes(blocks[2]) == 500);
+}
+
 TEST_CASE("CollectRemoteBlocks - Empty File (Mock)", "[remote_block_collector]") {
 	MockFileSystem mock_fs;
 
@@ -181,15 +210,14 @@ TEST_CASE("CollectRemoteBlocks - Real Single File", "[remote_block_collector]")
 	// Test with a pattern that matches the file
 	auto result = RemoteBlockCollector::CollectRemoteBlocks(fs, temp_file, 1024ULL * 1024ULL);
 
-	REQUIRE(result.size() == 1);
-	REQUIRE(result.find(temp_file) != result.end());
+	REQUIRE(result.GetFiles().size() == 1);
+	REQUIRE(result.GetFiles()[0].file_path == temp_file);
+	REQUIRE(result.GetFiles()[0].file_size > 0);
 
-	auto &blocks = result[temp_file];
+	auto &blocks = result.GetBlocks();
 	REQUIRE(blocks.size() == 1);
-	REQUIRE(blocks[0].file_path == temp_file);
-	REQUIRE(blocks[0].offset == 0);
-	REQUIRE(blocks[0].size > 0);
-	REQUIRE(blocks[0].file_size > 0);
+	REQUIRE(result.GetBlockOffset(blocks[0]) == 0);
+	REQUIRE(result.GetBlockBytes(blocks[0]) > 0);
 }
 
 TEST_CASE("CollectRemoteBlocks - Real Multiple Files", "[remote_block_collector]") {
@@ -219,13 +247,14 @@ TEST_CASE("CollectRemoteBlocks - Real Multiple Files", "[remote_block_collector]
 	auto pattern = fs.JoinPath(temp_dir, "*.parquet");
 	auto result = RemoteBlockCollector::CollectRemoteBlocks(fs, pattern, 1024ULL * 1024ULL);
 
-	REQUIRE(result.size() == 2);
-	REQUIRE(result.find(file1) != result.end());
-	REQUIRE(result.find(file2) != result.end());
+	auto &files = result.GetFiles();
+	REQUIRE(files.size() == 2);
+	REQUIRE(((files[0].file_path == file1 && files[1].file_path == file2) ||
+	         (files[0].file_path == file2 && files[1].file_path == file1)));
 
 	// Verify each file has blocks
-	REQUIRE(result[file1].size() == 1);
-	REQUIRE(result[file2].size() == 1);
+	REQUIRE(result.GetFileBlocks(0).size() == 1);
+	REQUIRE(result.GetFileBlocks(1).size() == 1);
 }
 
 TEST_CASE("CollectRemoteBlocks - Remote Path Pattern (Mock)", "[remote_block_collector]") {
@@ -244,3 +273,35 @@ TEST_CASE("CollectRemoteBlocks - Remote Path Pattern (Mock)", "[remote_block_col
 	auto glob_calls = mock_fs.GetGlobCalls();
 	REQUIRE(glob_calls[0].pattern == "s3://bucket/*.parquet");
 }
+
+TEST_CASE("RemoteBlockPlan - Add File Ranges", "[remote_block_collector]") {
+	RemoteBlockPlan plan(1024);
+	// Unordered, overlapping ranges, one of them past the end of the file and one empty
+	auto file_index = plan.AddFileRanges("s3://bucket/file.parquet", 10 * 1024 + 100,
+	                                     {{5000, 3000}, {100, 200}, {7000, 500}, {10 * 1024, 4096}, {2048, 0}});
+	REQUIRE(file_index == 0);
+
+	auto blocks = plan.GetFileBlocks(file_index);
+	// [100, 300) -> 0, [5000, 8000) -> 4..7, [10240, 10340) -> 10
+	REQUIRE(blocks.size() == 6);
+	const vector<idx_t> expected_blocks {0, 4, 5, 6, 7, 10};
+	for (idx_t idx = 0; idx < expected_blocks.size(); idx++) {
+		REQUIRE(blocks[idx].block_index == expected_blocks[idx]);
+	}
+	REQUIRE(plan.GetBlockBytes(blocks[5]) == 100);
+}
+
+TEST_CASE("RemoteBlockRef - Index Overflow", "[remote_block_collector]") {
+	const idx_t max_index = NumericLimits<uint32_t>::Maximum();
+	auto block = RemoteBlockRef::Create("s3://bucket/file.parquet", 3, max_index);
+	REQUIRE(block.file_index == 3);
+	REQUIRE(block.block_index == max_index);
+
+	// Tiny blocks over a huge file must be rejected instead of wrapping around
+	REQUIRE_THROWS_AS(RemoteBlockRef::Create("s3://bucket/file.parquet", 0, max_index + 1), InvalidInputException);
+	REQUIRE_THROWS_AS(RemoteBlockRef::Create("s3://bucket/file.parquet", max_index + 1, 0), InvalidInputException);
+
+	RemoteBlockPlan plan(1);
+	auto file_index = plan.AddFileDescriptor("s3://bucket/file.parquet", max_index + 2);
+	REQUIRE_THROWS_AS(plan.AddBlock(file_index, max_index + 1), InvalidInputException);
+}
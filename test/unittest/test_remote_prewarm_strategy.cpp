@@ -2,6 +2,8 @@
 
 #include "core/remote_prewarm_strategy.hpp"
 #include "cache_httpfs_extension.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/exception.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/database.hpp"
@@ -25,12 +27,18 @@ public:
 	}
 
 	//! Override FilterCachedBlocks to track calls
-	vector<RemoteBlockInfo> FilterCachedBlocks(const string &file_path,
-	                                           const vector<RemoteBlockInfo> &blocks) override {
+	vector<RemoteBlockRef> FilterCachedBlocks(const RemoteFileDescriptor &file, idx_t block_size,
+	                                          Span<const RemoteBlockRef> blocks) override {
 		filter_cached_call_count++;
-		filter_cached_calls.emplace_back(file_path, blocks.size());
-		// Return all blocks (simulate none are cached)
-		return blocks;
+		filter_cached_calls.emplace_back(file.file_path, blocks.size());
+		// Simulate the first `cached_blocks_per_file` blocks of each file being cached
+		auto cached_count = std::min<idx_t>(cached_blocks_per_file, blocks.size());
+		return vector<RemoteBlockRef>(blocks.begin() + cached_count, blocks.end());
+	}
+
+	//! Configure how many leading blocks of each file are reported as cached
+	void ConfigureCachedBlocksPerFile(idx_t count) {
+		cached_blocks_per_file = count;
 	}
 
 	//! Override CalculateMaxAvailableBlocks to track calls
@@ -49,6 +57,16 @@ public:
 		capacity_configured = true;
 	}
 
+	//! Override GetMaxOpenFiles to bypass the setting
+	idx_t GetMaxOpenFiles() const override {
+		return max_open_files;
+	}
+
+	//! Configure the open file limit for testing
+	void ConfigureMaxOpenFiles(idx_t max_open_files_p) {
+		max_open_files = max_open_files_p;
+	}
+
 	//! Get number of FilterCachedBlocks calls
 	idx_t GetFilterCachedCallCount() const {
 		return filter_cached_call_count;
@@ -77,8 +95,19 @@ private:
 	vector<FilterCachedCall> filter_cached_calls;
 	bool capacity_configured;
 	BufferCapacityInfo configured_capacity;
+	idx_t max_open_files = DEFAULT_PREWARM_REMOTE_MAX_OPEN_FILES;
+	idx_t cached_blocks_per_file = 0;
 };
 
+//! Retry policy without backoff, so failure tests do not sleep
+RemoteRetryPolicy NoBackoffRetryPolicy(idx_t max_attempts) {
+	RemoteRetryPolicy policy;
+	policy.max_attempts = max_attempts;
+	policy.initial_backoff_ms = 0;
+	policy.max_backoff_ms = 0;
+	return policy;
+}
+
 } // namespace
 
 //===--------------------------------------------------------------------===//
@@ -92,11 +121,11 @@ TEST_CASE("RemotePrewarmStrategy - Execute Empty Blocks (Mock)", "[remote_prewar
 	MockFileSystem mock_fs;
 
 	MockRemotePrewarmStrategy strategy(context, mock_fs);
-	RemoteFileBlockMap empty_blocks;
+	RemoteBlockPlan empty_plan(1024);
 
-	auto result = strategy.Execute(empty_blocks, 0);
+	auto result = strategy.Execute(empty_plan, 0);
 
-	REQUIRE(result == 0);
+	REQUIRE(result.bytes_fetched == 0);
 
 	// Verify no filesystem operations were performed
 	REQUIRE(mock_fs.GetOpenFileCallCount() == 0);
@@ -120,16 +149,13 @@ TEST_CASE("RemotePrewarmStrategy - Execute Single Block (Mock)", "[remote_prewar
 	// Configure mock filesystem
 	mock_fs.ConfigureFileSize(file_path, block_size);
 
-	// Create block info
-	vector<RemoteBlockInfo> blocks;
-	blocks.emplace_back(file_path, 0, static_cast<int64_t>(block_size), block_size);
-
-	RemoteFileBlockMap file_blocks;
-	file_blocks[file_path] = blocks;
+	// Create block plan
+	RemoteBlockPlan plan(block_size);
+	plan.AddFile(file_path, block_size);
 
-	auto result = strategy.Execute(file_blocks, 100);
+	auto result = strategy.Execute(plan, 100);
 
-	REQUIRE(result == 1024);
+	REQUIRE(result.bytes_fetched == 1024);
 
 	// Verify OpenFile was called for the file
 	REQUIRE(mock_fs.GetOpenFileCallCount() == 1);
@@ -168,17 +194,12 @@ TEST_CASE("RemotePrewarmStrategy - Execute Multiple Blocks Same File (Mock)", "[
 	mock_fs.ConfigureFileSize(file_path, block_size * num_blocks);
 
 	// Create multiple blocks
-	vector<RemoteBlockInfo> blocks;
-	for (idx_t i = 0; i < num_blocks; i++) {
-		blocks.emplace_back(file_path, i * block_size, static_cast<int64_t>(block_size), block_size * num_blocks);
-	}
-
-	RemoteFileBlockMap file_blocks;
-	file_blocks[file_path] = blocks;
+	RemoteBlockPlan plan(block_size);
+	plan.AddFile(file_path, block_size * num_blocks);
 
-	auto result = strategy.Execute(file_blocks, 1000);
+	auto result = strategy.Execute(plan, 1000);
 
-	REQUIRE(result == num_blocks * block_size);
+	REQUIRE(result.bytes_fetched == num_blocks * block_size);
 
 	// Verify OpenFile was called once (same file)
 	REQUIRE(mock_fs.GetOpenFileCallCount() == 1);
@@ -213,22 +234,14 @@ TEST_CASE("RemotePrewarmStrategy - Execute Multiple Files (Mock)", "[remote_prew
 	mock_fs.ConfigureFileSize(file1, block_size);
 	mock_fs.ConfigureFileSize(file2, block_size * 2);
 
-	// Create blocks for file1
-	vector<RemoteBlockInfo> blocks1;
-	blocks1.emplace_back(file1, 0, static_cast<int64_t>(block_size), block_size);
-
-	// Create blocks for file2
-	vector<RemoteBlockInfo> blocks2;
-	blocks2.emplace_back(file2, 0, static_cast<int64_t>(block_size), block_size * 2);
-	blocks2.emplace_back(file2, block_size, static_cast<int64_t>(block_size), block_size * 2);
-
-	RemoteFileBlockMap file_blocks;
-	file_blocks[file1] = blocks1;
-	file_blocks[file2] = blocks2;
+	// Create blocks for file1 and file2
+	RemoteBlockPlan plan(block_size);
+	plan.AddFile(file1, block_size);
+	plan.AddFile(file2, block_size * 2);
 
-	auto result = strategy.Execute(file_blocks, 100);
+	auto result = strategy.Execute(plan, 100);
 
-	REQUIRE(result == 3 * block_size); // 1 + 2 blocks
+	REQUIRE(result.bytes_fetched == 3 * block_size); // 1 + 2 blocks
 
 	// Verify OpenFile was called for each file
 	REQUIRE(mock_fs.GetOpenFileCallCount() == 2);
@@ -261,19 +274,14 @@ TEST_CASE("RemotePrewarmStrategy - Execute with Max Blocks Limit (Mock)", "[remo
 	mock_fs.ConfigureFileSize(file_path, block_size * num_blocks);
 
 	// Create multiple blocks
-	vector<RemoteBlockInfo> blocks;
-	for (idx_t i = 0; i < num_blocks; i++) {
-		blocks.emplace_back(file_path, i * block_size, static_cast<int64_t>(block_size), block_size * num_blocks);
-	}
-
-	RemoteFileBlockMap file_blocks;
-	file_blocks[file_path] = blocks;
+	RemoteBlockPlan plan(block_size);
+	plan.AddFile(file_path, block_size * num_blocks);
 
 	// Execute with max_blocks limit
-	auto result = strategy.Execute(file_blocks, max_blocks);
+	auto result = strategy.Execute(plan, max_blocks);
 
 	// Result should be limited by max_blocks
-	REQUIRE(result <= max_blocks * block_size);
+	REQUIRE(result.bytes_fetched <= max_blocks * block_size);
 
 	// Verify file received limited Read() calls
 	REQUIRE(mock_fs.GetReadCallCount(file_path) <= max_blocks);
@@ -309,36 +317,302 @@ TEST_CASE("RemotePrewarmStrategy - Execute with Capacity Limit (Mock)", "[remote
 	mock_fs.ConfigureFileSize(file_path, block_size * num_blocks);
 
 	// Create multiple blocks
-	vector<RemoteBlockInfo> blocks;
-	for (idx_t i = 0; i < num_blocks; i++) {
-		blocks.emplace_back(file_path, i * block_size, static_cast<int64_t>(block_size), block_size * num_blocks);
-	}
-
-	RemoteFileBlockMap file_blocks;
-	file_blocks[file_path] = blocks;
+	RemoteBlockPlan plan(block_size);
+	plan.AddFile(file_path, block_size * num_blocks);
 
-	auto result = strategy.Execute(file_blocks, 100);
+	auto result = strategy.Execute(plan, 100);
 
 	// Result should be limited by capacity
-	REQUIRE(result == capacity_limit * block_size);
+	REQUIRE(result.bytes_fetched == capacity_limit * block_size);
 
 	// Verify file received limited Read() calls
 	REQUIRE(mock_fs.GetReadCallCount(file_path) == capacity_limit);
 }
 
-TEST_CASE("RemotePrewarmStrategy - RemoteBlockInfo Structure", "[remote_prewarm_strategy]") {
-	// Test RemoteBlockInfo structure
-	RemoteBlockInfo block1;
-	REQUIRE(block1.file_path.empty());
-	REQUIRE(block1.offset == 0);
-	REQUIRE(block1.size == 0);
-	REQUIRE(block1.file_size == 0);
-
-	RemoteBlockInfo block2("s3://bucket/file.parquet", 1024, 2048, 4096);
-	REQUIRE(block2.file_path == "s3://bucket/file.parquet");
-	REQUIRE(block2.offset == 1024);
-	REQUIRE(block2.size == 2048);
-	REQUIRE(block2.file_size == 4096);
+TEST_CASE("RemotePrewarmStrategy - Execute Pattern Streams All Files (Mock)", "[remote_prewarm_strategy]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &context = *con.context;
+	MockFileSystem mock_fs;
+
+	MockRemotePrewarmStrategy strategy(context, mock_fs);
+
+	const string pattern = "/tmp/*.parquet";
+	const idx_t block_size = 1024;
+	const idx_t file_count = 20;
+	const idx_t blocks_per_file = 10;
+
+	// Configure more blocks than the fetch queue can hold at once, so the planner has to wait for the workers
+	vector<string> files;
+	for (idx_t i = 0; i < file_count; i++) {
+		auto file_path = "/tmp/file" + std::to_string(i) + ".parquet";
+		mock_fs.ConfigureFileSize(file_path, block_size * blocks_per_file);
+		files.emplace_back(std::move(file_path));
+	}
+	mock_fs.ConfigureGlobResults(pattern, files);
+
+	auto result = strategy.Execute(pattern, block_size, NumericLimits<idx_t>::Maximum());
+
+	REQUIRE(result.bytes_fetched == file_count * blocks_per_file * block_size);
+	REQUIRE(mock_fs.GetGlobCallCount() == 1);
+	REQUIRE(mock_fs.GetOpenFileCallCount() == file_count);
+	REQUIRE(mock_fs.GetTotalReadCallCount() == file_count * blocks_per_file);
+	for (const auto &file_path : files) {
+		REQUIRE(mock_fs.GetReadCallCount(file_path) == blocks_per_file);
+	}
+
+	// Each file is planned and filtered exactly once, capacity is computed once up front
+	REQUIRE(strategy.GetFilterCachedCallCount() == file_count);
+	REQUIRE(strategy.GetCalculateCapacityCallCount() == 1);
+}
+
+TEST_CASE("RemotePrewarmStrategy - Execute Pattern Stops Planning at Limit (Mock)", "[remote_prewarm_strategy]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &context = *con.context;
+	MockFileSystem mock_fs;
+
+	MockRemotePrewarmStrategy strategy(context, mock_fs);
+
+	const string pattern = "/tmp/*.parquet";
+	const idx_t block_size = 1024;
+	const string file1 = "/tmp/file1.parquet";
+	const string file2 = "/tmp/file2.parquet";
+	const string file3 = "/tmp/file3.parquet";
+	mock_fs.ConfigureGlobResults(pattern, {file1, file2, file3});
+	mock_fs.ConfigureFileSize(file1, block_size * 3);
+	mock_fs.ConfigureFileSize(file2, block_size * 3);
+	mock_fs.ConfigureFileSize(file3, block_size * 3);
+
+	auto result = strategy.Execute(pattern, block_size, 4);
+
+	REQUIRE(result.bytes_fetched == 4 * block_size);
+	REQUIRE(mock_fs.GetReadCallCount(file1) == 3);
+	REQUIRE(mock_fs.GetReadCallCount(file2) == 1);
+	REQUIRE(mock_fs.GetReadCallCount(file3) == 0);
+
+	// The third file is never opened since the limit was reached before planning it
+	REQUIRE(mock_fs.GetOpenFileCallCount() == 2);
+}
+
+TEST_CASE("RemotePrewarmStrategy - Open File Limit (Mock)", "[remote_prewarm_strategy]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &context = *con.context;
+	MockFileSystem mock_fs;
+
+	MockRemotePrewarmStrategy strategy(context, mock_fs);
+	const idx_t max_open_files = 2;
+	strategy.ConfigureMaxOpenFiles(max_open_files);
+
+	const string pattern = "/tmp/*.parquet";
+	const idx_t block_size = 1024;
+	const idx_t file_count = 50;
+	const idx_t blocks_per_file = 3;
+
+	vector<string> files;
+	for (idx_t i = 0; i < file_count; i++) {
+		auto file_path = "/tmp/file" + std::to_string(i) + ".parquet";
+		mock_fs.ConfigureFileSize(file_path, block_size * blocks_per_file);
+		files.emplace_back(std::move(file_path));
+	}
+	mock_fs.ConfigureGlobResults(pattern, files);
+
+	auto result = strategy.Execute(pattern, block_size, NumericLimits<idx_t>::Maximum());
+
+	REQUIRE(result.bytes_fetched == file_count * blocks_per_file * block_size);
+	REQUIRE(mock_fs.GetTotalReadCallCount() == file_count * blocks_per_file);
+
+	// Each file is opened exactly once, never more than the limit at a time, and all are closed afterwards
+	REQUIRE(mock_fs.GetOpenFileCallCount() == file_count);
+	REQUIRE(mock_fs.GetMaxConcurrentOpenHandleCount() <= max_open_files);
+	REQUIRE(mock_fs.GetOpenHandleCount() == 0);
+}
+
+TEST_CASE("RemotePrewarmStrategy - Files Closed After Plan Execute (Mock)", "[remote_prewarm_strategy]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &context = *con.context;
+	MockFileSystem mock_fs;
+
+	MockRemotePrewarmStrategy strategy(context, mock_fs);
+	strategy.ConfigureMaxOpenFiles(1);
+
+	const idx_t block_size = 1024;
+	RemoteBlockPlan plan(block_size);
+	for (idx_t i = 0; i < 10; i++) {
+		auto file_path = "/tmp/file" + std::to_string(i) + ".parquet";
+		mock_fs.ConfigureFileSize(file_path, block_size * 4);
+		plan.AddFile(file_path, block_size * 4);
+	}
+
+	auto result = strategy.Execute(plan, NumericLimits<idx_t>::Maximum());
+
+	REQUIRE(result.bytes_fetched == 10 * 4 * block_size);
+	REQUIRE(mock_fs.GetOpenFileCallCount() == 10);
+	REQUIRE(mock_fs.GetMaxConcurrentOpenHandleCount() == 1);
+	REQUIRE(mock_fs.GetOpenHandleCount() == 0);
+}
+
+TEST_CASE("RemotePrewarmStrategy - Execute Pattern No Match (Mock)", "[remote_prewarm_strategy]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &context = *con.context;
+	MockFileSystem mock_fs;
+
+	MockRemotePrewarmStrategy strategy(context, mock_fs);
+	mock_fs.ConfigureGlobResults("s3://bucket/*.parquet", {});
+
+	auto result = strategy.Execute("s3://bucket/*.parquet", 1024, NumericLimits<idx_t>::Maximum());
+
+	REQUIRE(result.bytes_fetched == 0);
+	REQUIRE(mock_fs.GetOpenFileCallCount() == 0);
+	REQUIRE(strategy.GetCalculateCapacityCallCount() == 0);
+}
+
+TEST_CASE("RemotePrewarmStrategy - Transient Failures Are Retried (Mock)", "[remote_prewarm_strategy]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &context = *con.context;
+	MockFileSystem mock_fs;
+
+	MockRemotePrewarmStrategy strategy(context, mock_fs);
+	strategy.SetRetryPolicy(NoBackoffRetryPolicy(3));
+
+	const string file_path = "/tmp/flaky.parquet";
+	const idx_t block_size = 1024;
+	mock_fs.ConfigureFileSize(file_path, block_size);
+	mock_fs.ConfigureTransientReadFailures(file_path, 2);
+
+	RemoteBlockPlan plan(block_size);
+	plan.AddFile(file_path, block_size);
+	auto result = strategy.Execute(plan, 100);
+
+	// Two failed attempts, the third one succeeds
+	REQUIRE(result.bytes_fetched == block_size);
+	REQUIRE(result.blocks_fetched == 1);
+	REQUIRE(result.blocks_failed == 0);
+	REQUIRE(result.retries == 2);
+	REQUIRE(mock_fs.GetReadCallCount(file_path) == 3);
+}
+
+TEST_CASE("RemotePrewarmStrategy - Transient Failures Exhaust Retries (Mock)", "[remote_prewarm_strategy]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &context = *con.context;
+	MockFileSystem mock_fs;
+
+	MockRemotePrewarmStrategy strategy(context, mock_fs);
+	strategy.SetRetryPolicy(NoBackoffRetryPolicy(2));
+
+	const string file_path = "/tmp/flaky.parquet";
+	const idx_t block_size = 1024;
+	mock_fs.ConfigureFileSize(file_path, block_size);
+	mock_fs.ConfigureTransientReadFailures(file_path, 5);
+
+	RemoteBlockPlan plan(block_size);
+	plan.AddFile(file_path, block_size);
+	auto result = strategy.Execute(plan, 100);
+
+	REQUIRE(result.blocks_failed == 1);
+	REQUIRE(result.bytes_failed == block_size);
+	REQUIRE(result.bytes_fetched == 0);
+	REQUIRE(mock_fs.GetReadCallCount(file_path) == 2);
+}
+
+TEST_CASE("RemotePrewarmStrategy - Permanent Failures Do Not Stop Prewarm (Mock)", "[remote_prewarm_strategy]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &context = *con.context;
+	MockFileSystem mock_fs;
+
+	MockRemotePrewarmStrategy strategy(context, mock_fs);
+	strategy.SetRetryPolicy(NoBackoffRetryPolicy(3));
+
+	const string denied_file = "/tmp/denied.parquet";
+	const string good_file = "/tmp/good.parquet";
+	const idx_t block_size = 1024;
+	mock_fs.ConfigureFileSize(denied_file, block_size * 2 + 100);
+	mock_fs.ConfigureFileSize(good_file, block_size * 3);
+	mock_fs.ConfigurePermanentReadFailure(denied_file);
+
+	RemoteBlockPlan plan(block_size);
+	plan.AddFile(denied_file, block_size * 2 + 100);
+	plan.AddFile(good_file, block_size * 3);
+	auto result = strategy.Execute(plan, 100);
+
+	// Permanent errors are not retried, and the remaining file is still fetched
+	REQUIRE(mock_fs.GetReadCallCount(denied_file) == 3);
+	REQUIRE(result.retries == 0);
+	REQUIRE(result.blocks_failed == 3);
+	REQUIRE(result.bytes_failed == block_size * 2 + 100);
+	REQUIRE(result.blocks_fetched == 3);
+	REQUIRE(result.bytes_fetched == block_size * 3);
+	REQUIRE(mock_fs.GetOpenHandleCount() == 0);
+}
+
+TEST_CASE("RemotePrewarmStrategy - Cached Blocks Are Not Fetched (Mock)", "[remote_prewarm_strategy]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &context = *con.context;
+	MockFileSystem mock_fs;
+
+	MockRemotePrewarmStrategy strategy(context, mock_fs);
+	strategy.ConfigureCachedBlocksPerFile(2);
+
+	const string file_path = "/tmp/file.parquet";
+	const idx_t block_size = 1024;
+	mock_fs.ConfigureFileSize(file_path, block_size * 4 + 10);
+
+	RemoteBlockPlan plan(block_size);
+	plan.AddFile(file_path, block_size * 4 + 10);
+	auto result = strategy.Execute(plan, 100);
+
+	REQUIRE(result.blocks_fetched == 3);
+	REQUIRE(result.bytes_fetched == 2 * block_size + 10);
+	REQUIRE(strategy.GetExecutionStats().blocks_resident == 2);
+	REQUIRE(mock_fs.GetReadCallCount(file_path) == 3);
+}
+
+TEST_CASE("RemoteFetchPipeline - Error Classification", "[remote_prewarm_strategy]") {
+	REQUIRE(ClassifyRemoteFetchError(ErrorData(IOException("connection reset"))) == RemoteFetchErrorKind::TRANSIENT);
+	REQUIRE(ClassifyRemoteFetchError(ErrorData(PermissionException("denied"))) == RemoteFetchErrorKind::PERMANENT);
+	REQUIRE(ClassifyRemoteFetchError(ErrorData(InterruptException())) == RemoteFetchErrorKind::FATAL);
+}
+
+TEST_CASE("RemotePrewarmStrategy - RemoteBlockPlan Structure", "[remote_prewarm_strategy]") {
+	// Compact block references carry no path or size
+	REQUIRE(sizeof(RemoteBlockRef) == 8);
+	RemoteBlockRef block1;
+	REQUIRE(block1.file_index == 0);
+	REQUIRE(block1.block_index == 0);
+
+	RemoteBlockPlan plan(1024);
+	REQUIRE(plan.empty());
+	auto file_index = plan.AddFile("s3://bucket/file.parquet", 4096 + 100);
+	REQUIRE(file_index == 0);
+	REQUIRE(plan.BlockCount() == 5);
+	REQUIRE(plan.GetFiles().size() == 1);
+
+	// Offsets and sizes are derived from the block index
+	auto &blocks = plan.GetBlocks();
+	REQUIRE(plan.GetFile(blocks[1]).file_path == "s3://bucket/file.parquet");
+	REQUIRE(plan.GetBlockOffset(blocks[1]) == 1024);
+	REQUIRE(plan.GetBlockBytes(blocks[1]) == 1024);
+	REQUIRE(plan.GetBlockOffset(blocks[4]) == 4096);
+	REQUIRE(plan.GetBlockBytes(blocks[4]) == 100);
+
+	// Selected blocks of a second file
+	auto second_index = plan.AddFileDescriptor("s3://bucket/other.parquet", 10240);
+	REQUIRE(second_index == 1);
+	plan.AddBlock(second_index, 3);
+	plan.AddBlock(second_index, 7);
+	REQUIRE(plan.BlockCount() == 7);
+	REQUIRE(plan.GetFileBlocks(0).size() == 5);
+	auto second_blocks = plan.GetFileBlocks(1);
+	REQUIRE(second_blocks.size() == 2);
+	REQUIRE(plan.GetBlockOffset(second_blocks[0]) == 3 * 1024);
+	REQUIRE(plan.GetBlockOffset(second_blocks[1]) == 7 * 1024);
 }
 
 //===--------------------------------------------------------------------===//
@@ -366,13 +640,11 @@ TEST_CASE("RemotePrewarmStrategy - Real Execute Single Block", "[remote_prewarm_
 		handle->Write(const_cast<char *>(test_data.c_str()), file_size);
 	}
 
-	// Create block info with correct file size
-	vector<RemoteBlockInfo> blocks;
-	blocks.emplace_back(temp_file, 0, static_cast<int64_t>(file_size), file_size);
-
-	RemoteFileBlockMap file_blocks;
-	file_blocks[temp_file] = blocks;
+	// Create block plan with correct file size
+	RemoteBlockPlan plan(1024);
+	plan.AddFile(temp_file, file_size);
 
-	auto result = strategy.Execute(file_blocks, 0);
-	REQUIRE(result >= 0);
+	auto result = strategy.Execute(plan, 0);
+	REQUIRE(result.bytes_fetched == 0);
+	REQUIRE(result.bytes_failed == 0);
 }
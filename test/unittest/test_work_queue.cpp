@@ -0,0 +1,66 @@
+#include "catch/catch.hpp"
+
+#include "core/work_queue.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "test_helpers.hpp"
+
+#include <mutex>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+
+TEST_CASE("WorkQueue - items are handed out in order", "[work_queue]") {
+	WorkQueue queue(3);
+	REQUIRE(queue.Size() == 3);
+	idx_t item;
+	for (idx_t expected = 0; expected < 3; expected++) {
+		REQUIRE(queue.Next(item));
+		REQUIRE(item == expected);
+	}
+	REQUIRE_FALSE(queue.Next(item));
+}
+
+TEST_CASE("WorkQueue - cancelled queues hand out no more items", "[work_queue]") {
+	WorkQueue queue(10);
+	idx_t item;
+	REQUIRE(queue.Next(item));
+	queue.Cancel();
+	REQUIRE_FALSE(queue.Next(item));
+}
+
+TEST_CASE("WorkQueue - Run processes every item once", "[work_queue]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	WorkQueue queue(500);
+	std::mutex lock;
+	vector<idx_t> seen(queue.Size(), 0);
+	queue.Run(*con.context, 4, [&](idx_t item) {
+		std::lock_guard<std::mutex> guard(lock);
+		seen[item]++;
+	});
+	for (auto count : seen) {
+		REQUIRE(count == 1);
+	}
+
+	// An empty queue schedules no tasks
+	WorkQueue empty(0);
+	empty.Run(*con.context, 4, [](idx_t item) { throw IOException("unexpected item"); });
+}
+
+TEST_CASE("WorkQueue - Run rethrows worker errors", "[work_queue]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	WorkQueue queue(3);
+	REQUIRE_THROWS(queue.Run(*con.context, 2, [](idx_t item) {
+		if (item == 1) {
+			throw IOException("injected failure");
+		}
+	}));
+}
+
+} // namespace